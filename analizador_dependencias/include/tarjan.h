@@ -17,8 +17,11 @@ typedef struct {
     int stack_top;          // Tope del stack
     int time;               // Contador de tiempo
     int scc_count;          // Número de SCC encontrados
-    int** scc_components;   // Matriz para almacenar componentes
+    int** scc_components;   // scc_components[i] apunta al tramo de la SCC i en scc_members
+    int* scc_members;       // Vértices de todas las SCC, una a continuación de otra
     int* scc_sizes;         // Tamaños de cada SCC
+    int* call_stack;        // Pila explícita del DFS (reemplaza la recursión)
+    int* next_edge;         // Próximo adyacente a revisar de cada vértice en call_stack
 } TarjanData;
 
 // Funciones para análisis de componentes fuertemente conexos
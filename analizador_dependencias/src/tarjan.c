@@ -18,20 +18,21 @@ TarjanData* create_tarjan_data(int vertices) {
     data->on_stack = calloc(vertices, sizeof(bool));
     data->stack = malloc(vertices * sizeof(int));
     data->scc_components = malloc(vertices * sizeof(int*));
+    data->scc_members = malloc(vertices * sizeof(int));
     data->scc_sizes = calloc(vertices, sizeof(int));
+    data->call_stack = malloc(vertices * sizeof(int));
+    data->next_edge = malloc(vertices * sizeof(int));
 
-    if (!data->disc || !data->low || !data->on_stack ||
-        !data->stack || !data->scc_components || !data->scc_sizes) {
+    if (!data->disc || !data->low || !data->on_stack || !data->stack ||
+        !data->scc_components || !data->scc_members || !data->scc_sizes ||
+        !data->call_stack || !data->next_edge) {
         destroy_tarjan_data(data);
         return NULL;
     }
 
+    // Cada vértice pertenece a una sola SCC: alcanza con un arreglo de V
+    // lugares en lugar de una matriz V x V
     for (int i = 0; i < vertices; i++) {
-        data->scc_components[i] = malloc(vertices * sizeof(int));
-        if (!data->scc_components[i]) {
-            destroy_tarjan_data(data);
-            return NULL;
-        }
         data->disc[i] = -1;
         data->low[i] = -1;
     }
@@ -51,48 +52,69 @@ void destroy_tarjan_data(TarjanData* data) {
     free(data->on_stack);
     free(data->stack);
     free(data->scc_sizes);
-
-    if (data->scc_components) {
-        for (int i = 0; i < data->scc_count; i++) {
-            free(data->scc_components[i]);
-        }
-        free(data->scc_components);
-    }
+    free(data->scc_components);
+    free(data->scc_members);
+    free(data->call_stack);
+    free(data->next_edge);
 
     free(data);
 }
 
-static void tarjan_scc_util(Graph* graph, int u, TarjanData* data) {
+static void tarjan_discover(TarjanData* data, int u, int* call_top) {
     data->disc[u] = data->low[u] = ++data->time;
     data->stack[++data->stack_top] = u;
     data->on_stack[u] = true;
 
-    // Recorrer vértices adyacentes
-    for (int i = 0; i < graph->adj_count[u]; i++) {
-        int v = graph->adj_list[u][i];
+    data->call_stack[++(*call_top)] = u;
+    data->next_edge[*call_top] = 0;
+}
 
-        if (data->disc[v] == -1) {
-            tarjan_scc_util(graph, v, data);
-            data->low[u] = (data->low[u] < data->low[v]) ? data->low[u] : data->low[v];
-        }
-        else if (data->on_stack[v]) {
-            data->low[u] = (data->low[u] < data->disc[v]) ? data->low[u] : data->disc[v];
-        }
-    }
+// Tarjan con pila explícita: cada marco de call_stack es un vértice y el
+// próximo adyacente a revisar, así que cadenas largas de dependencias no
+// desbordan la pila de llamadas
+static void tarjan_scc_iterative(Graph* graph, int root, TarjanData* data, int* members_used) {
+    int call_top = -1;
+    tarjan_discover(data, root, &call_top);
 
-    // Si u es raíz de SCC
-    if (data->low[u] == data->disc[u]) {
-        int scc_size = 0;
-        int w;
+    while (call_top >= 0) {
+        int u = data->call_stack[call_top];
 
-        do {
-            w = data->stack[data->stack_top--];
-            data->on_stack[w] = false;
-            data->scc_components[data->scc_count][scc_size++] = w;
-        } while (w != u);
+        // Recorrer vértices adyacentes
+        if (data->next_edge[call_top] < graph->adj_count[u]) {
+            int v = graph->adj_list[u][data->next_edge[call_top]++];
 
-        data->scc_sizes[data->scc_count] = scc_size;
-        data->scc_count++;
+            if (data->disc[v] == -1) {
+                tarjan_discover(data, v, &call_top);
+            }
+            else if (data->on_stack[v]) {
+                data->low[u] = (data->low[u] < data->disc[v]) ? data->low[u] : data->disc[v];
+            }
+            continue;
+        }
+
+        // Si u es raíz de SCC
+        if (data->low[u] == data->disc[u]) {
+            int scc_size = 0;
+            int w;
+
+            data->scc_components[data->scc_count] = data->scc_members + *members_used;
+            do {
+                w = data->stack[data->stack_top--];
+                data->on_stack[w] = false;
+                data->scc_components[data->scc_count][scc_size++] = w;
+            } while (w != u);
+
+            data->scc_sizes[data->scc_count] = scc_size;
+            data->scc_count++;
+            *members_used += scc_size;
+        }
+
+        // Volver al vértice que descubrió a u (el "retorno" de la recursión)
+        call_top--;
+        if (call_top >= 0) {
+            int parent = data->call_stack[call_top];
+            data->low[parent] = (data->low[parent] < data->low[u]) ? data->low[parent] : data->low[u];
+        }
     }
 }
 
@@ -110,9 +132,10 @@ void find_strongly_connected_components(Graph* graph, TarjanData* data) {
     data->scc_count = 0;
 
     // Ejecutar Tarjan para todos los vértices
+    int members_used = 0;
     for (int i = 0; i < graph->vertices; i++) {
         if (data->disc[i] == -1) {
-            tarjan_scc_util(graph, i, data);
+            tarjan_scc_iterative(graph, i, data, &members_used);
         }
     }
 }
@@ -81,17 +81,32 @@ bool topological_sort_kahn(Graph* graph, TopologicalResult* result) {
     return result->is_valid;
 }
 
-static void topological_dfs_util(Graph* graph, int v, bool* visited, int* stack, int* stack_top) {
-    visited[v] = true;
-    
-    for (int i = 0; i < graph->adj_count[v]; i++) {
-        int u = graph->adj_list[v][i];
-        if (!visited[u]) {
-            topological_dfs_util(graph, u, visited, stack, stack_top);
+// DFS con pila explícita (vértice, próximo adyacente): cada vértice se
+// agrega al orden cuando termina, llenando el arreglo desde el final
+static void topological_dfs_iterative(Graph* graph, int root, bool* visited,
+                                      int* call_stack, int* next_edge,
+                                      int* order, int* order_pos) {
+    int call_top = 0;
+    visited[root] = true;
+    call_stack[0] = root;
+    next_edge[0] = 0;
+
+    while (call_top >= 0) {
+        int v = call_stack[call_top];
+
+        if (next_edge[call_top] < graph->adj_count[v]) {
+            int u = graph->adj_list[v][next_edge[call_top]++];
+            if (!visited[u]) {
+                visited[u] = true;
+                call_stack[++call_top] = u;
+                next_edge[call_top] = 0;
+            }
+            continue;
         }
+
+        order[--(*order_pos)] = v;
+        call_top--;
     }
-    
-    stack[++(*stack_top)] = v;
 }
 
 bool topological_sort_dfs(Graph* graph, TopologicalResult* result) {
@@ -99,32 +114,28 @@ bool topological_sort_dfs(Graph* graph, TopologicalResult* result) {
     
     int vertices = graph->vertices;
     bool* visited = calloc(vertices, sizeof(bool));
-    int* stack = malloc(vertices * sizeof(int));
-    int stack_top = -1;
+    int* next_edge = malloc(vertices * sizeof(int));
     
-    if (!visited || !stack) {
+    if (!visited || !next_edge) {
         free(visited);
-        free(stack);
+        free(next_edge);
         return false;
     }
     
-    // DFS para todos los vértices no visitados
+    // La cola de Kahn no se usa en esta variante: sirve de pila del DFS
+    int order_pos = vertices;
     for (int i = 0; i < vertices; i++) {
         if (!visited[i]) {
-            topological_dfs_util(graph, i, visited, stack, &stack_top);
+            topological_dfs_iterative(graph, i, visited, result->queue, next_edge,
+                                      result->order, &order_pos);
         }
     }
     
-    // Copiar resultado desde el stack (en orden reverso)
-    result->order_count = 0;
-    while (stack_top >= 0) {
-        result->order[result->order_count++] = stack[stack_top--];
-    }
-    
+    result->order_count = vertices;
     result->is_valid = true; // DFS siempre produce un orden válido
     
     free(visited);
-    free(stack);
+    free(next_edge);
     return true;
 }
 
@@ -102,25 +102,35 @@ bool* bellmanFordNegativeCycles(int** graph, int numVertices, int start) {
     dist[start] = 0;
     
     // Algoritmo Bellman-Ford estándar
+    bool converged = false;
     for (int i = 0; i < numVertices - 1; i++) {
+        bool updated = false;
         for (int u = 0; u < numVertices; u++) {
             for (int v = 0; v < numVertices; v++) {
                 if (graph[u][v] != 0 && dist[u] != INF && 
                     dist[u] + graph[u][v] < dist[v]) {
                     dist[v] = dist[u] + graph[u][v];
+                    updated = true;
                 }
             }
         }
+        // Una pasada sin cambios: no hay ciclos negativos alcanzables
+        if (!updated) {
+            converged = true;
+            break;
+        }
     }
     
     // Encontrar vértices afectados por ciclos negativos
-    for (int i = 0; i < numVertices; i++) {
+    for (int i = 0; i < numVertices && !converged; i++) {
+        bool updated = false;
         for (int u = 0; u < numVertices; u++) {
             for (int v = 0; v < numVertices; v++) {
                 if (graph[u][v] != 0 && dist[u] != INF && 
                     dist[u] + graph[u][v] < dist[v]) {
                     dist[v] = -INF;
                     affectedByNegCycle[v] = true;
+                    updated = true;
                 }
                 
                 if (dist[u] == -INF) {
@@ -128,6 +138,7 @@ bool* bellmanFordNegativeCycles(int** graph, int numVertices, int start) {
                 }
             }
         }
+        if (!updated) break;
     }
     
     free(dist);
@@ -147,14 +158,21 @@ bool bellmanFordDetectNegativeCycle(int** graph, int numVertices) {
     
     // Relajar todas las aristas V-1 veces
     for (int i = 0; i < numVertices - 1; i++) {
+        bool updated = false;
         for (int u = 0; u < numVertices; u++) {
             for (int v = 0; v < numVertices; v++) {
                 if (graph[u][v] != 0 && dist[u] != INF && 
                     dist[u] + graph[u][v] < dist[v]) {
                     dist[v] = dist[u] + graph[u][v];
+                    updated = true;
                 }
             }
         }
+        // Convergió antes de tiempo: no puede haber ciclo negativo
+        if (!updated) {
+            free(dist);
+            return false;
+        }
     }
     
     // Verificar si se pueden relajar más aristas
@@ -188,4 +206,437 @@ void printBellmanFordResult(PathResult* result, int start, int end) {
         if (i < result->pathLength - 1) printf(" -> ");
     }
     printf("\n============================\n");
-}
\ No newline at end of file
+}
+// =================================================================
+// Versiones CSR
+// =================================================================
+
+// Bellman-Ford sobre grafo CSR
+PathResult* bellmanFordCSR(const CSRGraph* graph, int start, int end) {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    result->path = NULL;
+    result->pathLength = 0;
+    result->totalWeight = INF;
+    result->hasPath = false;
+
+    if (!graph || start < 0 || start >= graph->numVertices ||
+        end < 0 || end >= graph->numVertices) {
+        return result;
+    }
+
+    int n = graph->numVertices;
+    int* dist = (int*)malloc(n * sizeof(int));
+    int* parent = (int*)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+        parent[i] = -1;
+    }
+    dist[start] = 0;
+
+    // Relajar todos los arcos V-1 veces
+    for (int i = 0; i < n - 1; i++) {
+        bool updated = false;
+        for (int u = 0; u < n; u++) {
+            if (dist[u] == INF) continue;
+            for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+                int v = graph->targets[e];
+                if (dist[u] + graph->weights[e] < dist[v]) {
+                    dist[v] = dist[u] + graph->weights[e];
+                    parent[v] = u;
+                    updated = true;
+                }
+            }
+        }
+        if (!updated) break;
+    }
+
+    // Verificar ciclos negativos
+    bool hasNegativeCycle = false;
+    for (int u = 0; u < n && !hasNegativeCycle; u++) {
+        if (dist[u] == INF) continue;
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (dist[u] + graph->weights[e] < dist[graph->targets[e]]) {
+                printf("¡Advertencia: Ciclo negativo detectado!\n");
+                hasNegativeCycle = true;
+                break;
+            }
+        }
+    }
+
+    if (!hasNegativeCycle && dist[end] != INF) {
+        result->hasPath = true;
+        result->totalWeight = dist[end];
+
+        int pathLen = 0;
+        for (int temp = end; temp != -1; temp = parent[temp]) {
+            pathLen++;
+        }
+
+        result->path = (int*)malloc(pathLen * sizeof(int));
+        result->pathLength = pathLen;
+
+        int temp = end;
+        for (int i = pathLen - 1; i >= 0; i--) {
+            result->path[i] = temp;
+            temp = parent[temp];
+        }
+    }
+
+    free(dist);
+    free(parent);
+    return result;
+}
+
+// Detectar si existe algún ciclo negativo alcanzable desde el vértice 0
+bool bellmanFordDetectNegativeCycleCSR(const CSRGraph* graph) {
+    if (!graph || graph->numVertices == 0) return false;
+
+    int n = graph->numVertices;
+    int* dist = (int*)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+    }
+    dist[0] = 0;
+
+    for (int i = 0; i < n - 1; i++) {
+        bool updated = false;
+        for (int u = 0; u < n; u++) {
+            if (dist[u] == INF) continue;
+            for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+                int v = graph->targets[e];
+                if (dist[u] + graph->weights[e] < dist[v]) {
+                    dist[v] = dist[u] + graph->weights[e];
+                    updated = true;
+                }
+            }
+        }
+        if (!updated) break;
+    }
+
+    for (int u = 0; u < n; u++) {
+        if (dist[u] == INF) continue;
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (dist[u] + graph->weights[e] < dist[graph->targets[e]]) {
+                free(dist);
+                return true;
+            }
+        }
+    }
+
+    free(dist);
+    return false;
+}
+
+// =================================================================
+// Variante con cola (SPFA)
+// =================================================================
+
+// Camino desde parent[] hasta end (start tiene parent -1)
+static void buildPathFromParents(PathResult* result, const int* parent, int end, int totalWeight) {
+    result->hasPath = true;
+    result->totalWeight = totalWeight;
+
+    int pathLen = 0;
+    for (int temp = end; temp != -1; temp = parent[temp]) {
+        pathLen++;
+    }
+
+    result->path = (int*)malloc(pathLen * sizeof(int));
+    result->pathLength = pathLen;
+
+    int temp = end;
+    for (int i = pathLen - 1; i >= 0; i--) {
+        result->path[i] = temp;
+        temp = parent[temp];
+    }
+}
+
+PathResult* bellmanFordQueueCSR(const CSRGraph* graph, int start, int end) {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    result->path = NULL;
+    result->pathLength = 0;
+    result->totalWeight = INF;
+    result->hasPath = false;
+
+    if (!graph || start < 0 || start >= graph->numVertices ||
+        end < 0 || end >= graph->numVertices) {
+        return result;
+    }
+
+    int n = graph->numVertices;
+    int* dist = (int*)malloc(n * sizeof(int));
+    int* parent = (int*)malloc(n * sizeof(int));
+    int* hops = (int*)malloc(n * sizeof(int));       // Aristas del mejor camino conocido
+    int* queue = (int*)malloc(n * sizeof(int));      // Cola circular: cada vértice está a lo sumo una vez
+    bool* inQueue = (bool*)calloc(n, sizeof(bool));
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+        parent[i] = -1;
+        hops[i] = 0;
+    }
+    dist[start] = 0;
+
+    int head = 0, count = 0;
+    queue[0] = start;
+    inQueue[start] = true;
+    count = 1;
+
+    bool hasNegativeCycle = false;
+    while (count > 0 && !hasNegativeCycle) {
+        int u = queue[head];
+        head = (head + 1) % n;
+        count--;
+        inQueue[u] = false;
+
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            if (dist[u] + graph->weights[e] >= dist[v]) continue;
+
+            dist[v] = dist[u] + graph->weights[e];
+            parent[v] = u;
+            hops[v] = hops[u] + 1;
+
+            // Un camino simple tiene como mucho V-1 aristas
+            if (hops[v] >= n) {
+                printf("¡Advertencia: Ciclo negativo detectado!\n");
+                hasNegativeCycle = true;
+                break;
+            }
+
+            if (!inQueue[v]) {
+                queue[(head + count) % n] = v;
+                count++;
+                inQueue[v] = true;
+            }
+        }
+    }
+
+    if (!hasNegativeCycle && dist[end] != INF) {
+        buildPathFromParents(result, parent, end, dist[end]);
+    }
+
+    free(dist);
+    free(parent);
+    free(hops);
+    free(queue);
+    free(inQueue);
+    return result;
+}
+
+PathResult* bellmanFordQueue(int** graph, int numVertices, int start, int end) {
+    if (start < 0 || start >= numVertices || end < 0 || end >= numVertices) {
+        return bellmanFordQueueCSR(NULL, start, end);
+    }
+
+    CSRGraph* csr = csrFromMatrix(graph, numVertices, true);
+    PathResult* result = bellmanFordQueueCSR(csr, start, end);
+    destroyCSRGraph(csr);
+    return result;
+}
+
+// =================================================================
+// Arreglos de aristas (SoA) y kernel vectorizado
+// =================================================================
+
+EdgeArrays* createEdgeArrays(const CSRGraph* graph) {
+    if (!graph) return NULL;
+
+    int n = graph->numVertices;
+    int m = graph->numEdges;
+
+    EdgeArrays* edges = (EdgeArrays*)malloc(sizeof(EdgeArrays));
+    edges->numVertices = n;
+    edges->numEdges = m;
+    edges->offsets = (int*)calloc(n + 1, sizeof(int));
+    edges->src = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    edges->weight = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+
+    // Conteo por destino y suma prefija
+    for (int e = 0; e < m; e++) {
+        edges->offsets[graph->targets[e] + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        edges->offsets[v + 1] += edges->offsets[v];
+    }
+
+    int* fill = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        fill[v] = edges->offsets[v];
+    }
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int pos = fill[graph->targets[e]]++;
+            edges->src[pos] = u;
+            edges->weight[pos] = graph->weights[e];
+        }
+    }
+
+    free(fill);
+    return edges;
+}
+
+void destroyEdgeArrays(EdgeArrays* edges) {
+    if (!edges) return;
+    free(edges->offsets);
+    free(edges->src);
+    free(edges->weight);
+    free(edges);
+}
+
+// Mínimo de dist[src] + weight sobre las aristas [begin, end); INF si
+// ningún origen es alcanzable
+static int relaxIncomingScalar(const int* dist, const int* src, const int* weight, int begin, int end) {
+    int best = INF;
+    for (int i = begin; i < end; i++) {
+        int du = dist[src[i]];
+        if (du != INF && du + weight[i] < best) {
+            best = du + weight[i];
+        }
+    }
+    return best;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BELLMAN_FORD_HAS_AVX2_KERNEL 1
+
+// Mismo cálculo de a 8 aristas: gather de dist[src], suma del peso y
+// mínimo por carril; los orígenes en INF se dejan en INF para no desbordar.
+// Se compila para AVX2 aunque el resto del archivo no, y solo se llama si
+// la CPU lo soporta
+__attribute__((target("avx2")))
+static int relaxIncomingAVX2(const int* dist, const int* src, const int* weight, int begin, int end) {
+    const __m256i inf = _mm256_set1_epi32(INF);
+    __m256i best = inf;
+    int i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i w = _mm256_loadu_si256((const __m256i*)(weight + i));
+        __m256i du = _mm256_i32gather_epi32(dist, idx, 4);
+        __m256i unreachable = _mm256_cmpeq_epi32(du, inf);
+        __m256i candidate = _mm256_blendv_epi8(_mm256_add_epi32(du, w), inf, unreachable);
+        best = _mm256_min_epi32(best, candidate);
+    }
+
+    // Reducción horizontal de los 8 carriles
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    int result = _mm_cvtsi128_si32(half);
+
+    int tail = relaxIncomingScalar(dist, src, weight, i, end);
+    return tail < result ? tail : result;
+}
+#endif
+
+bool bellmanFordUsesAVX2(void) {
+#ifdef BELLMAN_FORD_HAS_AVX2_KERNEL
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+int* bellmanFordEdgeArrays(const EdgeArrays* edges, int start, bool* hasNegativeCycle) {
+    if (hasNegativeCycle) *hasNegativeCycle = false;
+    if (!edges || start < 0 || start >= edges->numVertices) return NULL;
+
+    int n = edges->numVertices;
+    int (*relaxIncoming)(const int*, const int*, const int*, int, int) = relaxIncomingScalar;
+#ifdef BELLMAN_FORD_HAS_AVX2_KERNEL
+    if (bellmanFordUsesAVX2()) relaxIncoming = relaxIncomingAVX2;
+#endif
+
+    int* dist = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+    }
+    dist[start] = 0;
+
+    // Hasta V-1 pasadas para converger y una más para detectar el ciclo;
+    // una pasada sin cambios corta antes
+    bool updated = true;
+    for (int pass = 0; pass < n && updated; pass++) {
+        updated = false;
+        for (int v = 0; v < n; v++) {
+            int best = relaxIncoming(dist, edges->src, edges->weight,
+                                     edges->offsets[v], edges->offsets[v + 1]);
+            if (best < dist[v]) {
+                dist[v] = best;
+                updated = true;
+            }
+        }
+    }
+
+    if (updated) {
+        if (hasNegativeCycle) *hasNegativeCycle = true;
+        free(dist);
+        return NULL;
+    }
+    return dist;
+}
+
+PathResult* bellmanFordVectorized(const CSRGraph* graph, int start, int end) {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    result->path = NULL;
+    result->pathLength = 0;
+    result->totalWeight = INF;
+    result->hasPath = false;
+
+    if (!graph || start < 0 || start >= graph->numVertices ||
+        end < 0 || end >= graph->numVertices) {
+        return result;
+    }
+
+    EdgeArrays* edges = createEdgeArrays(graph);
+    bool hasNegativeCycle = false;
+    int* dist = bellmanFordEdgeArrays(edges, start, &hasNegativeCycle);
+    destroyEdgeArrays(edges);
+
+    if (hasNegativeCycle) {
+        printf("¡Advertencia: Ciclo negativo detectado!\n");
+        return result;
+    }
+    if (!dist || dist[end] == INF) {
+        free(dist);
+        return result;
+    }
+
+    // El kernel no guarda padres: se arma un árbol con las aristas ajustadas
+    // (dist[u] + w == dist[v]) recorriendo desde start; así los ciclos de
+    // peso cero no generan padres circulares
+    int n = graph->numVertices;
+    int* parent = (int*)malloc(n * sizeof(int));
+    int* queue = (int*)malloc(n * sizeof(int));
+    bool* visited = (bool*)calloc(n, sizeof(bool));
+    for (int i = 0; i < n; i++) {
+        parent[i] = -1;
+    }
+
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    visited[start] = true;
+    while (head < tail && !visited[end]) {
+        int u = queue[head++];
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            if (!visited[v] && dist[u] + graph->weights[e] == dist[v]) {
+                visited[v] = true;
+                parent[v] = u;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    buildPathFromParents(result, parent, end, dist[end]);
+
+    free(parent);
+    free(queue);
+    free(visited);
+    free(dist);
+    return result;
+}
@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <limits.h>
 #include "common_types.h"
+#include "../graph/csr_graph.h"
 
 
 
@@ -15,4 +16,35 @@ bool* bellmanFordNegativeCycles(int** graph, int numVertices, int start);
 bool bellmanFordDetectNegativeCycle(int** graph, int numVertices);
 void printBellmanFordResult(PathResult * result, int start, int end);
 
+// Versiones sobre grafo CSR (cada pasada recorre E arcos en lugar de V²)
+PathResult* bellmanFordCSR(const CSRGraph* graph, int start, int end);
+bool bellmanFordDetectNegativeCycleCSR(const CSRGraph* graph);
+
+// Variante con cola (SPFA): solo se vuelven a relajar los vértices cuya
+// distancia bajó; un camino de V aristas indica un ciclo negativo
+PathResult* bellmanFordQueueCSR(const CSRGraph* graph, int start, int end);
+PathResult* bellmanFordQueue(int** graph, int numVertices, int start, int end);
+
+// Aristas en arreglos separados (SoA) agrupadas por destino: las entrantes
+// de v ocupan [offsets[v], offsets[v + 1]) en src y weight. Cada pasada
+// recorre los arreglos en orden y el mínimo por destino se vectoriza
+typedef struct {
+    int numVertices;
+    int numEdges;
+    int* offsets;    // numVertices + 1 entradas
+    int* src;
+    int* weight;
+} EdgeArrays;
+
+EdgeArrays* createEdgeArrays(const CSRGraph* graph);
+void destroyEdgeArrays(EdgeArrays* edges);
+
+// Distancias desde start (INF = inalcanzable); devuelve NULL y marca
+// hasNegativeCycle si hay un ciclo negativo alcanzable
+int* bellmanFordEdgeArrays(const EdgeArrays* edges, int start, bool* hasNegativeCycle);
+PathResult* bellmanFordVectorized(const CSRGraph* graph, int start, int end);
+
+// true si el kernel de relajación usa AVX2 en esta máquina
+bool bellmanFordUsesAVX2(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,167 @@
+//
+// Created by administrador on 6/24/25.
+//
+
+#include "boruvka.h"
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "../utils/parallel_utils.h"
+
+#define BORUVKA_CHUNK 65536          // Aristas (o vértices) por tarea
+#define BORUVKA_NONE UINT64_MAX
+
+typedef struct {
+    Edge* edges;                     // Aristas que siguen entre componentes
+    int numEdges;
+    int numVertices;
+    int* component;                  // Representante de cada vértice en esta ronda
+    _Atomic uint64_t* best;          // Mejor arista por componente: (peso, índice)
+    int* chunkKept;                  // Aristas que quedan en cada tramo tras filtrar
+    UnionFind* uf;
+} BoruvkaJob;
+
+// Clave comparable como entero sin signo: peso (con el signo corrido) en
+// la parte alta e índice en la baja, así el mínimo desempata por índice
+static uint64_t boruvkaKey(int weight, int index) {
+    return ((uint64_t)((uint32_t)weight ^ 0x80000000u) << 32) | (uint32_t)index;
+}
+
+static void atomicMinKey(_Atomic uint64_t* slot, uint64_t key) {
+    uint64_t old = atomic_load_explicit(slot, memory_order_relaxed);
+    while (key < old &&
+           !atomic_compare_exchange_weak_explicit(slot, &old, key,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+// Representantes de los vértices de un tramo; find sin compresión no
+// escribe, así que los hilos pueden leer el UnionFind a la vez
+static void boruvkaResolveComponents(int task, int threadIndex, void* context) {
+    (void)threadIndex;
+    BoruvkaJob* job = (BoruvkaJob*)context;
+    int begin = task * BORUVKA_CHUNK;
+    int end = begin + BORUVKA_CHUNK < job->numVertices ? begin + BORUVKA_CHUNK : job->numVertices;
+
+    for (int v = begin; v < end; v++) {
+        job->component[v] = findWithoutCompression(job->uf, v);
+    }
+}
+
+// Filtra las aristas internas del tramo (compactándolo en su lugar) y
+// propone las que quedan como mínimas de sus dos componentes
+static void boruvkaScanEdges(int task, int threadIndex, void* context) {
+    (void)threadIndex;
+    BoruvkaJob* job = (BoruvkaJob*)context;
+    int begin = task * BORUVKA_CHUNK;
+    int end = begin + BORUVKA_CHUNK < job->numEdges ? begin + BORUVKA_CHUNK : job->numEdges;
+    int kept = begin;
+
+    for (int i = begin; i < end; i++) {
+        Edge edge = job->edges[i];
+        int cu = job->component[edge.src];
+        int cv = job->component[edge.dest];
+        if (cu == cv) continue;
+
+        job->edges[kept] = edge;
+        uint64_t key = boruvkaKey(edge.weight, kept);
+        atomicMinKey(&job->best[cu], key);
+        atomicMinKey(&job->best[cv], key);
+        kept++;
+    }
+    job->chunkKept[task] = kept - begin;
+}
+
+MST* boruvkaMST(int numVertices, const Edge* edges, int numEdges, int numThreads) {
+    if (numVertices < 0 || (numEdges > 0 && !edges)) return NULL;
+
+    MST* mst = (MST*)malloc(sizeof(MST));
+    mst->edges = (Edge*)malloc((numVertices > 1 ? numVertices - 1 : 1) * sizeof(Edge));
+    mst->edgeCount = 0;
+    mst->totalWeight = 0;
+
+    if (numVertices == 0) return mst;
+    numThreads = resolveThreadCount(numThreads);
+
+    BoruvkaJob job;
+    job.numVertices = numVertices;
+    job.edges = (Edge*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(Edge));
+    job.numEdges = 0;
+    for (int i = 0; i < numEdges; i++) {
+        if (edges[i].src < 0 || edges[i].src >= numVertices ||
+            edges[i].dest < 0 || edges[i].dest >= numVertices ||
+            edges[i].src == edges[i].dest) {
+            continue;
+        }
+        job.edges[job.numEdges++] = edges[i];
+    }
+
+    int* component = (int*)malloc(numVertices * sizeof(int));
+    job.component = component;
+    job.best = (_Atomic uint64_t*)malloc(numVertices * sizeof(_Atomic uint64_t));
+    job.chunkKept = (int*)malloc((job.numEdges / BORUVKA_CHUNK + 1) * sizeof(int));
+    job.uf = createUnionFind(numVertices);
+
+    int vertexTasks = (numVertices + BORUVKA_CHUNK - 1) / BORUVKA_CHUNK;
+
+    while (job.numEdges > 0 && mst->edgeCount < numVertices - 1) {
+        parallelFor(vertexTasks, numThreads, boruvkaResolveComponents, &job);
+        for (int v = 0; v < numVertices; v++) {
+            atomic_init(&job.best[v], BORUVKA_NONE);
+        }
+
+        int edgeTasks = (job.numEdges + BORUVKA_CHUNK - 1) / BORUVKA_CHUNK;
+        parallelFor(edgeTasks, numThreads, boruvkaScanEdges, &job);
+
+        // Juntar los tramos filtrados; los índices guardados en best se
+        // corrigen con el desplazamiento de su tramo
+        int* shift = (int*)malloc(edgeTasks * sizeof(int));
+        int total = 0;
+        for (int t = 0; t < edgeTasks; t++) {
+            shift[t] = t * BORUVKA_CHUNK - total;
+            if (total != t * BORUVKA_CHUNK) {
+                memmove(job.edges + total, job.edges + t * BORUVKA_CHUNK, job.chunkKept[t] * sizeof(Edge));
+            }
+            total += job.chunkKept[t];
+        }
+
+        // Unir cada componente con su arista mínima. Dos componentes que se
+        // eligen mutuamente proponen la misma arista: la segunda no une nada
+        bool merged = false;
+        for (int v = 0; v < numVertices; v++) {
+            if (component[v] != v) continue;
+            uint64_t key = atomic_load_explicit(&job.best[v], memory_order_relaxed);
+            if (key == BORUVKA_NONE) continue;
+
+            int index = (int)(uint32_t)key;
+            index -= shift[index / BORUVKA_CHUNK];
+            Edge edge = job.edges[index];
+            if (unionByRank(job.uf, edge.src, edge.dest)) {
+                mst->edges[mst->edgeCount++] = edge;
+                mst->totalWeight += edge.weight;
+                merged = true;
+            }
+        }
+
+        free(shift);
+        job.numEdges = total;
+        if (!merged) break;
+    }
+
+    destroyUnionFind(job.uf);
+    free((void*)job.best);
+    free(job.chunkKept);
+    free(component);
+    free(job.edges);
+    return mst;
+}
+
+MST* boruvkaMSTCSR(const CSRGraph* graph, int numThreads) {
+    if (!graph) return NULL;
+
+    int numEdges;
+    Edge* edges = csrUndirectedEdges(graph, &numEdges);
+    MST* mst = boruvkaMST(graph->numVertices, edges, numEdges, numThreads);
+    free(edges);
+    return mst;
+}
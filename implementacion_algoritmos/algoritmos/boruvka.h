@@ -0,0 +1,24 @@
+//
+// Created by administrador on 6/24/25.
+//
+
+#ifndef BORUVKA_H
+#define BORUVKA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "common_types.h"
+#include "kruskal.h"
+#include "../graph/csr_graph.h"
+
+// Borůvka paralelo sobre lista de aristas no dirigidas. En cada ronda los
+// hilos buscan la arista más liviana que sale de cada componente (empates
+// por posición, para no cerrar ciclos) y luego se unen con el UnionFind.
+// Entre rondas se descartan las aristas internas a un componente, así
+// que cada ronda recorre menos aristas. numThreads <= 0 = todos los
+// núcleos. Para grafos no conexos devuelve un bosque.
+MST* boruvkaMST(int numVertices, const Edge* edges, int numEdges, int numThreads);
+MST* boruvkaMSTCSR(const CSRGraph* graph, int numThreads);
+
+#endif //BORUVKA_H
@@ -0,0 +1,119 @@
+//
+// Created by administrador on 6/25/25.
+//
+
+#include "connected_components.h"
+#include "../estructura_datos/concurrent_union_find.h"
+#include "../utils/parallel_utils.h"
+
+#define COMPONENTS_CHUNK 65536   // Aristas (o vértices) por tarea
+
+typedef struct {
+    ConcurrentUnionFind* uf;
+    const Edge* edges;              // Lista de aristas (NULL si se usa el CSR)
+    int numEdges;
+    const CSRGraph* graph;
+    int numVertices;
+    int* components;
+} ComponentsJob;
+
+static void unionEdgeChunk(int task, int threadIndex, void* context) {
+    (void)threadIndex;
+    ComponentsJob* job = (ComponentsJob*)context;
+    int begin = task * COMPONENTS_CHUNK;
+    int end = begin + COMPONENTS_CHUNK < job->numEdges ? begin + COMPONENTS_CHUNK : job->numEdges;
+
+    for (int i = begin; i < end; i++) {
+        concurrentUnion(job->uf, job->edges[i].src, job->edges[i].dest);
+    }
+}
+
+// En el CSR las tareas son tramos de vértices; cada arista se une una vez (u < v)
+static void unionVertexChunk(int task, int threadIndex, void* context) {
+    (void)threadIndex;
+    ComponentsJob* job = (ComponentsJob*)context;
+    const CSRGraph* g = job->graph;
+    int begin = task * COMPONENTS_CHUNK;
+    int end = begin + COMPONENTS_CHUNK < job->numVertices ? begin + COMPONENTS_CHUNK : job->numVertices;
+
+    for (int u = begin; u < end; u++) {
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            if (u < g->targets[e] || g->isDirected) {
+                concurrentUnion(job->uf, u, g->targets[e]);
+            }
+        }
+    }
+}
+
+static void findRootChunk(int task, int threadIndex, void* context) {
+    (void)threadIndex;
+    ComponentsJob* job = (ComponentsJob*)context;
+    int begin = task * COMPONENTS_CHUNK;
+    int end = begin + COMPONENTS_CHUNK < job->numVertices ? begin + COMPONENTS_CHUNK : job->numVertices;
+
+    for (int v = begin; v < end; v++) {
+        job->components[v] = concurrentFind(job->uf, v);
+    }
+}
+
+// Con las uniones terminadas la raíz es el vértice mínimo del componente:
+// numerar las raíces en orden da la misma numeración que el DFS matricial
+static int* labelComponents(ComponentsJob* job, int numThreads, int* numComponents) {
+    int vertexTasks = (job->numVertices + COMPONENTS_CHUNK - 1) / COMPONENTS_CHUNK;
+    parallelFor(vertexTasks, numThreads, findRootChunk, job);
+
+    int count = 0;
+    for (int v = 0; v < job->numVertices; v++) {
+        int root = job->components[v];
+        job->components[v] = root == v ? count++ : job->components[root];
+    }
+
+    *numComponents = count;
+    return job->components;
+}
+
+int* connectedComponentsParallel(int numVertices, const Edge* edges, int numEdges,
+                                 int numThreads, int* numComponents) {
+    *numComponents = 0;
+    if (numVertices <= 0 || (numEdges > 0 && !edges)) return NULL;
+
+    numThreads = resolveThreadCount(numThreads);
+
+    // Las aristas con extremos inválidos se descartan en concurrentUnion
+    ComponentsJob job;
+    job.uf = createConcurrentUnionFind(numVertices);
+    job.edges = edges;
+    job.numEdges = numEdges;
+    job.graph = NULL;
+    job.numVertices = numVertices;
+    job.components = (int*)malloc(numVertices * sizeof(int));
+
+    int edgeTasks = (numEdges + COMPONENTS_CHUNK - 1) / COMPONENTS_CHUNK;
+    parallelFor(edgeTasks, numThreads, unionEdgeChunk, &job);
+
+    int* components = labelComponents(&job, numThreads, numComponents);
+    destroyConcurrentUnionFind(job.uf);
+    return components;
+}
+
+int* connectedComponentsCSR(const CSRGraph* graph, int numThreads, int* numComponents) {
+    *numComponents = 0;
+    if (!graph || graph->numVertices <= 0) return NULL;
+
+    numThreads = resolveThreadCount(numThreads);
+
+    ComponentsJob job;
+    job.uf = createConcurrentUnionFind(graph->numVertices);
+    job.edges = NULL;
+    job.numEdges = 0;
+    job.graph = graph;
+    job.numVertices = graph->numVertices;
+    job.components = (int*)malloc(graph->numVertices * sizeof(int));
+
+    int vertexTasks = (graph->numVertices + COMPONENTS_CHUNK - 1) / COMPONENTS_CHUNK;
+    parallelFor(vertexTasks, numThreads, unionVertexChunk, &job);
+
+    int* components = labelComponents(&job, numThreads, numComponents);
+    destroyConcurrentUnionFind(job.uf);
+    return components;
+}
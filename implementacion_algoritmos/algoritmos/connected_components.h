@@ -0,0 +1,23 @@
+//
+// Created by administrador on 6/25/25.
+//
+
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "common_types.h"
+#include "../graph/csr_graph.h"
+
+// Componentes conexos sobre una lista de aristas (se ignora la dirección).
+// Los hilos unen tramos de aristas en un ConcurrentUnionFind y después se
+// etiqueta cada vértice. Devuelve components[v] en [0, numComponents),
+// numerados por su vértice más chico, igual que getConnectedComponents.
+// numThreads <= 0 = todos los núcleos.
+int* connectedComponentsParallel(int numVertices, const Edge* edges, int numEdges,
+                                 int numThreads, int* numComponents);
+int* connectedComponentsCSR(const CSRGraph* graph, int numThreads, int* numComponents);
+
+#endif //CONNECTED_COMPONENTS_H
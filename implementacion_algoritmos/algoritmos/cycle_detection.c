@@ -2,88 +2,142 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "cycle_detection.h"
+#include "dfs_engine.h"
 
-// Detección de ciclos en grafo no dirigido usando DFS
-bool hasCycleUndirectedDFS(int** graph, int numVertices, int v, bool* visited, int parent) {
-    visited[v] = true;
-    
-    // Recorrer todos los vértices adyacentes
-    for (int i = 0; i < numVertices; i++) {
-        if (graph[v][i] != 0) { // Hay arista
-            if (!visited[i]) {
-                if (hasCycleUndirectedDFS(graph, numVertices, i, visited, v)) {
-                    return true;
-                }
-            } else if (i != parent) {
-                // Si el vértice ya está visitado y no es el padre, hay ciclo
-                return true;
-            }
-        }
+// Los recorridos usan el motor de DFS con pila explícita, así que grafos
+// con caminos muy largos no desbordan la pila de llamadas
+
+typedef struct {
+    DFSEngine* engine;
+    int root;
+    int rootParent;        // Padre "externo" de la raíz (no dirigidos)
+    bool* visited;         // Arreglos del que llama (pueden ser NULL)
+    bool* recStack;
+    bool* skippedParent;   // CSR no dirigido: ya se ignoró el arco al padre
+} CycleContext;
+
+static bool markVisited(int vertex, int parent, void* context) {
+    (void)parent;
+    CycleContext* ctx = (CycleContext*)context;
+    if (ctx->visited) ctx->visited[vertex] = true;
+    if (ctx->recStack) ctx->recStack[vertex] = true;
+    return true;
+}
+
+static bool leaveRecursionStack(int vertex, int parent, void* context) {
+    (void)parent;
+    CycleContext* ctx = (CycleContext*)context;
+    if (ctx->recStack) ctx->recStack[vertex] = false;
+    return true;
+}
+
+// No dirigido: cualquier arista a un vértice ya visitado que no sea el
+// padre cierra un ciclo. Devolver false corta el recorrido.
+static bool undirectedCycleEdge(int from, int to, DFSEdgeType type, void* context) {
+    CycleContext* ctx = (CycleContext*)context;
+    if (type == DFS_EDGE_TREE) return true;
+
+    int parent = from == ctx->root ? ctx->rootParent : ctx->engine->parent[from];
+    return to == parent;
+}
+
+// Dirigido: un arco hacia un vértice en la pila es un ciclo
+static bool directedCycleEdge(int from, int to, DFSEdgeType type, void* context) {
+    (void)from;
+    (void)to;
+    (void)context;
+    return type != DFS_EDGE_BACK;
+}
+
+// CSR no dirigido: el arco de vuelta al padre se ignora una sola vez, así
+// que las aristas paralelas sí cuentan como ciclo
+static bool undirectedMultiCycleEdge(int from, int to, DFSEdgeType type, void* context) {
+    CycleContext* ctx = (CycleContext*)context;
+    if (type == DFS_EDGE_TREE) return true;
+
+    if (to == ctx->engine->parent[from] && !ctx->skippedParent[from]) {
+        ctx->skippedParent[from] = true;
+        return true;
     }
-    
     return false;
 }
 
+bool hasCycleUndirectedDFSWithEngine(DFSEngine* engine, int** graph, int numVertices, int v,
+                                     bool* visited, int parent) {
+    if (!engine || v < 0 || v >= numVertices) return false;
+    if (engine->numVertices != numVertices) dfsEngineResetVisited(engine, numVertices, visited);
+
+    DFSGraphView view = dfsViewFromMatrix(graph, numVertices);
+    CycleContext ctx = {engine, v, parent, visited, NULL, NULL};
+    DFSVisitor visitor = {markVisited, NULL, undirectedCycleEdge, &ctx};
+    return !dfsEngineRun(engine, &view, v, &visitor);
+}
+
+// Detección de ciclos en grafo no dirigido usando DFS desde v
+bool hasCycleUndirectedDFS(int** graph, int numVertices, int v, bool* visited, int parent) {
+    if (v < 0 || v >= numVertices) return false;
+
+    DFSEngine* engine = dfsThreadEngine(numVertices);
+    dfsEngineResetVisited(engine, numVertices, visited);
+    return hasCycleUndirectedDFSWithEngine(engine, graph, numVertices, v, visited, parent);
+}
+
 // Detección de ciclos en grafo no dirigido
 bool hasCycleUndirected(int** graph, int numVertices) {
-    bool* visited = (bool*)calloc(numVertices, sizeof(bool));
-    
+    if (numVertices <= 0) return false;
+
+    DFSGraphView view = dfsViewFromMatrix(graph, numVertices);
+    DFSEngine* engine = dfsThreadEngine(numVertices);
+    dfsEngineReset(engine, numVertices);
+
+    CycleContext ctx = {engine, -1, -1, NULL, NULL, NULL};
+    DFSVisitor visitor = {NULL, NULL, undirectedCycleEdge, &ctx};
+    bool found = false;
+
     // Verificar cada componente conexo
-    for (int i = 0; i < numVertices; i++) {
-        if (!visited[i]) {
-            if (hasCycleUndirectedDFS(graph, numVertices, i, visited, -1)) {
-                free(visited);
-                return true;
-            }
+    for (int i = 0; i < numVertices && !found; i++) {
+        if (engine->state[i] == DFS_WHITE) {
+            ctx.root = i;
+            found = !dfsEngineRun(engine, &view, i, &visitor);
         }
     }
-    
-    free(visited);
-    return false;
+
+    return found;
+}
+
+bool hasCycleDFSWithEngine(DFSEngine* engine, int** graph, int numVertices, int v,
+                           bool* visited, bool* recStack) {
+    if (!engine || v < 0 || v >= numVertices) return false;
+    if (engine->numVertices != numVertices) dfsEngineResetVisited(engine, numVertices, visited);
+
+    // recStack se consulta durante el recorrido en lugar de copiarlo
+    engine->onStack = recStack;
+
+    DFSGraphView view = dfsViewFromMatrix(graph, numVertices);
+    CycleContext ctx = {engine, v, -1, visited, recStack, NULL};
+    DFSVisitor visitor = {markVisited, leaveRecursionStack, directedCycleEdge, &ctx};
+    return !dfsEngineRun(engine, &view, v, &visitor);
 }
 
-// Detección de ciclos en grafo dirigido usando DFS
+// Detección de ciclos en grafo dirigido usando DFS desde v. Los vértices
+// con recStack[v] = true cuentan como ancestros todavía en la pila.
 bool hasCycleDFS(int** graph, int numVertices, int v, bool* visited, bool* recStack) {
-    visited[v] = true;
-    recStack[v] = true;
-    
-    // Recorrer todos los vértices adyacentes
-    for (int i = 0; i < numVertices; i++) {
-        if (graph[v][i] != 0) { // Hay arista dirigida de v a i
-            if (!visited[i]) {
-                if (hasCycleDFS(graph, numVertices, i, visited, recStack)) {
-                    return true;
-                }
-            } else if (recStack[i]) {
-                // Si el vértice está en la pila de recursión, hay ciclo
-                return true;
-            }
-        }
-    }
-    
-    recStack[v] = false; // Remover de la pila de recursión
-    return false;
+    if (v < 0 || v >= numVertices) return false;
+
+    DFSEngine* engine = dfsThreadEngine(numVertices);
+    dfsEngineResetVisited(engine, numVertices, visited);
+    return hasCycleDFSWithEngine(engine, graph, numVertices, v, visited, recStack);
 }
 
 // Detección de ciclos en grafo dirigido
 bool hasCycleDirected(int** graph, int numVertices) {
-    bool* visited = (bool*)calloc(numVertices, sizeof(bool));
-    bool* recStack = (bool*)calloc(numVertices, sizeof(bool));
-    
+    if (numVertices <= 0) return false;
+
+    DFSGraphView view = dfsViewFromMatrix(graph, numVertices);
+    DFSVisitor visitor = {NULL, NULL, directedCycleEdge, NULL};
+
     // Verificar cada vértice
-    for (int i = 0; i < numVertices; i++) {
-        if (!visited[i]) {
-            if (hasCycleDFS(graph, numVertices, i, visited, recStack)) {
-                free(visited);
-                free(recStack);
-                return true;
-            }
-        }
-    }
-    
-    free(visited);
-    free(recStack);
-    return false;
+    return !dfsEngineRunAll(dfsThreadEngine(numVertices), &view, &visitor);
 }
 
 // Función para detectar ciclos automáticamente (determina si es dirigido o no)
@@ -95,6 +149,30 @@ bool detectCycles(int** graph, int numVertices, bool isDirected) {
     }
 }
 
+// Detección de ciclos en grafo dirigido CSR
+bool hasCycleDirectedCSR(const CSRGraph* graph) {
+    if (!graph || graph->numVertices <= 0) return false;
+
+    DFSGraphView view = dfsViewFromCSR(graph);
+    DFSVisitor visitor = {NULL, NULL, directedCycleEdge, NULL};
+    return !dfsEngineRunAll(dfsThreadEngine(graph->numVertices), &view, &visitor);
+}
+
+// Detección de ciclos en grafo no dirigido CSR
+bool hasCycleUndirectedCSR(const CSRGraph* graph) {
+    if (!graph || graph->numVertices <= 0) return false;
+
+    DFSGraphView view = dfsViewFromCSR(graph);
+    CycleContext ctx = {dfsThreadEngine(graph->numVertices), -1, -1, NULL, NULL, NULL};
+    ctx.skippedParent = (bool*)calloc(graph->numVertices, sizeof(bool));
+    DFSVisitor visitor = {NULL, NULL, undirectedMultiCycleEdge, &ctx};
+
+    bool found = !dfsEngineRunAll(ctx.engine, &view, &visitor);
+
+    free(ctx.skippedParent);
+    return found;
+}
+
 void printCycleDetectionResult(bool hasCycle, const char* graphType) {
     printf("\n=== DETECCIÓN DE CICLOS ===\n");
     printf("Tipo de grafo: %s\n", graphType);
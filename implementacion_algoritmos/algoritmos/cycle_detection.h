@@ -5,11 +5,27 @@
 #ifndef CYCLE_DETECTION_H
 #define CYCLE_DETECTION_H
 
+#include <stdbool.h>
+#include "../graph/csr_graph.h"
+#include "dfs_engine.h"
+
 // Prototipos de funciones
 bool hasCycleUndirected(int** graph, int numVertices);
 bool hasCycleDirected(int** graph, int numVertices);
 bool hasCycleUndirectedDFS(int** graph, int numVertices, int v, bool* visited, int parent);
 bool hasCycleDFS(int** graph, int numVertices, int v, bool* visited, bool* recStack);
+
+// Con un motor del que llama, reiniciado una vez con dfsEngineResetVisited
+// antes de la primera raíz: cada llamada cuesta solo lo que recorre
+bool hasCycleUndirectedDFSWithEngine(DFSEngine* engine, int** graph, int numVertices, int v,
+                                     bool* visited, int parent);
+bool hasCycleDFSWithEngine(DFSEngine* engine, int** graph, int numVertices, int v,
+                           bool* visited, bool* recStack);
+
+// Versiones CSR sobre el motor de DFS (sin recursión)
+bool hasCycleDirectedCSR(const CSRGraph* graph);
+bool hasCycleUndirectedCSR(const CSRGraph* graph);
+
 void printCycleDetectionResult(bool hasCycle, const char* graphType);
 
 #endif //CYCLE_DETECTION_H
@@ -0,0 +1,332 @@
+//
+// Created by administrador on 6/22/25.
+//
+
+#include "delta_stepping.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../utils/parallel_utils.h"
+
+#define INF INT_MAX
+#define DELTA_STEPPING_CHUNK 256   // Vértices del frente que toma un hilo por vez
+
+typedef struct {
+    int* data;
+    int size;
+    int capacity;
+} DSIntList;
+
+static void dsListPush(DSIntList* list, int value) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 64;
+        list->data = (int*)realloc(list->data, list->capacity * sizeof(int));
+    }
+    list->data[list->size++] = value;
+}
+
+// Lo que produce cada hilo durante una fase; el hilo 0 lo junta entre fases
+typedef struct {
+    DSIntList next;      // Vértices que vuelven al balde actual
+    DSIntList later;     // Pares (vértice, balde) para baldes posteriores
+    DSIntList settled;   // Vértices del balde actual (para las aristas pesadas)
+} DSThreadState;
+
+typedef struct {
+    const CSRGraph* graph;
+    int delta;
+    int numThreads;
+
+    _Atomic int* dist;
+    atomic_int* phaseMark;     // Última fase liviana en que se procesó el vértice
+    atomic_int* bucketMark;    // Último balde (+1) en que se agregó a settled
+
+    // Baldes circulares: los pendientes siempre caben en numSlots baldes
+    DSIntList* slots;
+    int numSlots;
+    int currentBucket;
+
+    DSIntList frontier;
+    atomic_int nextIndex;
+    int phase;
+    bool heavyPhase;
+    bool done;
+
+    pthread_barrier_t barrier;
+    DSThreadState* threads;
+
+    // Los hilos esperan a saber cuántos se crearon antes de usar la barrera
+    pthread_mutex_t startLock;
+    pthread_cond_t startSignal;
+    bool started;
+} DSContext;
+
+typedef struct {
+    DSContext* ctx;
+    int threadIndex;
+} DSWorker;
+
+int deltaSteppingSuggestDelta(const CSRGraph* graph) {
+    if (!graph || graph->numVertices == 0 || graph->numEdges == 0) return 1;
+
+    int maxWeight = 0;
+    for (int e = 0; e < graph->numEdges; e++) {
+        if (graph->weights[e] > maxWeight) maxWeight = graph->weights[e];
+    }
+
+    int avgDegree = graph->numEdges / graph->numVertices;
+    int delta = maxWeight / (avgDegree > 0 ? avgDegree : 1);
+    return delta > 0 ? delta : 1;
+}
+
+// Bajar dist[v] a newDist si mejora y anotar v en el balde que corresponda
+static void dsRelax(DSContext* ctx, DSThreadState* state, int v, int newDist) {
+    int old = atomic_load_explicit(&ctx->dist[v], memory_order_relaxed);
+
+    while (newDist < old) {
+        if (atomic_compare_exchange_weak_explicit(&ctx->dist[v], &old, newDist,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            int bucket = newDist / ctx->delta;
+            if (bucket == ctx->currentBucket) {
+                dsListPush(&state->next, v);
+            } else {
+                dsListPush(&state->later, v);
+                dsListPush(&state->later, bucket);
+            }
+            return;
+        }
+    }
+}
+
+// Fase liviana: relajar las aristas de peso <= delta de los vértices del frente
+static void dsLightPhase(DSContext* ctx, DSThreadState* state) {
+    const CSRGraph* g = ctx->graph;
+    int start;
+
+    while ((start = atomic_fetch_add(&ctx->nextIndex, DELTA_STEPPING_CHUNK)) < ctx->frontier.size) {
+        int end = start + DELTA_STEPPING_CHUNK;
+        if (end > ctx->frontier.size) end = ctx->frontier.size;
+
+        for (int i = start; i < end; i++) {
+            int u = ctx->frontier.data[i];
+            int du = atomic_load_explicit(&ctx->dist[u], memory_order_relaxed);
+
+            // Entrada vieja (u ya bajó a otro balde) o repetida en esta fase
+            if (du / ctx->delta != ctx->currentBucket) continue;
+            if (atomic_exchange(&ctx->phaseMark[u], ctx->phase) == ctx->phase) continue;
+            if (atomic_exchange(&ctx->bucketMark[u], ctx->currentBucket + 1) != ctx->currentBucket + 1) {
+                dsListPush(&state->settled, u);
+            }
+
+            for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+                int w = g->weights[e];
+                if (w <= ctx->delta && w <= INF - 1 - du) {
+                    dsRelax(ctx, state, g->targets[e], du + w);
+                }
+            }
+        }
+    }
+}
+
+// Fase pesada: con el balde cerrado, las aristas de peso > delta solo
+// pueden llevar a baldes posteriores, así que alcanza con una pasada
+static void dsHeavyPhase(DSContext* ctx, DSThreadState* state) {
+    const CSRGraph* g = ctx->graph;
+
+    for (int i = 0; i < state->settled.size; i++) {
+        int u = state->settled.data[i];
+        int du = atomic_load_explicit(&ctx->dist[u], memory_order_relaxed);
+
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int w = g->weights[e];
+            if (w > ctx->delta && w <= INF - 1 - du) {
+                dsRelax(ctx, state, g->targets[e], du + w);
+            }
+        }
+    }
+    state->settled.size = 0;
+}
+
+// Juntar lo producido por los hilos (lo ejecuta solo el hilo 0)
+static void dsMerge(DSContext* ctx) {
+    ctx->frontier.size = 0;
+
+    for (int t = 0; t < ctx->numThreads; t++) {
+        DSThreadState* state = &ctx->threads[t];
+
+        for (int i = 0; i < state->next.size; i++) {
+            dsListPush(&ctx->frontier, state->next.data[i]);
+        }
+        state->next.size = 0;
+
+        for (int i = 0; i < state->later.size; i += 2) {
+            int bucket = state->later.data[i + 1];
+            dsListPush(&ctx->slots[bucket % ctx->numSlots], state->later.data[i]);
+        }
+        state->later.size = 0;
+    }
+
+    atomic_store(&ctx->nextIndex, 0);
+    ctx->phase++;
+}
+
+// Pasar al próximo balde no vacío (lo ejecuta solo el hilo 0)
+static void dsAdvanceBucket(DSContext* ctx) {
+    for (int step = 1; step <= ctx->numSlots; step++) {
+        int bucket = ctx->currentBucket + step;
+        DSIntList* slot = &ctx->slots[bucket % ctx->numSlots];
+        if (slot->size == 0) continue;
+
+        ctx->currentBucket = bucket;
+        ctx->frontier.size = 0;
+        for (int i = 0; i < slot->size; i++) {
+            dsListPush(&ctx->frontier, slot->data[i]);
+        }
+        slot->size = 0;
+        return;
+    }
+    ctx->done = true;
+}
+
+static void* dsWorkerMain(void* arg) {
+    DSWorker* worker = (DSWorker*)arg;
+    DSContext* ctx = worker->ctx;
+    DSThreadState* state = &ctx->threads[worker->threadIndex];
+    bool leader = worker->threadIndex == 0;
+
+    pthread_mutex_lock(&ctx->startLock);
+    while (!ctx->started) pthread_cond_wait(&ctx->startSignal, &ctx->startLock);
+    pthread_mutex_unlock(&ctx->startLock);
+
+    while (true) {
+        dsLightPhase(ctx, state);
+        pthread_barrier_wait(&ctx->barrier);
+
+        if (leader) {
+            dsMerge(ctx);
+            ctx->heavyPhase = ctx->frontier.size == 0;
+        }
+        pthread_barrier_wait(&ctx->barrier);
+
+        if (!ctx->heavyPhase) continue;
+
+        dsHeavyPhase(ctx, state);
+        pthread_barrier_wait(&ctx->barrier);
+
+        if (leader) {
+            dsMerge(ctx);
+            dsAdvanceBucket(ctx);
+        }
+        pthread_barrier_wait(&ctx->barrier);
+
+        if (ctx->done) break;
+    }
+    return NULL;
+}
+
+int* deltaSteppingCSR(const CSRGraph* graph, int start, int delta, int numThreads) {
+    if (!graph || start < 0 || start >= graph->numVertices) return NULL;
+
+    int n = graph->numVertices;
+    if (delta <= 0) delta = deltaSteppingSuggestDelta(graph);
+    numThreads = resolveThreadCount(numThreads);
+
+    int maxWeight = 0;
+    for (int e = 0; e < graph->numEdges; e++) {
+        if (graph->weights[e] > maxWeight) maxWeight = graph->weights[e];
+    }
+
+    DSContext ctx;
+    ctx.graph = graph;
+    ctx.delta = delta;
+    ctx.numThreads = numThreads;
+    ctx.dist = (_Atomic int*)malloc(n * sizeof(_Atomic int));
+    ctx.phaseMark = (atomic_int*)malloc(n * sizeof(atomic_int));
+    ctx.bucketMark = (atomic_int*)malloc(n * sizeof(atomic_int));
+    ctx.numSlots = maxWeight / delta + 2;
+    ctx.slots = (DSIntList*)calloc(ctx.numSlots, sizeof(DSIntList));
+    ctx.currentBucket = 0;
+    ctx.frontier = (DSIntList){NULL, 0, 0};
+    atomic_init(&ctx.nextIndex, 0);
+    ctx.phase = 1;
+    ctx.heavyPhase = false;
+    ctx.done = false;
+    ctx.threads = (DSThreadState*)calloc(numThreads, sizeof(DSThreadState));
+
+    for (int i = 0; i < n; i++) {
+        atomic_init(&ctx.dist[i], INF);
+        atomic_init(&ctx.phaseMark[i], 0);
+        atomic_init(&ctx.bucketMark[i], 0);
+    }
+    atomic_store(&ctx.dist[start], 0);
+    dsListPush(&ctx.frontier, start);
+
+    pthread_mutex_init(&ctx.startLock, NULL);
+    pthread_cond_init(&ctx.startSignal, NULL);
+    ctx.started = false;
+
+    DSWorker* workers = (DSWorker*)malloc(numThreads * sizeof(DSWorker));
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    for (int t = 0; t < numThreads; t++) {
+        workers[t].ctx = &ctx;
+        workers[t].threadIndex = t;
+    }
+
+    // Si no se pueden crear todos los hilos se sigue con los que haya
+    int created = 1;
+    for (int t = 1; t < numThreads; t++) {
+        if (pthread_create(&threads[t], NULL, dsWorkerMain, &workers[t]) != 0) break;
+        created++;
+    }
+    ctx.numThreads = created;
+    pthread_barrier_init(&ctx.barrier, NULL, created);
+
+    pthread_mutex_lock(&ctx.startLock);
+    ctx.started = true;
+    pthread_cond_broadcast(&ctx.startSignal);
+    pthread_mutex_unlock(&ctx.startLock);
+
+    dsWorkerMain(&workers[0]);
+    for (int t = 1; t < created; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    int* dist = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        dist[i] = atomic_load(&ctx.dist[i]);
+    }
+
+    pthread_barrier_destroy(&ctx.barrier);
+    pthread_mutex_destroy(&ctx.startLock);
+    pthread_cond_destroy(&ctx.startSignal);
+    for (int t = 0; t < numThreads; t++) {
+        free(ctx.threads[t].next.data);
+        free(ctx.threads[t].later.data);
+        free(ctx.threads[t].settled.data);
+    }
+    for (int s = 0; s < ctx.numSlots; s++) {
+        free(ctx.slots[s].data);
+    }
+    free(ctx.threads);
+    free(ctx.slots);
+    free(ctx.frontier.data);
+    free((void*)ctx.dist);
+    free((void*)ctx.phaseMark);
+    free((void*)ctx.bucketMark);
+    free(workers);
+    free(threads);
+
+    return dist;
+}
+
+int* dijkstraAllPathsParallel(int** graph, int numVertices, int start, int delta, int numThreads) {
+    if (start < 0 || start >= numVertices) return NULL;
+
+    // Dirigido para conservar exactamente los arcos de la matriz
+    CSRGraph* csr = csrFromMatrix(graph, numVertices, true);
+    if (!csr) return NULL;
+
+    int* dist = deltaSteppingCSR(csr, start, delta, numThreads);
+    destroyCSRGraph(csr);
+    return dist;
+}
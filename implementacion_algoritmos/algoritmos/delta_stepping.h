@@ -0,0 +1,28 @@
+//
+// Created by administrador on 6/22/25.
+//
+
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "common_types.h"
+#include "../graph/csr_graph.h"
+
+#define DELTA_STEPPING_AUTO 0   // Elegir Δ y cantidad de hilos automáticamente
+
+// Δ sugerido: peso máximo dividido por el grado promedio (al menos 1)
+int deltaSteppingSuggestDelta(const CSRGraph* graph);
+
+// Distancias desde start con delta-stepping paralelo (pesos no negativos).
+// Los vértices se agrupan en baldes de ancho delta; las aristas livianas
+// (peso <= delta) se relajan en fases dentro del balde y las pesadas una
+// sola vez al cerrarlo. El resultado es idéntico al de dijkstraAllPathsCSR.
+int* deltaSteppingCSR(const CSRGraph* graph, int start, int delta, int numThreads);
+
+// Misma interfaz que dijkstraAllPaths, sobre la matriz de adyacencia
+int* dijkstraAllPathsParallel(int** graph, int numVertices, int start, int delta, int numThreads);
+
+#endif //DELTA_STEPPING_H
@@ -1,4 +1,5 @@
 #include "dfs_bfs.h"
+#include "dfs_engine.h"
 
 // Crear estructura de resultado
 SearchResult* createSearchResult(int numVertices) {
@@ -18,17 +19,44 @@ SearchResult* createSearchResult(int numVertices) {
     return result;
 }
 
-// DFS recursivo (función auxiliar)
+// Arreglos del que llama que se van llenando en preorden
+typedef struct {
+    bool* visited;
+    int* visitOrder;
+    int* count;
+    int* components;
+    int currentComponent;
+} VisitRecorder;
+
+static bool recordVisit(int vertex, int parent, void* context) {
+    (void)parent;
+    VisitRecorder* recorder = (VisitRecorder*)context;
+    recorder->visited[vertex] = true;
+    recorder->visitOrder[(*recorder->count)++] = vertex;
+    return true;
+}
+
+void dfsRecursiveWithEngine(DFSEngine* engine, int** graph, int numVertices, int vertex,
+                            bool* visited, int* visitOrder, int* count) {
+    if (!engine || vertex < 0 || vertex >= numVertices) return;
+    if (engine->numVertices != numVertices) dfsEngineResetVisited(engine, numVertices, visited);
+
+    DFSGraphView view = dfsViewFromMatrix(graph, numVertices);
+    VisitRecorder recorder = {visited, visitOrder, count, NULL, 0};
+    DFSVisitor visitor = {recordVisit, NULL, NULL, &recorder};
+    dfsEngineRun(engine, &view, vertex, &visitor);
+}
+
+// DFS en preorden (mismo orden que la versión recursiva original, que
+// revisaba los vecinos por índice creciente). Corre sobre el motor con
+// pila explícita, así que no hay límite de profundidad; los vértices ya
+// marcados en visited no se vuelven a visitar.
 void dfsRecursive(int** graph, int numVertices, int vertex, bool* visited, int* visitOrder, int* count) {
-    visited[vertex] = true;
-    visitOrder[(*count)++] = vertex;
-    
-    // Visitar todos los vértices adyacentes no visitados
-    for (int i = 0; i < numVertices; i++) {
-        if (graph[vertex][i] != 0 && !visited[i]) {
-            dfsRecursive(graph, numVertices, i, visited, visitOrder, count);
-        }
-    }
+    if (vertex < 0 || vertex >= numVertices) return;
+
+    DFSEngine* engine = dfsThreadEngine(numVertices);
+    dfsEngineResetVisited(engine, numVertices, visited);
+    dfsRecursiveWithEngine(engine, graph, numVertices, vertex, visited, visitOrder, count);
 }
 
 // DFS iterativo usando stack
@@ -128,49 +156,39 @@ bool isConnected(int** graph, int numVertices, int vertex1, int vertex2) {
     return connected;
 }
 
-// Encontrar componentes conexos
+static bool labelComponent(int vertex, int parent, void* context) {
+    (void)parent;
+    VisitRecorder* recorder = (VisitRecorder*)context;
+    recorder->components[vertex] = recorder->currentComponent;
+    return true;
+}
+
+// Encontrar componentes conexos (numerados por su vértice más chico)
 int* getConnectedComponents(int** graph, int numVertices, int* numComponents) {
     int* components = (int*)malloc(numVertices * sizeof(int));
-    bool* visited = (bool*)calloc(numVertices, sizeof(bool));
     *numComponents = 0;
     
     for (int i = 0; i < numVertices; i++) {
         components[i] = -1;
     }
+    if (numVertices <= 0) return components;
+    
+    // Un solo motor para todos los componentes
+    DFSGraphView view = dfsViewFromMatrix(graph, numVertices);
+    DFSEngine* engine = dfsThreadEngine(numVertices);
+    dfsEngineReset(engine, numVertices);
+    
+    VisitRecorder recorder = {NULL, NULL, NULL, components, 0};
+    DFSVisitor visitor = {labelComponent, NULL, NULL, &recorder};
     
     for (int i = 0; i < numVertices; i++) {
-        if (!visited[i]) {
+        if (engine->state[i] == DFS_WHITE) {
             // Nuevo componente encontrado
-            int currentComponent = *numComponents;
-            (*numComponents)++;
-            
-            // DFS para marcar todos los vértices del componente
-            int* stack = (int*)malloc(numVertices * sizeof(int));
-            int top = 0;
-            
-            stack[top++] = i;
-            
-            while (top > 0) {
-                int vertex = stack[--top];
-                
-                if (!visited[vertex]) {
-                    visited[vertex] = true;
-                    components[vertex] = currentComponent;
-                    
-                    // Agregar vértices adyacentes
-                    for (int j = 0; j < numVertices; j++) {
-                        if (graph[vertex][j] != 0 && !visited[j]) {
-                            stack[top++] = j;
-                        }
-                    }
-                }
-            }
-            
-            free(stack);
+            recorder.currentComponent = (*numComponents)++;
+            dfsEngineRun(engine, &view, i, &visitor);
         }
     }
     
-    free(visited);
     return components;
 }
 
@@ -244,4 +262,59 @@ void freeSearchResult(SearchResult* result) {
         if (result->parent) free(result->parent);
         free(result);
     }
-}
\ No newline at end of file
+}
+// =================================================================
+// Versiones CSR
+// =================================================================
+
+// DFS sobre grafo CSR con el motor de pila explícita. Produce el mismo
+// orden de visita que dfsRecursive sin riesgo de desbordar la pila en
+// cadenas largas.
+SearchResult* dfsCSR(const CSRGraph* graph, int startVertex) {
+    if (!graph || startVertex < 0 || startVertex >= graph->numVertices) {
+        return NULL;
+    }
+
+    SearchResult* result = createSearchResult(graph->numVertices);
+    DFSGraphView view = dfsViewFromCSR(graph);
+    DFSEngine* engine = dfsThreadEngine(graph->numVertices);
+    dfsEngineReset(engine, graph->numVertices);
+
+    VisitRecorder recorder = {result->visited, result->visitOrder, &result->visitCount, NULL, 0};
+    DFSVisitor visitor = {recordVisit, NULL, NULL, &recorder};
+    dfsEngineRun(engine, &view, startVertex, &visitor);
+    return result;
+}
+
+// BFS sobre grafo CSR
+SearchResult* bfsCSR(const CSRGraph* graph, int startVertex) {
+    if (!graph || startVertex < 0 || startVertex >= graph->numVertices) {
+        return NULL;
+    }
+
+    SearchResult* result = createSearchResult(graph->numVertices);
+
+    // visitOrder funciona como cola: los vértices se encolan en orden de visita
+    int* queue = result->visitOrder;
+    int front = 0;
+
+    result->visited[startVertex] = true;
+    result->distances[startVertex] = 0;
+    queue[result->visitCount++] = startVertex;
+
+    while (front < result->visitCount) {
+        int vertex = queue[front++];
+
+        for (int e = graph->offsets[vertex]; e < graph->offsets[vertex + 1]; e++) {
+            int neighbor = graph->targets[e];
+            if (!result->visited[neighbor]) {
+                result->visited[neighbor] = true;
+                result->distances[neighbor] = result->distances[vertex] + 1;
+                result->parent[neighbor] = vertex;
+                queue[result->visitCount++] = neighbor;
+            }
+        }
+    }
+
+    return result;
+}
@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "../graph/csr_graph.h"
+#include "dfs_engine.h"
 
 // Estructura para resultado de búsqueda
 typedef struct {
@@ -17,12 +19,21 @@ typedef struct {
 // Prototipos de funciones DFS
 SearchResult* dfs(int** graph, int numVertices, int startVertex);
 void dfsRecursive(int** graph, int numVertices, int vertex, bool* visited, int* visitOrder, int* count);
+// Igual que dfsRecursive pero con un motor del que llama, para recorrer
+// desde muchas raíces: se reinicia una vez con dfsEngineResetVisited y
+// cada llamada cuesta solo lo que recorre
+void dfsRecursiveWithEngine(DFSEngine* engine, int** graph, int numVertices, int vertex,
+                            bool* visited, int* visitOrder, int* count);
 void dfsIterative(int** graph, int numVertices, int startVertex, bool* visited, int* visitOrder, int* count);
 
 // Prototipos de funciones BFS
 SearchResult* bfs(int** graph, int numVertices, int startVertex);
 void bfsTraversal(int** graph, int numVertices, int startVertex, bool* visited, int* visitOrder, int* count, int* distances, int* parent);
 
+// Versiones sobre grafo CSR (mismo orden de visita que las versiones matriciales)
+SearchResult* dfsCSR(const CSRGraph* graph, int startVertex);
+SearchResult* bfsCSR(const CSRGraph* graph, int startVertex);
+
 // Funciones de conectividad
 bool isConnected(int** graph, int numVertices, int vertex1, int vertex2);
 int* getConnectedComponents(int** graph, int numVertices, int* numComponents);
@@ -0,0 +1,361 @@
+//
+// Created by administrador on 6/27/25.
+//
+
+#include "dfs_engine.h"
+#include <pthread.h>
+
+// =================================================================
+// Vistas de grafo
+// =================================================================
+
+// Matriz: el cursor es la próxima columna a revisar
+static int matrixNextNeighbor(const DFSGraphView* view, int vertex, intptr_t* cursor) {
+    int** matrix = (int**)view->data;
+    int n = view->numVertices;
+
+    for (int i = (int)*cursor; i < n; i++) {
+        if (matrix[vertex][i] != 0) {
+            *cursor = i + 1;
+            return i;
+        }
+    }
+    *cursor = n;
+    return -1;
+}
+
+// CSR: el cursor es el desplazamiento dentro de los arcos del vértice
+static int csrNextNeighbor(const DFSGraphView* view, int vertex, intptr_t* cursor) {
+    const CSRGraph* graph = (const CSRGraph*)view->data;
+    int e = graph->offsets[vertex] + (int)*cursor;
+
+    if (e >= graph->offsets[vertex + 1]) return -1;
+    (*cursor)++;
+    return graph->targets[e];
+}
+
+// Lista de adyacencia: el cursor es la posición del próximo arco
+static int graphNextNeighbor(const DFSGraphView* view, int vertex, intptr_t* cursor) {
+    const Graph* graph = (const Graph*)view->data;
+    const AdjList* list = &graph->adj_list[vertex];
+
+    if (*cursor >= list->size) return -1;
+    return list->aristas[(*cursor)++].vertice;
+}
+
+DFSGraphView dfsViewFromMatrix(int** matrix, int numVertices) {
+    DFSGraphView view = {numVertices, matrix, matrixNextNeighbor};
+    return view;
+}
+
+DFSGraphView dfsViewFromCSR(const CSRGraph* graph) {
+    DFSGraphView view = {graph ? graph->numVertices : 0, graph, csrNextNeighbor};
+    return view;
+}
+
+DFSGraphView dfsViewFromGraph(Graph* graph) {
+    DFSGraphView view = {graph ? graph->numVertices : 0, graph, graphNextNeighbor};
+    return view;
+}
+
+// =================================================================
+// Motor
+// =================================================================
+
+// Ampliar los arreglos; los vértices nuevos quedan en blanco
+static bool growDFSEngine(DFSEngine* engine, int capacity) {
+    if (capacity <= engine->capacity) return true;
+
+    unsigned char* state = (unsigned char*)realloc(engine->state, capacity * sizeof(unsigned char));
+    if (state) engine->state = state;
+    int* discovery = (int*)realloc(engine->discovery, capacity * sizeof(int));
+    if (discovery) engine->discovery = discovery;
+    int* parent = (int*)realloc(engine->parent, capacity * sizeof(int));
+    if (parent) engine->parent = parent;
+    int* stackVertex = (int*)realloc(engine->stackVertex, capacity * sizeof(int));
+    if (stackVertex) engine->stackVertex = stackVertex;
+    intptr_t* stackCursor = (intptr_t*)realloc(engine->stackCursor, capacity * sizeof(intptr_t));
+    if (stackCursor) engine->stackCursor = stackCursor;
+    int* touched = (int*)realloc(engine->touched, capacity * sizeof(int));
+    if (touched) engine->touched = touched;
+    if (!state || !discovery || !parent || !stackVertex || !stackCursor || !touched) return false;
+
+    for (int i = engine->capacity; i < capacity; i++) {
+        engine->state[i] = DFS_WHITE;
+        engine->parent[i] = -1;
+        engine->discovery[i] = -1;
+    }
+    engine->capacity = capacity;
+    return true;
+}
+
+DFSEngine* createDFSEngine(int capacity) {
+    if (capacity <= 0) return NULL;
+
+    DFSEngine* engine = (DFSEngine*)calloc(1, sizeof(DFSEngine));
+    if (!engine) return NULL;
+    if (!growDFSEngine(engine, capacity)) {
+        destroyDFSEngine(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void destroyDFSEngine(DFSEngine* engine) {
+    if (!engine) return;
+    free(engine->state);
+    free(engine->discovery);
+    free(engine->parent);
+    free(engine->stackVertex);
+    free(engine->stackCursor);
+    free(engine->touched);
+    free(engine);
+}
+
+// Un motor por hilo; se libera al terminar el hilo
+static pthread_key_t threadEngineKey;
+static pthread_once_t threadEngineOnce = PTHREAD_ONCE_INIT;
+
+static void releaseThreadEngine(void* engine) {
+    destroyDFSEngine((DFSEngine*)engine);
+}
+
+static void createThreadEngineKey(void) {
+    pthread_key_create(&threadEngineKey, releaseThreadEngine);
+}
+
+DFSEngine* dfsThreadEngine(int numVertices) {
+    if (numVertices <= 0) return NULL;
+    pthread_once(&threadEngineOnce, createThreadEngineKey);
+
+    DFSEngine* engine = (DFSEngine*)pthread_getspecific(threadEngineKey);
+    if (!engine) {
+        engine = createDFSEngine(numVertices);
+        if (!engine) return NULL;
+        pthread_setspecific(threadEngineKey, engine);
+    }
+    return growDFSEngine(engine, numVertices) ? engine : NULL;
+}
+
+void dfsEngineReset(DFSEngine* engine, int numVertices) {
+    if (!engine) return;
+    if (!growDFSEngine(engine, numVertices)) numVertices = engine->capacity;
+
+    // Solo lo que tocó el recorrido anterior; el resto ya está en blanco
+    for (int i = 0; i < engine->numTouched; i++) {
+        int v = engine->touched[i];
+        engine->state[v] = DFS_WHITE;
+        engine->parent[v] = -1;
+        engine->discovery[v] = -1;
+    }
+    engine->numTouched = 0;
+    engine->numVertices = numVertices;
+    engine->time = 0;
+    engine->visited = NULL;
+    engine->onStack = NULL;
+}
+
+void dfsEngineResetVisited(DFSEngine* engine, int numVertices, const bool* visited) {
+    dfsEngineReset(engine, numVertices);
+    if (engine) engine->visited = visited;
+}
+
+bool dfsEngineRun(DFSEngine* engine, const DFSGraphView* view, int root, const DFSVisitor* visitor) {
+    if (!engine || !view || root < 0 || root >= engine->numVertices) return false;
+    if (engine->state[root] != DFS_WHITE) return true;
+
+    void* context = visitor ? visitor->context : NULL;
+    bool (*preVisit)(int, int, void*) = visitor ? visitor->preVisit : NULL;
+    bool (*postVisit)(int, int, void*) = visitor ? visitor->postVisit : NULL;
+    bool (*onEdge)(int, int, DFSEdgeType, void*) = visitor ? visitor->edge : NULL;
+
+    // Cada vértice entra a la pila a lo sumo una vez: alcanza con capacity
+    int top = 0;
+    engine->touched[engine->numTouched++] = root;
+    engine->state[root] = DFS_GRAY;
+    engine->discovery[root] = engine->time++;
+    engine->parent[root] = -1;
+    engine->stackVertex[top] = root;
+    engine->stackCursor[top] = 0;
+    top++;
+    if (preVisit && !preVisit(root, -1, context)) return false;
+
+    while (top > 0) {
+        int v = engine->stackVertex[top - 1];
+        int w = view->nextNeighbor(view, v, &engine->stackCursor[top - 1]);
+
+        if (w < 0) {
+            // Todos los vecinos procesados: v termina
+            engine->state[v] = DFS_BLACK;
+            top--;
+            if (postVisit && !postVisit(v, engine->parent[v], context)) return false;
+            continue;
+        }
+        if (w >= engine->numVertices) continue;
+
+        // Blanco para el motor pero ya visto por el que llama
+        bool external = engine->state[w] == DFS_WHITE &&
+                        ((engine->onStack && engine->onStack[w]) || (engine->visited && engine->visited[w]));
+
+        if (engine->state[w] == DFS_WHITE && !external) {
+            if (onEdge && !onEdge(v, w, DFS_EDGE_TREE, context)) return false;
+
+            engine->touched[engine->numTouched++] = w;
+            engine->state[w] = DFS_GRAY;
+            engine->discovery[w] = engine->time++;
+            engine->parent[w] = v;
+            engine->stackVertex[top] = w;
+            engine->stackCursor[top] = 0;
+            top++;
+            if (preVisit && !preVisit(w, v, context)) return false;
+        } else if (onEdge && external) {
+            DFSEdgeType type = engine->onStack && engine->onStack[w] ? DFS_EDGE_BACK : DFS_EDGE_CROSS;
+            if (!onEdge(v, w, type, context)) return false;
+        } else if (onEdge) {
+            DFSEdgeType type = engine->state[w] == DFS_GRAY ? DFS_EDGE_BACK
+                             : engine->discovery[w] > engine->discovery[v] ? DFS_EDGE_FORWARD
+                             : DFS_EDGE_CROSS;
+            if (!onEdge(v, w, type, context)) return false;
+        }
+    }
+
+    return true;
+}
+
+bool dfsEngineRunAll(DFSEngine* engine, const DFSGraphView* view, const DFSVisitor* visitor) {
+    if (!engine || !view) return false;
+
+    dfsEngineReset(engine, view->numVertices);
+    for (int v = 0; v < engine->numVertices; v++) {
+        if (engine->state[v] == DFS_WHITE && !dfsEngineRun(engine, view, v, visitor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =================================================================
+// Orden topológico
+// =================================================================
+
+typedef struct {
+    int* order;
+    int position;    // Se llena de atrás hacia adelante
+} TopologicalContext;
+
+static bool topologicalPostVisit(int vertex, int parent, void* context) {
+    (void)parent;
+    TopologicalContext* ctx = (TopologicalContext*)context;
+    ctx->order[--ctx->position] = vertex;
+    return true;
+}
+
+// Un arco hacia atrás es un ciclo: no hay orden posible
+static bool topologicalEdge(int from, int to, DFSEdgeType type, void* context) {
+    (void)from;
+    (void)to;
+    (void)context;
+    return type != DFS_EDGE_BACK;
+}
+
+// Orden inverso de finalización; NULL y hasCycle = true si hay un ciclo
+int* topologicalSortDFS(const DFSGraphView* view, bool* hasCycle) {
+    if (hasCycle) *hasCycle = false;
+    if (!view || view->numVertices <= 0) return NULL;
+
+    int n = view->numVertices;
+    TopologicalContext ctx = {(int*)malloc(n * sizeof(int)), n};
+    DFSVisitor visitor = {NULL, topologicalPostVisit, topologicalEdge, &ctx};
+
+    DFSEngine* engine = createDFSEngine(n);
+    bool acyclic = dfsEngineRunAll(engine, view, &visitor);
+    destroyDFSEngine(engine);
+
+    if (!acyclic) {
+        if (hasCycle) *hasCycle = true;
+        free(ctx.order);
+        return NULL;
+    }
+    return ctx.order;
+}
+
+// =================================================================
+// Componentes fuertemente conexos (Tarjan)
+// =================================================================
+
+typedef struct {
+    DFSEngine* engine;
+    int* low;
+    int* stack;          // Pila de Tarjan (vértices de SCC sin cerrar)
+    bool* onStack;
+    int top;
+    int* component;
+    int numComponents;
+} TarjanContext;
+
+static bool tarjanPreVisit(int vertex, int parent, void* context) {
+    (void)parent;
+    TarjanContext* ctx = (TarjanContext*)context;
+    ctx->low[vertex] = ctx->engine->discovery[vertex];
+    ctx->stack[ctx->top++] = vertex;
+    ctx->onStack[vertex] = true;
+    return true;
+}
+
+// Arcos hacia vértices que siguen en la pila de Tarjan bajan el low
+static bool tarjanEdge(int from, int to, DFSEdgeType type, void* context) {
+    TarjanContext* ctx = (TarjanContext*)context;
+    if (type != DFS_EDGE_TREE && ctx->onStack[to] &&
+        ctx->engine->discovery[to] < ctx->low[from]) {
+        ctx->low[from] = ctx->engine->discovery[to];
+    }
+    return true;
+}
+
+// Al terminar: cerrar la SCC si vertex es su raíz y propagar el low al padre
+static bool tarjanPostVisit(int vertex, int parent, void* context) {
+    TarjanContext* ctx = (TarjanContext*)context;
+
+    if (ctx->low[vertex] == ctx->engine->discovery[vertex]) {
+        int w;
+        do {
+            w = ctx->stack[--ctx->top];
+            ctx->onStack[w] = false;
+            ctx->component[w] = ctx->numComponents;
+        } while (w != vertex);
+        ctx->numComponents++;
+    }
+
+    if (parent >= 0 && ctx->low[vertex] < ctx->low[parent]) {
+        ctx->low[parent] = ctx->low[vertex];
+    }
+    return true;
+}
+
+// component[v] = SCC de v; las SCC se numeran en el orden en que se cierran
+// (orden topológico inverso del grafo de componentes)
+int* stronglyConnectedComponents(const DFSGraphView* view, int* numComponents) {
+    if (numComponents) *numComponents = 0;
+    if (!view || view->numVertices <= 0) return NULL;
+
+    int n = view->numVertices;
+    TarjanContext ctx;
+    ctx.engine = createDFSEngine(n);
+    ctx.low = (int*)malloc(n * sizeof(int));
+    ctx.stack = (int*)malloc(n * sizeof(int));
+    ctx.onStack = (bool*)calloc(n, sizeof(bool));
+    ctx.top = 0;
+    ctx.component = (int*)malloc(n * sizeof(int));
+    ctx.numComponents = 0;
+
+    DFSVisitor visitor = {tarjanPreVisit, tarjanPostVisit, tarjanEdge, &ctx};
+    dfsEngineRunAll(ctx.engine, view, &visitor);
+
+    if (numComponents) *numComponents = ctx.numComponents;
+
+    destroyDFSEngine(ctx.engine);
+    free(ctx.low);
+    free(ctx.stack);
+    free(ctx.onStack);
+    return ctx.component;
+}
@@ -0,0 +1,97 @@
+//
+// Created by administrador on 6/27/25.
+//
+
+#ifndef DFS_ENGINE_H
+#define DFS_ENGINE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../graph/graph.h"
+#include "../graph/csr_graph.h"
+
+// Estado de cada vértice durante el recorrido
+#define DFS_WHITE 0   // Sin descubrir
+#define DFS_GRAY 1    // En la pila (descubierto, sin terminar)
+#define DFS_BLACK 2   // Terminado
+
+typedef enum {
+    DFS_EDGE_TREE,      // Lleva a un vértice nuevo
+    DFS_EDGE_BACK,      // Hacia un ancestro en la pila (ciclo en dirigidos)
+    DFS_EDGE_FORWARD,   // Hacia un descendiente ya terminado
+    DFS_EDGE_CROSS      // Hacia otra rama o un recorrido anterior
+} DFSEdgeType;
+
+// Acceso a los vecinos de cualquier representación: nextNeighbor devuelve
+// el próximo vecino de vertex a partir de *cursor (y lo avanza) o -1 al
+// terminar. El motor arranca cada cursor en 0.
+typedef struct DFSGraphView {
+    int numVertices;
+    const void* data;
+    int (*nextNeighbor)(const struct DFSGraphView* view, int vertex, intptr_t* cursor);
+} DFSGraphView;
+
+DFSGraphView dfsViewFromMatrix(int** matrix, int numVertices);
+DFSGraphView dfsViewFromCSR(const CSRGraph* graph);
+DFSGraphView dfsViewFromGraph(Graph* graph);
+
+// Callbacks opcionales (NULL = no se llama). Si alguno devuelve false el
+// recorrido se corta y dfsEngineRun devuelve false.
+typedef struct {
+    bool (*preVisit)(int vertex, int parent, void* context);
+    bool (*postVisit)(int vertex, int parent, void* context);
+    bool (*edge)(int from, int to, DFSEdgeType type, void* context);
+    void* context;
+} DFSVisitor;
+
+// Motor de DFS con pila explícita: la profundidad solo está limitada por
+// la memoria. Se crea una vez y se reutiliza entre recorridos: reiniciar
+// cuesta lo que tocó el recorrido anterior, no O(V), y la capacidad crece
+// sola si llega un grafo más grande.
+typedef struct {
+    int capacity;
+    int numVertices;
+    unsigned char* state;   // DFS_WHITE / DFS_GRAY / DFS_BLACK
+    int* discovery;         // Orden de descubrimiento
+    int* parent;            // Padre en el árbol DFS (-1 = raíz)
+    int* stackVertex;
+    intptr_t* stackCursor;
+    int* touched;           // Vértices descubiertos desde el último reinicio
+    int numTouched;
+    int time;
+    // Arreglos del que llama que se consultan sin copiarlos (NULL = no hay):
+    // un vértice blanco con visited[v] ya está terminado y uno con
+    // onStack[v] es un ancestro de un recorrido anterior
+    const bool* visited;
+    const bool* onStack;
+} DFSEngine;
+
+DFSEngine* createDFSEngine(int capacity);
+void destroyDFSEngine(DFSEngine* engine);
+
+// Motor propio del hilo para las funciones que no reciben uno. Se reinicia
+// en cada uso, así que no sirve dentro de los callbacks de otro recorrido
+DFSEngine* dfsThreadEngine(int numVertices);
+
+// Dejar todos los vértices en blanco para un grafo de numVertices vértices
+void dfsEngineReset(DFSEngine* engine, int numVertices);
+
+// Reiniciar tomando como terminados los vértices con visited[v] = true
+// (para continuar un recorrido hecho con arreglos del que llama). El
+// arreglo se consulta durante el recorrido, no se copia
+void dfsEngineResetVisited(DFSEngine* engine, int numVertices, const bool* visited);
+
+// Recorrer desde root sin reiniciar: los vértices ya visitados en
+// recorridos anteriores no se vuelven a visitar (sus aristas son cruzadas)
+bool dfsEngineRun(DFSEngine* engine, const DFSGraphView* view, int root, const DFSVisitor* visitor);
+
+// Reiniciar y recorrer desde cada vértice en blanco, en orden de índice
+bool dfsEngineRunAll(DFSEngine* engine, const DFSGraphView* view, const DFSVisitor* visitor);
+
+// Algoritmos sobre el motor
+int* topologicalSortDFS(const DFSGraphView* view, bool* hasCycle);
+int* stronglyConnectedComponents(const DFSGraphView* view, int* numComponents);
+
+#endif //DFS_ENGINE_H
@@ -3,6 +3,8 @@
 //
 
 #include "dijkstra.h"
+#include "../estructura_datos/priority_queue.h"
+#include "../estructura_datos/radix_heap.h"
 
 // Funciones para encontrar el vertice con distancia minima no visitado
 int findMinDistance(int * dist, bool * visited,int numVertices) {
@@ -17,37 +19,140 @@ int findMinDistance(int * dist, bool * visited,int numVertices) {
     return minIndex;
 }
 
-// Para el camino mas corto entre dos vertices especificos
-PathResult * dijkstra(int ** graph, int numVertices, int inicio, int fin) {
+// =================================================================
+// Frontera de búsqueda: abstrae la estructura que elige el próximo vértice
+// =================================================================
+
+typedef struct {
+    DijkstraQueueType type;
+    IndexedPriorityQueue* heap;
+    RadixHeap* radix;
+    int* dist;
+    bool* visited;
+    int numVertices;
+} DijkstraFrontier;
+
+static void frontierInit(DijkstraFrontier* f, DijkstraQueueType type, int* dist, bool* visited, int numVertices) {
+    f->type = type;
+    f->heap = NULL;
+    f->radix = NULL;
+    f->dist = dist;
+    f->visited = visited;
+    f->numVertices = numVertices;
+
+    if (type == DIJKSTRA_BINARY_HEAP) {
+        f->heap = createIndexedPriorityQueueDary(numVertices, 2);
+    } else if (type == DIJKSTRA_DARY_HEAP) {
+        f->heap = createIndexedPriorityQueueDary(numVertices, IPQ_DEFAULT_ARITY);
+    } else if (type == DIJKSTRA_RADIX_HEAP) {
+        f->radix = createRadixHeap(64);
+    }
+}
+
+static void frontierFree(DijkstraFrontier* f) {
+    if (f->heap) destroyIndexedPriorityQueue(f->heap);
+    if (f->radix) destroyRadixHeap(f->radix);
+}
+
+// Registrar que dist[v] bajó a newDist
+static void frontierRelax(DijkstraFrontier* f, int v, int newDist) {
+    switch (f->type) {
+        case DIJKSTRA_BINARY_HEAP:
+        case DIJKSTRA_DARY_HEAP:
+            if (ipqContains(f->heap, v)) {
+                ipqDecreaseKey(f->heap, v, newDist);
+            } else {
+                ipqPush(f->heap, v, newDist);
+            }
+            break;
+        case DIJKSTRA_RADIX_HEAP:
+            // Sin decrease-key: la entrada vieja queda y se descarta al extraerla
+            radixHeapPush(f->radix, v, (unsigned int)newDist);
+            break;
+        case DIJKSTRA_LINEAR_SCAN:
+            break; // El escaneo lee dist[] directamente
+    }
+}
+
+// Próximo vértice alcanzable no visitado con distancia mínima (-1 si no hay)
+static int frontierPopMin(DijkstraFrontier* f) {
+    switch (f->type) {
+        case DIJKSTRA_BINARY_HEAP:
+        case DIJKSTRA_DARY_HEAP:
+            return ipqPop(f->heap);
+        case DIJKSTRA_RADIX_HEAP:
+            while (!radixHeapIsEmpty(f->radix)) {
+                unsigned int key;
+                int v = radixHeapPop(f->radix, &key);
+                if (!f->visited[v] && key == (unsigned int)f->dist[v]) return v;
+            }
+            return -1;
+        case DIJKSTRA_LINEAR_SCAN: {
+            int u = findMinDistance(f->dist, f->visited, f->numVertices);
+            return (u != -1 && f->dist[u] != INF) ? u : -1;
+        }
+    }
+    return -1;
+}
+
+// Armar el camino start -> end a partir del arreglo de padres
+static void buildPathResult(PathResult* result, int* dist, int* parent, int end) {
+    if (dist[end] == INF) return;
+
+    result->hasPath = true;
+    result->totalWeight = dist[end];
+
+    // Contar la longitud del camino
+    int temp = end;
+    int pathLen = 0;
+    while (temp != -1) {
+        pathLen++;
+        temp = parent[temp];
+    }
+
+    // Crear el array del camino
+    result->path = (int*)malloc(pathLen * sizeof(int));
+    result->pathLength = pathLen;
+
+    temp = end;
+    for (int i = pathLen - 1; i >= 0; i--) {
+        result->path[i] = temp;
+        temp = parent[temp];
+    }
+}
+
+static PathResult* createEmptyPathResult() {
     PathResult * result = (PathResult*)malloc(sizeof(PathResult));
     result->path = NULL;
     result->pathLength = 0 ;
     result->totalWeight = INF;
     result->hasPath = false;
+    return result;
+}
 
-    // Si entra en la validacion termina el codigo
-    if(inicio < 0 || inicio >= numVertices || fin < 0 || fin >= numVertices) {
-        return  result;
-    }
+// =================================================================
+// Búsqueda sobre matriz de adyacencia
+// =================================================================
 
-    int * dist = (int*)malloc(numVertices * sizeof(int));
+// Llena dist/parent desde inicio. Si fin >= 0 se detiene al fijarlo.
+static void dijkstraMatrixSearch(int** graph, int numVertices, int inicio, int fin,
+                                 int* dist, int* parent, DijkstraQueueType queueType) {
     bool * visited = (bool*)calloc(numVertices,sizeof(bool));
-    int * parent = (int*)malloc(numVertices * sizeof(int));
 
     // Inicializar distancias y padres
     for(int i = 0 ; i < numVertices; i++) {
         dist[i] = INF;
-        parent[i] = -1;
+        if (parent) parent[i] = -1;
     }
     dist[inicio] = 0;
 
+    DijkstraFrontier frontier;
+    frontierInit(&frontier, queueType, dist, visited, numVertices);
+    frontierRelax(&frontier, inicio, 0);
 
     // Algoritmo principal de Dijkstra
-    for (int count = 0; count < numVertices - 1; count++) {
-        int u = findMinDistance(dist, visited, numVertices);
-
-        if (u == -1) break; // No hay más vértices alcanzables
-
+    int u;
+    while ((u = frontierPopMin(&frontier)) != -1) {
         visited[u] = true;
 
         // Si llegamos al destino, podemos parar
@@ -55,40 +160,40 @@ PathResult * dijkstra(int ** graph, int numVertices, int inicio, int fin) {
 
         // Actualizar distancias de vértices adyacentes
         for (int v = 0; v < numVertices; v++) {
-            if (!visited[v] && graph[u][v] != 0 &&
-                dist[u] != INF && dist[u] + graph[u][v] < dist[v]) {
+            if (!visited[v] && graph[u][v] != 0 && dist[u] + graph[u][v] < dist[v]) {
                 dist[v] = dist[u] + graph[u][v];
-                parent[v] = u;
+                if (parent) parent[v] = u;
+                frontierRelax(&frontier, v, dist[v]);
             }
         }
     }
 
-    // Construir el camino si existe
-    if (dist[fin] != INF) {
-        result->hasPath = true;
-        result->totalWeight = dist[fin];
-
-        // Contar la longitud del camino
-        int temp = fin;
-        int pathLen = 0;
-        while (temp != -1) {
-            pathLen++;
-            temp = parent[temp];
-        }
+    frontierFree(&frontier);
+    free(visited);
+}
 
-        // Crear el array del camino
-        result->path = (int*)malloc(pathLen * sizeof(int));
-        result->pathLength = pathLen;
+// Para el camino mas corto entre dos vertices especificos
+PathResult * dijkstra(int ** graph, int numVertices, int inicio, int fin) {
+    return dijkstraWithQueue(graph, numVertices, inicio, fin, DIJKSTRA_DARY_HEAP);
+}
 
-        temp = fin;
-        for (int i = pathLen - 1; i >= 0; i--) {
-            result->path[i] = temp;
-            temp = parent[temp];
-        }
+PathResult* dijkstraWithQueue(int** graph, int numVertices, int inicio, int fin, DijkstraQueueType queueType) {
+    PathResult * result = createEmptyPathResult();
+
+    // Si entra en la validacion termina el codigo
+    if(inicio < 0 || inicio >= numVertices || fin < 0 || fin >= numVertices) {
+        return  result;
     }
 
+    int * dist = (int*)malloc(numVertices * sizeof(int));
+    int * parent = (int*)malloc(numVertices * sizeof(int));
+
+    dijkstraMatrixSearch(graph, numVertices, inicio, fin, dist, parent, queueType);
+
+    // Construir el camino si existe
+    buildPathResult(result, dist, parent, fin);
+
     free(dist);
-    free(visited);
     free(parent);
 
     return result;
@@ -96,31 +201,14 @@ PathResult * dijkstra(int ** graph, int numVertices, int inicio, int fin) {
 
 // Dijkstra para todos los caminos desde un vértice
 int* dijkstraAllPaths(int** graph, int numVertices, int start) {
-    int* dist = (int*)malloc(numVertices * sizeof(int));
-    bool* visited = (bool*)calloc(numVertices, sizeof(bool));
-
-    // Inicializar distancias
-    for (int i = 0; i < numVertices; i++) {
-        dist[i] = INF;
-    }
-    dist[start] = 0;
-
-    for (int count = 0; count < numVertices - 1; count++) {
-        int u = findMinDistance(dist, visited, numVertices);
-
-        if (u == -1) break;
-
-        visited[u] = true;
+    return dijkstraAllPathsWithQueue(graph, numVertices, start, DIJKSTRA_DARY_HEAP);
+}
 
-        for (int v = 0; v < numVertices; v++) {
-            if (!visited[v] && graph[u][v] != 0 &&
-                dist[u] != INF && dist[u] + graph[u][v] < dist[v]) {
-                dist[v] = dist[u] + graph[u][v];
-            }
-        }
-    }
+int* dijkstraAllPathsWithQueue(int** graph, int numVertices, int start, DijkstraQueueType queueType) {
+    if (start < 0 || start >= numVertices) return NULL;
 
-    free(visited);
+    int* dist = (int*)malloc(numVertices * sizeof(int));
+    dijkstraMatrixSearch(graph, numVertices, start, -1, dist, NULL, queueType);
     return dist;
 }
 
@@ -151,5 +239,79 @@ void freePathResult(PathResult* result) {
     }
 }
 
+// =================================================================
+// Búsqueda sobre grafo CSR
+// =================================================================
+
+static void dijkstraCSRSearch(const CSRGraph* graph, int start, int end,
+                              int* dist, int* parent, DijkstraQueueType queueType) {
+    int n = graph->numVertices;
+    bool* visited = (bool*)calloc(n, sizeof(bool));
 
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+        if (parent) parent[i] = -1;
+    }
+    dist[start] = 0;
+
+    DijkstraFrontier frontier;
+    frontierInit(&frontier, queueType, dist, visited, n);
+    frontierRelax(&frontier, start, 0);
+
+    int u;
+    while ((u = frontierPopMin(&frontier)) != -1) {
+        visited[u] = true;
 
+        if (u == end) break;
+
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            int newDist = dist[u] + graph->weights[e];
+            if (!visited[v] && newDist < dist[v]) {
+                dist[v] = newDist;
+                if (parent) parent[v] = u;
+                frontierRelax(&frontier, v, newDist);
+            }
+        }
+    }
+
+    frontierFree(&frontier);
+    free(visited);
+}
+
+// Camino más corto entre dos vértices sobre un grafo CSR
+PathResult* dijkstraCSR(const CSRGraph* graph, int start, int end) {
+    return dijkstraCSRWithQueue(graph, start, end, DIJKSTRA_DARY_HEAP);
+}
+
+PathResult* dijkstraCSRWithQueue(const CSRGraph* graph, int start, int end, DijkstraQueueType queueType) {
+    PathResult* result = createEmptyPathResult();
+
+    if (!graph || start < 0 || start >= graph->numVertices ||
+        end < 0 || end >= graph->numVertices) {
+        return result;
+    }
+
+    int* dist = (int*)malloc(graph->numVertices * sizeof(int));
+    int* parent = (int*)malloc(graph->numVertices * sizeof(int));
+
+    dijkstraCSRSearch(graph, start, end, dist, parent, queueType);
+    buildPathResult(result, dist, parent, end);
+
+    free(dist);
+    free(parent);
+    return result;
+}
+
+// Distancias desde start a todos los vértices sobre un grafo CSR
+int* dijkstraAllPathsCSR(const CSRGraph* graph, int start) {
+    return dijkstraAllPathsCSRWithQueue(graph, start, DIJKSTRA_DARY_HEAP);
+}
+
+int* dijkstraAllPathsCSRWithQueue(const CSRGraph* graph, int start, DijkstraQueueType queueType) {
+    if (!graph || start < 0 || start >= graph->numVertices) return NULL;
+
+    int* dist = (int*)malloc(graph->numVertices * sizeof(int));
+    dijkstraCSRSearch(graph, start, -1, dist, NULL, queueType);
+    return dist;
+}
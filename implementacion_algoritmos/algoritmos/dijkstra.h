@@ -10,15 +10,35 @@
 #include <stdbool.h>
 #include <limits.h>
 #include "common_types.h"
+#include "../graph/csr_graph.h"
 
 #define INF INT_MAX
 
-// Prototipos de funciones
+// Estructura usada para elegir el próximo vértice a fijar
+typedef enum {
+    DIJKSTRA_LINEAR_SCAN,   // findMinDistance: O(V) por iteración, bueno en grafos densos
+    DIJKSTRA_BINARY_HEAP,   // heap indexado con decrease-key: O((V + E) log V)
+    DIJKSTRA_RADIX_HEAP,    // radix heap monótono, solo pesos enteros no negativos
+    DIJKSTRA_DARY_HEAP      // heap indexado 4-ario: mismo orden, menos fallos de caché
+} DijkstraQueueType;
+
+// Prototipos de funciones (usan DIJKSTRA_DARY_HEAP)
 PathResult* dijkstra(int** graph, int numVertices, int start, int end);
 int* dijkstraAllPaths(int** graph, int numVertices, int start);
+
+// Variantes con estructura de cola seleccionable por llamada
+PathResult* dijkstraWithQueue(int** graph, int numVertices, int start, int end, DijkstraQueueType queueType);
+int* dijkstraAllPathsWithQueue(int** graph, int numVertices, int start, DijkstraQueueType queueType);
+
 void printDijkstraResult(PathResult* result, int start, int end);
 void freePathResult(PathResult* result);
 
+// Versiones sobre grafo CSR (trabajo proporcional a E en lugar de V²)
+PathResult* dijkstraCSR(const CSRGraph* graph, int start, int end);
+int* dijkstraAllPathsCSR(const CSRGraph* graph, int start);
+PathResult* dijkstraCSRWithQueue(const CSRGraph* graph, int start, int end, DijkstraQueueType queueType);
+int* dijkstraAllPathsCSRWithQueue(const CSRGraph* graph, int start, DijkstraQueueType queueType);
+
 // Función auxiliar
 int findMinDistance(int* dist, bool* visited, int numVertices);
 
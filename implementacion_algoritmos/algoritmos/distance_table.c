@@ -0,0 +1,155 @@
+//
+// Created by administrador on 6/23/25.
+//
+
+#include "distance_table.h"
+#include <limits.h>
+#include "../estructura_datos/priority_queue.h"
+#include "../utils/parallel_utils.h"
+
+#define INF INT_MAX
+
+// Memoria de trabajo de un hilo: dist vale INF salvo en los vértices tocados
+typedef struct {
+    int* dist;
+    int* touched;
+    int numTouched;
+    IndexedPriorityQueue* queue;
+} TableScratch;
+
+typedef struct {
+    const CSRGraph* graph;
+    const int* sources;
+    const int* targets;
+    int numTargets;
+    const bool* isTarget;      // Vértices que son destino (sin repetir)
+    int numDistinctTargets;
+    TableScratch* scratch;     // Uno por hilo
+    int* table;
+} TableJob;
+
+// Fila i de la tabla: Dijkstra desde sources[i] hasta fijar todos los destinos
+static void computeTableRow(int row, int threadIndex, void* context) {
+    TableJob* job = (TableJob*)context;
+    const CSRGraph* g = job->graph;
+    TableScratch* s = &job->scratch[threadIndex];
+    int* out = job->table + (long)row * job->numTargets;
+    int source = job->sources[row];
+
+    for (int j = 0; j < job->numTargets; j++) out[j] = INF;
+    if (source < 0 || source >= g->numVertices) return;
+
+    for (int i = 0; i < s->numTouched; i++) s->dist[s->touched[i]] = INF;
+    s->numTouched = 0;
+    ipqClear(s->queue);
+
+    s->dist[source] = 0;
+    s->touched[s->numTouched++] = source;
+    ipqPush(s->queue, source, 0);
+
+    int remaining = job->numDistinctTargets;
+    while (remaining > 0 && !ipqIsEmpty(s->queue)) {
+        int du;
+        int u = ipqPopWithPriority(s->queue, &du);
+        if (job->isTarget[u]) remaining--;
+
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int v = g->targets[e];
+            int newDist = du + g->weights[e];
+            if (newDist >= s->dist[v]) continue;
+
+            if (s->dist[v] == INF) s->touched[s->numTouched++] = v;
+            s->dist[v] = newDist;
+            if (ipqContains(s->queue, v)) {
+                ipqDecreaseKey(s->queue, v, newDist);
+            } else {
+                ipqPush(s->queue, v, newDist);
+            }
+        }
+    }
+
+    for (int j = 0; j < job->numTargets; j++) {
+        int t = job->targets[j];
+        if (t >= 0 && t < g->numVertices) out[j] = s->dist[t];
+    }
+}
+
+int* distanceTable(const CSRGraph* graph, const int* sources, int numSources,
+                   const int* targets, int numTargets, int numThreads) {
+    if (!graph || numSources < 0 || numTargets < 0 ||
+        (numSources > 0 && !sources) || (numTargets > 0 && !targets)) {
+        return NULL;
+    }
+
+    int n = graph->numVertices;
+    int* table = (int*)malloc(((long)numSources * numTargets > 0 ? (long)numSources * numTargets : 1) * sizeof(int));
+    if (numSources == 0 || numTargets == 0) return table;
+
+    bool* isTarget = (bool*)calloc(n > 0 ? n : 1, sizeof(bool));
+    int numDistinct = 0;
+    for (int j = 0; j < numTargets; j++) {
+        int t = targets[j];
+        if (t >= 0 && t < n && !isTarget[t]) {
+            isTarget[t] = true;
+            numDistinct++;
+        }
+    }
+
+    numThreads = resolveThreadCount(numThreads);
+    if (numThreads > numSources) numThreads = numSources;
+
+    TableJob job;
+    job.graph = graph;
+    job.sources = sources;
+    job.targets = targets;
+    job.numTargets = numTargets;
+    job.isTarget = isTarget;
+    job.numDistinctTargets = numDistinct;
+    job.table = table;
+    job.scratch = (TableScratch*)malloc(numThreads * sizeof(TableScratch));
+
+    for (int t = 0; t < numThreads; t++) {
+        TableScratch* s = &job.scratch[t];
+        s->dist = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        s->touched = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        s->numTouched = 0;
+        s->queue = createIndexedPriorityQueue(n);
+        for (int i = 0; i < n; i++) s->dist[i] = INF;
+    }
+
+    parallelFor(numSources, numThreads, computeTableRow, &job);
+
+    for (int t = 0; t < numThreads; t++) {
+        free(job.scratch[t].dist);
+        free(job.scratch[t].touched);
+        destroyIndexedPriorityQueue(job.scratch[t].queue);
+    }
+    free(job.scratch);
+    free(isTarget);
+
+    return table;
+}
+
+void printDistanceTable(const int* table, const int* sources, int numSources,
+                        const int* targets, int numTargets) {
+    if (!table) {
+        printf("❌ Tabla de distancias nula\n");
+        return;
+    }
+
+    printf("\n📋 === TABLA DE DISTANCIAS (%d x %d) ===\n", numSources, numTargets);
+    printf("%8s", "");
+    for (int j = 0; j < numTargets; j++) printf("%8d", targets[j]);
+    printf("\n");
+
+    for (int i = 0; i < numSources; i++) {
+        printf("%8d", sources[i]);
+        for (int j = 0; j < numTargets; j++) {
+            int d = table[(long)i * numTargets + j];
+            if (d == INF) printf("%8s", "∞");
+            else printf("%8d", d);
+        }
+        printf("\n");
+    }
+    printf("==========================================\n");
+}
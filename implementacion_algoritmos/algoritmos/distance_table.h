@@ -0,0 +1,26 @@
+//
+// Created by administrador on 6/23/25.
+//
+
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "common_types.h"
+#include "../graph/csr_graph.h"
+
+// Matriz de distancias numSources x numTargets en orden por filas:
+// table[i * numTargets + j] = distancia de sources[i] a targets[j]
+// (INF si no hay camino o el id es inválido). Se corre un Dijkstra por
+// origen que termina al fijar todos los destinos; los orígenes se reparten
+// entre numThreads hilos (<= 0 = todos los núcleos) y cada hilo reutiliza
+// su memoria de trabajo entre búsquedas.
+int* distanceTable(const CSRGraph* graph, const int* sources, int numSources,
+                   const int* targets, int numTargets, int numThreads);
+
+void printDistanceTable(const int* table, const int* sources, int numSources,
+                        const int* targets, int numTargets);
+
+#endif //DISTANCE_TABLE_H
@@ -78,4 +78,172 @@ void freeMST(MST* mst) {
         }
         free(mst);
     }
-}
\ No newline at end of file
+}
+// Kruskal sobre grafo CSR: se extraen solo los E arcos existentes.
+// Igual que la versión matricial, cada arista no dirigida se toma una vez (u < v).
+MST* kruskalMSTCSR(const CSRGraph* graph) {
+    if (!graph) return NULL;
+
+    int n = graph->numVertices;
+    MST* mst = (MST*)malloc(sizeof(MST));
+    mst->edges = (Edge*)malloc((n > 1 ? n - 1 : 1) * sizeof(Edge));
+    mst->edgeCount = 0;
+    mst->totalWeight = 0;
+
+    if (n == 0) return mst;
+
+    Edge* allEdges = (Edge*)malloc((graph->numEdges > 0 ? graph->numEdges : 1) * sizeof(Edge));
+    int edgeCount = 0;
+
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            if (u < v) {
+                allEdges[edgeCount].src = u;
+                allEdges[edgeCount].dest = v;
+                allEdges[edgeCount].weight = graph->weights[e];
+                edgeCount++;
+            }
+        }
+    }
+
+    qsort(allEdges, edgeCount, sizeof(Edge), compareEdges);
+
+    UnionFind* uf = createUnionFind(n);
+
+    for (int i = 0; i < edgeCount && mst->edgeCount < n - 1; i++) {
+        Edge currentEdge = allEdges[i];
+
+        if (find(uf, currentEdge.src) != find(uf, currentEdge.dest)) {
+            mst->edges[mst->edgeCount] = currentEdge;
+            mst->totalWeight += currentEdge.weight;
+            mst->edgeCount++;
+            unionByRank(uf, currentEdge.src, currentEdge.dest);
+        }
+    }
+
+    free(allEdges);
+    destroyUnionFind(uf);
+
+    return mst;
+}
+
+// =================================================================
+// Filter-Kruskal
+// =================================================================
+
+#define FILTER_KRUSKAL_THRESHOLD 1024   // Por debajo se ordena directamente
+
+Edge* csrUndirectedEdges(const CSRGraph* graph, int* numEdges) {
+    *numEdges = 0;
+    if (!graph) return NULL;
+
+    Edge* edges = (Edge*)malloc((graph->numEdges > 0 ? graph->numEdges : 1) * sizeof(Edge));
+    for (int u = 0; u < graph->numVertices; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            if (u < v) {
+                edges[*numEdges].src = u;
+                edges[*numEdges].dest = v;
+                edges[*numEdges].weight = graph->weights[e];
+                (*numEdges)++;
+            }
+        }
+    }
+    return edges;
+}
+
+// Kruskal clásico sobre un tramo ya ordenado (o de pesos iguales)
+static void kruskalScan(MST* mst, UnionFind* uf, const Edge* edges, int count, int numVertices) {
+    for (int i = 0; i < count && mst->edgeCount < numVertices - 1; i++) {
+        if (unionByRank(uf, edges[i].src, edges[i].dest)) {
+            mst->edges[mst->edgeCount++] = edges[i];
+            mst->totalWeight += edges[i].weight;
+        }
+    }
+}
+
+static void filterKruskalRecursive(MST* mst, UnionFind* uf, Edge* edges, int count, int numVertices) {
+    if (count == 0 || mst->edgeCount >= numVertices - 1) return;
+
+    if (count <= FILTER_KRUSKAL_THRESHOLD) {
+        qsort(edges, count, sizeof(Edge), compareEdges);
+        kruskalScan(mst, uf, edges, count, numVertices);
+        return;
+    }
+
+    // Pivote: mediana de tres pesos al azar
+    int a = edges[rand() % count].weight;
+    int b = edges[rand() % count].weight;
+    int c = edges[rand() % count].weight;
+    int pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+    // Partición en tres: [0, lt) < pivote, [lt, gt) == pivote, [gt, count) > pivote
+    int lt = 0, i = 0, gt = count;
+    while (i < gt) {
+        Edge current = edges[i];
+        if (current.weight < pivot) {
+            edges[i++] = edges[lt];
+            edges[lt++] = current;
+        } else if (current.weight > pivot) {
+            edges[i] = edges[--gt];
+            edges[gt] = current;
+        } else {
+            i++;
+        }
+    }
+
+    filterKruskalRecursive(mst, uf, edges, lt, numVertices);
+    kruskalScan(mst, uf, edges + lt, gt - lt, numVertices);
+    if (mst->edgeCount >= numVertices - 1) return;
+
+    // Filtro: las pesadas cuyos extremos ya están conectados no pueden entrar
+    Edge* heavy = edges + gt;
+    int kept = 0;
+    for (int j = 0; j < count - gt; j++) {
+        if (find(uf, heavy[j].src) != find(uf, heavy[j].dest)) {
+            heavy[kept++] = heavy[j];
+        }
+    }
+
+    filterKruskalRecursive(mst, uf, heavy, kept, numVertices);
+}
+
+MST* filterKruskalMST(int numVertices, const Edge* edges, int numEdges) {
+    if (numVertices < 0 || (numEdges > 0 && !edges)) return NULL;
+
+    MST* mst = (MST*)malloc(sizeof(MST));
+    mst->edges = (Edge*)malloc((numVertices > 1 ? numVertices - 1 : 1) * sizeof(Edge));
+    mst->edgeCount = 0;
+    mst->totalWeight = 0;
+
+    if (numVertices == 0) return mst;
+
+    // La partición trabaja en el lugar: se ordena una copia
+    Edge* work = (Edge*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(Edge));
+    int count = 0;
+    for (int i = 0; i < numEdges; i++) {
+        if (edges[i].src < 0 || edges[i].src >= numVertices ||
+            edges[i].dest < 0 || edges[i].dest >= numVertices) {
+            continue;
+        }
+        work[count++] = edges[i];
+    }
+
+    UnionFind* uf = createUnionFind(numVertices);
+    filterKruskalRecursive(mst, uf, work, count, numVertices);
+
+    free(work);
+    destroyUnionFind(uf);
+    return mst;
+}
+
+MST* filterKruskalMSTCSR(const CSRGraph* graph) {
+    if (!graph) return NULL;
+
+    int numEdges;
+    Edge* edges = csrUndirectedEdges(graph, &numEdges);
+    MST* mst = filterKruskalMST(graph->numVertices, edges, numEdges);
+    free(edges);
+    return mst;
+}
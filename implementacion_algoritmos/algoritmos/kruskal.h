@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include "common_types.h"
 #include "../estructura_datos/union_find.h"
+#include "../graph/csr_graph.h"
 
 // Estructura para Árbol de Expansión Mínima
 typedef struct {
@@ -16,6 +17,16 @@ typedef struct {
 
 // Prototipos de funciones principales
 MST* kruskalMST(int** graph, int numVertices);
+MST* kruskalMSTCSR(const CSRGraph* graph);
+
+// Filter-Kruskal sobre lista de aristas: particiona alrededor de un pivote,
+// resuelve primero las livianas y descarta de las pesadas las que ya
+// quedaron dentro de un componente antes de ordenarlas
+MST* filterKruskalMST(int numVertices, const Edge* edges, int numEdges);
+MST* filterKruskalMSTCSR(const CSRGraph* graph);
+
+// Aristas no dirigidas de un CSR (u < v); devuelve la cantidad en numEdges
+Edge* csrUndirectedEdges(const CSRGraph* graph, int* numEdges);
 void printMST(MST* mst);
 void freeMST(MST* mst);
 
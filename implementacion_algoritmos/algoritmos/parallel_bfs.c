@@ -0,0 +1,225 @@
+//
+// Created by administrador on 6/26/25.
+//
+
+#include "parallel_bfs.h"
+#include <string.h>
+#include <stdatomic.h>
+#include "../utils/parallel_utils.h"
+
+#define BFS_CHUNK 4096   // Vértices por tarea; múltiplo de 64 para que cada tarea tenga palabras propias
+
+typedef struct {
+    const CSRGraph* graph;
+    BFSWorkspace* ws;
+    int* distances;
+    int* parent;
+    int numVertices;         // Del grafo (el workspace puede ser más grande)
+    int level;               // Nivel de la frontera actual
+} BFSLevelJob;
+
+static void bfsListPush(BFSList* list, int value) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 256;
+        list->data = (int*)realloc(list->data, list->capacity * sizeof(int));
+    }
+    list->data[list->size++] = value;
+}
+
+static bool testBit(const uint64_t* bits, int v) {
+    return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+BFSWorkspace* createBFSWorkspace(int numVertices, int numThreads) {
+    if (numVertices <= 0) return NULL;
+
+    BFSWorkspace* ws = (BFSWorkspace*)malloc(sizeof(BFSWorkspace));
+    ws->numVertices = numVertices;
+    ws->numWords = (numVertices + 63) / 64;
+    ws->numThreads = resolveThreadCount(numThreads);
+    ws->visited = (uint64_t*)malloc(ws->numWords * sizeof(uint64_t));
+    ws->frontierBits = (uint64_t*)malloc(ws->numWords * sizeof(uint64_t));
+    ws->nextBits = (uint64_t*)malloc(ws->numWords * sizeof(uint64_t));
+    ws->frontier = (BFSList){NULL, 0, 0};
+    ws->threadNext = (BFSList*)calloc(ws->numThreads, sizeof(BFSList));
+    ws->threadCounts = (long*)malloc(ws->numThreads * sizeof(long));
+    ws->threadEdges = (long*)malloc(ws->numThreads * sizeof(long));
+    return ws;
+}
+
+void destroyBFSWorkspace(BFSWorkspace* ws) {
+    if (!ws) return;
+    for (int t = 0; t < ws->numThreads; t++) {
+        free(ws->threadNext[t].data);
+    }
+    free(ws->threadNext);
+    free(ws->threadCounts);
+    free(ws->threadEdges);
+    free(ws->frontier.data);
+    free(ws->visited);
+    free(ws->frontierBits);
+    free(ws->nextBits);
+    free(ws);
+}
+
+// Top-down: cada hilo expande un tramo de la frontera y se queda con los
+// vecinos cuyo bit de visitado logra encender
+static void bfsTopDownChunk(int task, int threadIndex, void* context) {
+    BFSLevelJob* job = (BFSLevelJob*)context;
+    const CSRGraph* g = job->graph;
+    BFSWorkspace* ws = job->ws;
+    BFSList* next = &ws->threadNext[threadIndex];
+    _Atomic uint64_t* visited = (_Atomic uint64_t*)ws->visited;
+
+    int begin = task * BFS_CHUNK;
+    int end = begin + BFS_CHUNK < ws->frontier.size ? begin + BFS_CHUNK : ws->frontier.size;
+
+    for (int i = begin; i < end; i++) {
+        int u = ws->frontier.data[i];
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int v = g->targets[e];
+            uint64_t mask = 1ULL << (v & 63);
+            if (atomic_load_explicit(&visited[v >> 6], memory_order_relaxed) & mask) continue;
+            if (atomic_fetch_or_explicit(&visited[v >> 6], mask, memory_order_relaxed) & mask) continue;
+
+            job->distances[v] = job->level + 1;
+            if (job->parent) job->parent[v] = u;
+            bfsListPush(next, v);
+            ws->threadEdges[threadIndex] += g->offsets[v + 1] - g->offsets[v];
+        }
+    }
+}
+
+// Bottom-up: cada vértice sin visitar busca un vecino en la frontera. Las
+// tareas son tramos de palabras completas, así que nadie más escribe sus bits
+static void bfsBottomUpChunk(int task, int threadIndex, void* context) {
+    BFSLevelJob* job = (BFSLevelJob*)context;
+    const CSRGraph* g = job->graph;
+    BFSWorkspace* ws = job->ws;
+
+    int begin = task * BFS_CHUNK;
+    int end = begin + BFS_CHUNK < job->numVertices ? begin + BFS_CHUNK : job->numVertices;
+
+    for (int v = begin; v < end; v++) {
+        if (testBit(ws->visited, v)) continue;
+
+        for (int e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+            int u = g->targets[e];
+            if (!testBit(ws->frontierBits, u)) continue;
+
+            ws->visited[v >> 6] |= 1ULL << (v & 63);
+            ws->nextBits[v >> 6] |= 1ULL << (v & 63);
+            job->distances[v] = job->level + 1;
+            if (job->parent) job->parent[v] = u;
+            ws->threadCounts[threadIndex]++;
+            ws->threadEdges[threadIndex] += g->offsets[v + 1] - g->offsets[v];
+            break;
+        }
+    }
+}
+
+static void resetThreadCounters(BFSWorkspace* ws) {
+    for (int t = 0; t < ws->numThreads; t++) {
+        ws->threadNext[t].size = 0;
+        ws->threadCounts[t] = 0;
+        ws->threadEdges[t] = 0;
+    }
+}
+
+int bfsDirectionOptimizing(const CSRGraph* graph, int source, int target,
+                           BFSWorkspace* ws, int* distances, int* parent) {
+    if (!graph || !ws || !distances || graph->numVertices > ws->numVertices ||
+        source < 0 || source >= graph->numVertices || target >= graph->numVertices) {
+        return -1;
+    }
+
+    int n = graph->numVertices;
+    int numWords = (n + 63) / 64;
+    int vertexTasks = (n + BFS_CHUNK - 1) / BFS_CHUNK;
+
+    memset(ws->visited, 0, numWords * sizeof(uint64_t));
+    for (int i = 0; i < n; i++) {
+        distances[i] = -1;
+    }
+    if (parent) {
+        for (int i = 0; i < n; i++) {
+            parent[i] = -1;
+        }
+    }
+
+    BFSLevelJob job = {graph, ws, distances, parent, n, 0};
+
+    ws->visited[source >> 6] |= 1ULL << (source & 63);
+    distances[source] = 0;
+    ws->frontier.size = 0;
+    bfsListPush(&ws->frontier, source);
+
+    int reached = 1;
+    long frontierSize = 1;
+    long frontierEdges = graph->offsets[source + 1] - graph->offsets[source];
+    long unexploredEdges = graph->numEdges - frontierEdges;
+    bool bottomUp = false;
+
+    while (frontierSize > 0 && (target < 0 || distances[target] < 0)) {
+        resetThreadCounters(ws);
+
+        // Heurística de Beamer: bottom-up cuando la frontera es grande
+        // respecto de lo que falta explorar, top-down cuando vuelve a achicarse
+        bool wantBottomUp = !graph->isDirected &&
+                            (bottomUp ? frontierSize >= n / BFS_BETA
+                                      : frontierEdges > unexploredEdges / BFS_ALPHA);
+
+        if (wantBottomUp && !bottomUp) {
+            memset(ws->frontierBits, 0, numWords * sizeof(uint64_t));
+            for (int i = 0; i < ws->frontier.size; i++) {
+                int u = ws->frontier.data[i];
+                ws->frontierBits[u >> 6] |= 1ULL << (u & 63);
+            }
+        } else if (!wantBottomUp && bottomUp) {
+            ws->frontier.size = 0;
+            for (int w = 0; w < numWords; w++) {
+                for (uint64_t bits = ws->frontierBits[w]; bits; bits &= bits - 1) {
+                    bfsListPush(&ws->frontier, w * 64 + __builtin_ctzll(bits));
+                }
+            }
+        }
+        bottomUp = wantBottomUp;
+
+        long discovered = 0;
+        frontierEdges = 0;
+
+        if (bottomUp) {
+            memset(ws->nextBits, 0, numWords * sizeof(uint64_t));
+            parallelFor(vertexTasks, ws->numThreads, bfsBottomUpChunk, &job);
+
+            uint64_t* swap = ws->frontierBits;
+            ws->frontierBits = ws->nextBits;
+            ws->nextBits = swap;
+
+            for (int t = 0; t < ws->numThreads; t++) {
+                discovered += ws->threadCounts[t];
+                frontierEdges += ws->threadEdges[t];
+            }
+        } else {
+            int frontierTasks = (ws->frontier.size + BFS_CHUNK - 1) / BFS_CHUNK;
+            parallelFor(frontierTasks, ws->numThreads, bfsTopDownChunk, &job);
+
+            ws->frontier.size = 0;
+            for (int t = 0; t < ws->numThreads; t++) {
+                BFSList* next = &ws->threadNext[t];
+                for (int i = 0; i < next->size; i++) {
+                    bfsListPush(&ws->frontier, next->data[i]);
+                }
+                discovered += next->size;
+                frontierEdges += ws->threadEdges[t];
+            }
+        }
+
+        reached += (int)discovered;
+        frontierSize = discovered;
+        unexploredEdges -= frontierEdges;
+        job.level++;
+    }
+
+    return reached;
+}
@@ -0,0 +1,53 @@
+//
+// Created by administrador on 6/26/25.
+//
+
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../graph/csr_graph.h"
+
+#define BFS_ALPHA 14   // Pasar a bottom-up cuando la frontera tiene más de 1/ALPHA de las aristas sin visitar
+#define BFS_BETA 24    // Volver a top-down cuando la frontera tiene menos de 1/BETA de los vértices
+
+typedef struct {
+    int* data;
+    int size;
+    int capacity;
+} BFSList;
+
+// Memoria de trabajo reutilizable entre búsquedas sobre grafos de hasta
+// numVertices vértices: bitmaps de visitados y de frontera, la frontera
+// como lista y lo que produce cada hilo en un nivel
+typedef struct {
+    int numVertices;
+    int numWords;
+    int numThreads;
+    uint64_t* visited;
+    uint64_t* frontierBits;
+    uint64_t* nextBits;
+    BFSList frontier;
+    BFSList* threadNext;     // Vértices descubiertos por cada hilo (top-down)
+    long* threadCounts;      // Por hilo: vértices despertados (bottom-up)
+    long* threadEdges;       // Por hilo: aristas de los vértices descubiertos
+} BFSWorkspace;
+
+// numThreads <= 0 = todos los núcleos
+BFSWorkspace* createBFSWorkspace(int numVertices, int numThreads);
+void destroyBFSWorkspace(BFSWorkspace* workspace);
+
+// BFS por niveles que alterna top-down y bottom-up (Beamer). distances
+// (obligatorio) y parent (puede ser NULL) son del que llama y deben tener
+// numVertices lugares; quedan en -1 los vértices no alcanzados. Con
+// target >= 0 termina al cerrar el nivel que lo alcanza. Bottom-up mira
+// los vecinos como predecesores, así que solo se usa en grafos no
+// dirigidos. Devuelve la cantidad de vértices alcanzados (-1 si los
+// parámetros son inválidos).
+int bfsDirectionOptimizing(const CSRGraph* graph, int source, int target,
+                           BFSWorkspace* workspace, int* distances, int* parent);
+
+#endif //PARALLEL_BFS_H
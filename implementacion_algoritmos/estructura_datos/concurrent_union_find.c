@@ -0,0 +1,92 @@
+#include "concurrent_union_find.h"
+
+// Crear estructura con cada elemento en su propio conjunto
+ConcurrentUnionFind* createConcurrentUnionFind(int n) {
+    if (n <= 0) return NULL;
+
+    ConcurrentUnionFind* uf = (ConcurrentUnionFind*)malloc(sizeof(ConcurrentUnionFind));
+    if (!uf) return NULL;
+
+    uf->parent = (_Atomic int*)malloc(n * sizeof(_Atomic int));
+    if (!uf->parent) {
+        free(uf);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        atomic_init(&uf->parent[i], i);
+    }
+    atomic_init(&uf->numSets, n);
+    uf->totalElements = n;
+
+    return uf;
+}
+
+void destroyConcurrentUnionFind(ConcurrentUnionFind* uf) {
+    if (!uf) return;
+    free((void*)uf->parent);
+    free(uf);
+}
+
+// Raíz con path splitting: x -> abuelo en cada paso. Si otro hilo cambió
+// el padre entre medio el CAS falla y se sigue subiendo igual; como los
+// padres solo bajan, el recorrido siempre termina
+int concurrentFind(ConcurrentUnionFind* uf, int x) {
+    if (!uf || x < 0 || x >= uf->totalElements) return -1;
+
+    while (true) {
+        int parent = atomic_load_explicit(&uf->parent[x], memory_order_relaxed);
+        if (parent == x) return x;
+
+        int grandparent = atomic_load_explicit(&uf->parent[parent], memory_order_relaxed);
+        if (grandparent != parent) {
+            atomic_compare_exchange_weak_explicit(&uf->parent[x], &parent, grandparent,
+                                                  memory_order_relaxed, memory_order_relaxed);
+        }
+        x = parent;
+    }
+}
+
+// Unir los conjuntos de x e y; false si ya estaban juntos
+bool concurrentUnion(ConcurrentUnionFind* uf, int x, int y) {
+    if (!uf || x < 0 || x >= uf->totalElements || y < 0 || y >= uf->totalElements) return false;
+
+    while (true) {
+        int rootX = concurrentFind(uf, x);
+        int rootY = concurrentFind(uf, y);
+        if (rootX == rootY) return false;
+
+        // Enlazar la raíz mayor bajo la menor; si dejó de ser raíz, reintentar
+        if (rootX < rootY) {
+            int tmp = rootX;
+            rootX = rootY;
+            rootY = tmp;
+        }
+
+        int expected = rootX;
+        if (atomic_compare_exchange_strong(&uf->parent[rootX], &expected, rootY)) {
+            atomic_fetch_sub_explicit(&uf->numSets, 1, memory_order_relaxed);
+            return true;
+        }
+        x = rootX;
+        y = rootY;
+    }
+}
+
+// Dos raíces distintas pueden quedar unidas mientras se consulta: se
+// reintenta hasta ver la misma raíz o una raíz que sigue siéndolo
+bool concurrentSameSet(ConcurrentUnionFind* uf, int x, int y) {
+    if (!uf || x < 0 || x >= uf->totalElements || y < 0 || y >= uf->totalElements) return false;
+
+    while (true) {
+        int rootX = concurrentFind(uf, x);
+        int rootY = concurrentFind(uf, y);
+        if (rootX == rootY) return true;
+        if (atomic_load(&uf->parent[rootX]) == rootX) return false;
+        x = rootX;
+    }
+}
+
+int concurrentNumSets(ConcurrentUnionFind* uf) {
+    return uf ? atomic_load(&uf->numSets) : -1;
+}
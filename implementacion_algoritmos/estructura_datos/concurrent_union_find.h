@@ -0,0 +1,34 @@
+//
+// Created by administrador on 6/25/25.
+//
+
+#ifndef CONCURRENT_UNION_FIND_H
+#define CONCURRENT_UNION_FIND_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Union-Find que pueden usar muchos hilos a la vez sin locks.
+// La unión enlaza siempre la raíz de índice mayor bajo la de índice menor
+// con un CAS, así los punteros a padre solo bajan y no pueden formarse
+// ciclos; la raíz de cada conjunto es su elemento mínimo. find comprime
+// con path splitting (cada nodo pasa a apuntar a su abuelo) usando CAS
+// que, si fallan, simplemente se ignoran.
+typedef struct {
+    _Atomic int* parent;
+    atomic_int numSets;
+    int totalElements;
+} ConcurrentUnionFind;
+
+ConcurrentUnionFind* createConcurrentUnionFind(int n);
+void destroyConcurrentUnionFind(ConcurrentUnionFind* uf);
+
+// Seguras para llamar concurrentemente entre sí
+int concurrentFind(ConcurrentUnionFind* uf, int x);
+bool concurrentUnion(ConcurrentUnionFind* uf, int x, int y);
+bool concurrentSameSet(ConcurrentUnionFind* uf, int x, int y);
+int concurrentNumSets(ConcurrentUnionFind* uf);
+
+#endif //CONCURRENT_UNION_FIND_H
@@ -228,4 +228,222 @@ void destroyPriorityQueue(PriorityQueue* pq) {
         free(pq->elements);
     }
     free(pq);
-}
\ No newline at end of file
+}
+// =================================================================
+// Cola de prioridad indexada
+// =================================================================
+
+// Crear cola indexada para ids en [0, maxId) con el layout por defecto
+IndexedPriorityQueue* createIndexedPriorityQueue(int maxId) {
+    return createIndexedPriorityQueueDary(maxId, IPQ_DEFAULT_ARITY);
+}
+
+// Crear cola indexada con arity hijos por nodo
+IndexedPriorityQueue* createIndexedPriorityQueueDary(int maxId, int arity) {
+    if (maxId <= 0) maxId = 1;
+    if (arity < 2) arity = 2;
+
+    IndexedPriorityQueue* ipq = (IndexedPriorityQueue*)malloc(sizeof(IndexedPriorityQueue));
+    if (!ipq) return NULL;
+
+    ipq->heap = (int*)malloc(maxId * sizeof(int));
+    ipq->keys = (int*)malloc(maxId * sizeof(int));
+    ipq->position = (int*)malloc(maxId * sizeof(int));
+
+    if (!ipq->heap || !ipq->keys || !ipq->position) {
+        destroyIndexedPriorityQueue(ipq);
+        return NULL;
+    }
+
+    for (int i = 0; i < maxId; i++) {
+        ipq->position[i] = -1;
+    }
+    ipq->size = 0;
+    ipq->maxId = maxId;
+    ipq->arity = arity;
+
+    return ipq;
+}
+
+// Subir el elemento en index moviendo los padres hacia abajo (sin swaps)
+static void ipqSiftUp(IndexedPriorityQueue* ipq, int index) {
+    int id = ipq->heap[index];
+    int key = ipq->keys[id];
+
+    while (index > 0) {
+        int parentIndex = (index - 1) / ipq->arity;
+        int parentId = ipq->heap[parentIndex];
+        if (ipq->keys[parentId] <= key) break;
+
+        ipq->heap[index] = parentId;
+        ipq->position[parentId] = index;
+        index = parentIndex;
+    }
+
+    ipq->heap[index] = id;
+    ipq->position[id] = index;
+}
+
+// Bajar el elemento en index hacia el hijo de menor prioridad
+static void ipqSiftDown(IndexedPriorityQueue* ipq, int index) {
+    int id = ipq->heap[index];
+    int key = ipq->keys[id];
+
+    while (true) {
+        int firstChild = index * ipq->arity + 1;
+        if (firstChild >= ipq->size) break;
+
+        int lastChild = firstChild + ipq->arity;
+        if (lastChild > ipq->size) lastChild = ipq->size;
+
+        int smallest = firstChild;
+        int smallestKey = ipq->keys[ipq->heap[firstChild]];
+        for (int c = firstChild + 1; c < lastChild; c++) {
+            int childKey = ipq->keys[ipq->heap[c]];
+            if (childKey < smallestKey) {
+                smallest = c;
+                smallestKey = childKey;
+            }
+        }
+
+        if (smallestKey >= key) break;
+
+        int childId = ipq->heap[smallest];
+        ipq->heap[index] = childId;
+        ipq->position[childId] = index;
+        index = smallest;
+    }
+
+    ipq->heap[index] = id;
+    ipq->position[id] = index;
+}
+
+// Insertar un id que no está en la cola
+bool ipqPush(IndexedPriorityQueue* ipq, int id, int priority) {
+    if (!ipq || id < 0 || id >= ipq->maxId || ipq->position[id] != -1) return false;
+
+    ipq->heap[ipq->size] = id;
+    ipq->position[id] = ipq->size;
+    ipq->keys[id] = priority;
+    ipq->size++;
+    ipqSiftUp(ipq, ipq->size - 1);
+
+    return true;
+}
+
+// Extraer el id de menor prioridad (-1 si está vacía)
+int ipqPop(IndexedPriorityQueue* ipq) {
+    return ipqPopWithPriority(ipq, NULL);
+}
+
+// Extraer el id de menor prioridad devolviendo también su prioridad
+int ipqPopWithPriority(IndexedPriorityQueue* ipq, int* priority) {
+    if (!ipq || ipq->size == 0) return -1;
+
+    int id = ipq->heap[0];
+    if (priority) *priority = ipq->keys[id];
+
+    ipq->size--;
+    if (ipq->size > 0) {
+        ipq->heap[0] = ipq->heap[ipq->size];
+        ipq->position[ipq->heap[0]] = 0;
+        ipqSiftDown(ipq, 0);
+    }
+    ipq->position[id] = -1;
+
+    return id;
+}
+
+// Ver el id de menor prioridad sin extraerlo
+int ipqPeek(IndexedPriorityQueue* ipq) {
+    if (!ipq || ipq->size == 0) return -1;
+    return ipq->heap[0];
+}
+
+// Reducir la prioridad de un id presente en la cola
+bool ipqDecreaseKey(IndexedPriorityQueue* ipq, int id, int newPriority) {
+    if (!ipqContains(ipq, id) || newPriority > ipq->keys[id]) return false;
+
+    ipq->keys[id] = newPriority;
+    ipqSiftUp(ipq, ipq->position[id]);
+    return true;
+}
+
+// Aumentar la prioridad de un id presente en la cola
+bool ipqIncreaseKey(IndexedPriorityQueue* ipq, int id, int newPriority) {
+    if (!ipqContains(ipq, id) || newPriority < ipq->keys[id]) return false;
+
+    ipq->keys[id] = newPriority;
+    ipqSiftDown(ipq, ipq->position[id]);
+    return true;
+}
+
+// Cambiar la prioridad en cualquier dirección
+bool ipqUpdatePriority(IndexedPriorityQueue* ipq, int id, int newPriority) {
+    if (!ipqContains(ipq, id)) return false;
+
+    if (newPriority < ipq->keys[id]) {
+        return ipqDecreaseKey(ipq, id, newPriority);
+    }
+    return ipqIncreaseKey(ipq, id, newPriority);
+}
+
+// Eliminar un id arbitrario: el último elemento ocupa su lugar y se reubica
+bool ipqRemove(IndexedPriorityQueue* ipq, int id) {
+    if (!ipqContains(ipq, id)) return false;
+
+    int index = ipq->position[id];
+    ipq->position[id] = -1;
+    ipq->size--;
+
+    if (index != ipq->size) {
+        int lastId = ipq->heap[ipq->size];
+        ipq->heap[index] = lastId;
+        ipq->position[lastId] = index;
+
+        if (index > 0 && ipq->keys[lastId] < ipq->keys[ipq->heap[(index - 1) / ipq->arity]]) {
+            ipqSiftUp(ipq, index);
+        } else {
+            ipqSiftDown(ipq, index);
+        }
+    }
+
+    return true;
+}
+
+bool ipqContains(IndexedPriorityQueue* ipq, int id) {
+    return ipq && id >= 0 && id < ipq->maxId && ipq->position[id] != -1;
+}
+
+// Prioridad actual de un id presente en la cola
+int ipqGetPriority(IndexedPriorityQueue* ipq, int id) {
+    return ipqContains(ipq, id) ? ipq->keys[id] : -1;
+}
+
+bool ipqIsEmpty(IndexedPriorityQueue* ipq) {
+    return !ipq || ipq->size == 0;
+}
+
+int ipqSize(IndexedPriorityQueue* ipq) {
+    return ipq ? ipq->size : 0;
+}
+
+// Vaciar la cola en O(size), sin recorrer todo el mapa de posiciones
+void ipqClear(IndexedPriorityQueue* ipq) {
+    if (!ipq) return;
+
+    for (int i = 0; i < ipq->size; i++) {
+        ipq->position[ipq->heap[i]] = -1;
+    }
+    ipq->size = 0;
+}
+
+// Destruir cola indexada
+void destroyIndexedPriorityQueue(IndexedPriorityQueue* ipq) {
+    if (!ipq) return;
+
+    if (ipq->heap) free(ipq->heap);
+    if (ipq->keys) free(ipq->keys);
+    if (ipq->position) free(ipq->position);
+    free(ipq);
+}
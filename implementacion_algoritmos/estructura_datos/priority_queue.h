@@ -19,6 +19,23 @@ typedef struct {
     bool isMinHeap;
 } PriorityQueue;
 
+#define IPQ_DEFAULT_ARITY 4
+
+// Cola de prioridad indexada (min-heap d-ario) sobre ids enteros 0..maxId-1.
+// El id es el handle del elemento: position[id] guarda su índice dentro del
+// heap (-1 si no está), así que contains es O(1) y decrease-key, increase-key
+// y remove son O(log n) sin búsquedas lineales.
+// Con arity 4 el heap es menos profundo y los hijos de un nodo comparten
+// línea de caché, lo que suele ganarle al heap binario.
+typedef struct {
+    int* heap;       // ids en orden de heap
+    int* keys;       // prioridad actual de cada id
+    int* position;   // posición de cada id en heap
+    int size;
+    int maxId;
+    int arity;       // hijos por nodo (2 = binario)
+} IndexedPriorityQueue;
+
 // Prototipos de funciones principales
 PriorityQueue* createPriorityQueue(int initialCapacity, bool isMinHeap);
 void destroyPriorityQueue(PriorityQueue* pq);
@@ -42,4 +59,22 @@ void heapifyDown(PriorityQueue* pq, int index);
 void resizePriorityQueue(PriorityQueue* pq);
 bool shouldSwap(PriorityQueue* pq, int parent, int child);
 
+// Cola de prioridad indexada
+IndexedPriorityQueue* createIndexedPriorityQueue(int maxId);
+IndexedPriorityQueue* createIndexedPriorityQueueDary(int maxId, int arity);
+void destroyIndexedPriorityQueue(IndexedPriorityQueue* ipq);
+bool ipqPush(IndexedPriorityQueue* ipq, int id, int priority);
+int ipqPop(IndexedPriorityQueue* ipq);
+int ipqPopWithPriority(IndexedPriorityQueue* ipq, int* priority);
+int ipqPeek(IndexedPriorityQueue* ipq);
+bool ipqDecreaseKey(IndexedPriorityQueue* ipq, int id, int newPriority);
+bool ipqIncreaseKey(IndexedPriorityQueue* ipq, int id, int newPriority);
+bool ipqUpdatePriority(IndexedPriorityQueue* ipq, int id, int newPriority);
+bool ipqRemove(IndexedPriorityQueue* ipq, int id);
+bool ipqContains(IndexedPriorityQueue* ipq, int id);
+int ipqGetPriority(IndexedPriorityQueue* ipq, int id);
+bool ipqIsEmpty(IndexedPriorityQueue* ipq);
+int ipqSize(IndexedPriorityQueue* ipq);
+void ipqClear(IndexedPriorityQueue* ipq);
+
 #endif
\ No newline at end of file
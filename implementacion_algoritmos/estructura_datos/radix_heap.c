@@ -0,0 +1,125 @@
+#include "radix_heap.h"
+
+// Crear radix heap
+RadixHeap* createRadixHeap(int initialCapacity) {
+    if (initialCapacity <= 0) {
+        initialCapacity = 16;
+    }
+
+    RadixHeap* rh = (RadixHeap*)malloc(sizeof(RadixHeap));
+    if (!rh) return NULL;
+
+    for (int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        rh->buckets[b].items = NULL;
+        rh->buckets[b].size = 0;
+        rh->buckets[b].capacity = 0;
+    }
+
+    // El bucket 0 recibe todas las extracciones: reservarlo de entrada
+    rh->buckets[0].items = (RadixItem*)malloc(initialCapacity * sizeof(RadixItem));
+    if (!rh->buckets[0].items) {
+        free(rh);
+        return NULL;
+    }
+    rh->buckets[0].capacity = initialCapacity;
+
+    rh->last = 0;
+    rh->size = 0;
+
+    return rh;
+}
+
+// Bucket correspondiente a una clave: posición del bit más alto en que
+// difiere de last (0 si son iguales)
+static int radixBucketIndex(RadixHeap* rh, unsigned int key) {
+    unsigned int diff = key ^ rh->last;
+    return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+}
+
+static bool radixBucketAppend(RadixBucket* bucket, int id, unsigned int key) {
+    if (bucket->size >= bucket->capacity) {
+        int newCapacity = bucket->capacity > 0 ? bucket->capacity * 2 : 16;
+        RadixItem* newItems = (RadixItem*)realloc(bucket->items, newCapacity * sizeof(RadixItem));
+        if (!newItems) return false;
+        bucket->items = newItems;
+        bucket->capacity = newCapacity;
+    }
+
+    bucket->items[bucket->size].id = id;
+    bucket->items[bucket->size].key = key;
+    bucket->size++;
+    return true;
+}
+
+// Insertar elemento (key debe ser >= última clave extraída)
+bool radixHeapPush(RadixHeap* rh, int id, unsigned int key) {
+    if (!rh || key < rh->last) return false;
+
+    if (!radixBucketAppend(&rh->buckets[radixBucketIndex(rh, key)], id, key)) {
+        return false;
+    }
+    rh->size++;
+    return true;
+}
+
+// Extraer el elemento de menor clave (-1 si está vacío)
+int radixHeapPop(RadixHeap* rh, unsigned int* key) {
+    if (!rh || rh->size == 0) return -1;
+
+    if (rh->buckets[0].size == 0) {
+        // Buscar el primer bucket no vacío
+        int b = 1;
+        while (rh->buckets[b].size == 0) b++;
+
+        // Nuevo mínimo dentro de ese bucket
+        RadixBucket* bucket = &rh->buckets[b];
+        unsigned int minKey = bucket->items[0].key;
+        for (int i = 1; i < bucket->size; i++) {
+            if (bucket->items[i].key < minKey) minKey = bucket->items[i].key;
+        }
+        rh->last = minKey;
+
+        // Redistribuir: cada elemento cae en un bucket estrictamente menor que b
+        for (int i = 0; i < bucket->size; i++) {
+            RadixItem item = bucket->items[i];
+            radixBucketAppend(&rh->buckets[radixBucketIndex(rh, item.key)], item.id, item.key);
+        }
+        bucket->size = 0;
+    }
+
+    RadixBucket* first = &rh->buckets[0];
+    RadixItem item = first->items[--first->size];
+    rh->size--;
+
+    if (key) *key = item.key;
+    return item.id;
+}
+
+bool radixHeapIsEmpty(RadixHeap* rh) {
+    return !rh || rh->size == 0;
+}
+
+int radixHeapSize(RadixHeap* rh) {
+    return rh ? rh->size : 0;
+}
+
+// Vaciar el heap conservando la memoria de los buckets
+void radixHeapClear(RadixHeap* rh) {
+    if (!rh) return;
+
+    for (int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        rh->buckets[b].size = 0;
+    }
+    rh->last = 0;
+    rh->size = 0;
+}
+
+// Destruir radix heap
+void destroyRadixHeap(RadixHeap* rh) {
+    if (!rh) return;
+
+    for (int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        if (rh->buckets[b].items) free(rh->buckets[b].items);
+    }
+    free(rh);
+}
@@ -0,0 +1,46 @@
+//
+// Created by administrador on 6/16/25.
+//
+
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Un bucket por cada bit en el que la clave puede diferir del último mínimo
+#define RADIX_HEAP_BUCKETS 33
+
+// Elemento del radix heap
+typedef struct {
+    int id;
+    unsigned int key;
+} RadixItem;
+
+typedef struct {
+    RadixItem* items;
+    int size;
+    int capacity;
+} RadixBucket;
+
+// Radix heap monótono: las claves insertadas nunca pueden ser menores que
+// la última clave extraída. Sirve para Dijkstra con pesos enteros no negativos.
+typedef struct {
+    RadixBucket buckets[RADIX_HEAP_BUCKETS];
+    unsigned int last;   // Última clave mínima extraída
+    int size;
+} RadixHeap;
+
+// Prototipos de funciones principales
+RadixHeap* createRadixHeap(int initialCapacity);
+void destroyRadixHeap(RadixHeap* rh);
+
+// Operaciones básicas
+bool radixHeapPush(RadixHeap* rh, int id, unsigned int key);
+int radixHeapPop(RadixHeap* rh, unsigned int* key);
+bool radixHeapIsEmpty(RadixHeap* rh);
+int radixHeapSize(RadixHeap* rh);
+void radixHeapClear(RadixHeap* rh);
+
+#endif //RADIX_HEAP_H
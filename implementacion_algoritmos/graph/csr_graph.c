@@ -0,0 +1,246 @@
+#include "csr_graph.h"
+#include <string.h>
+
+// Reservar un grafo CSR vacío con espacio para numEdges arcos
+CSRGraph* createCSRGraph(int numVertices, int numEdges, bool isDirected) {
+    if (numVertices < 0 || numEdges < 0) return NULL;
+
+    CSRGraph* csr = (CSRGraph*)malloc(sizeof(CSRGraph));
+    if (!csr) return NULL;
+
+    csr->numVertices = numVertices;
+    csr->numEdges = numEdges;
+    csr->isDirected = isDirected;
+    csr->offsets = (int*)calloc(numVertices + 1, sizeof(int));
+    // Reservar al menos un elemento para que malloc(0) no devuelva NULL
+    csr->targets = (int*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(int));
+    csr->weights = (int*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(int));
+
+    if (!csr->offsets || !csr->targets || !csr->weights) {
+        destroyCSRGraph(csr);
+        return NULL;
+    }
+
+    return csr;
+}
+
+// Liberar el grafo CSR
+void destroyCSRGraph(CSRGraph* csr) {
+    if (!csr) return;
+
+    if (csr->offsets) free(csr->offsets);
+    if (csr->targets) free(csr->targets);
+    if (csr->weights) free(csr->weights);
+    free(csr);
+}
+
+// Copiar offsets, destinos y pesos a un grafo nuevo
+CSRGraph* csrClone(const CSRGraph* csr) {
+    if (!csr) return NULL;
+
+    CSRGraph* copy = createCSRGraph(csr->numVertices, csr->numEdges, csr->isDirected);
+    if (!copy) return NULL;
+
+    memcpy(copy->offsets, csr->offsets, (csr->numVertices + 1) * sizeof(int));
+    memcpy(copy->targets, csr->targets, csr->numEdges * sizeof(int));
+    memcpy(copy->weights, csr->weights, csr->numEdges * sizeof(int));
+    return copy;
+}
+
+// Construir desde una lista de aristas (counting sort por vértice origen).
+// Si el grafo no es dirigido cada arista se guarda en ambas direcciones.
+CSRGraph* csrFromEdges(int numVertices, const Edge* edges, int numEdges, bool isDirected) {
+    if (numVertices < 0 || numEdges < 0 || (numEdges > 0 && !edges)) return NULL;
+
+    // Contar arcos válidos por vértice origen
+    int* degree = (int*)calloc(numVertices + 1, sizeof(int));
+    if (!degree) return NULL;
+
+    int numArcs = 0;
+    for (int i = 0; i < numEdges; i++) {
+        int src = edges[i].src, dest = edges[i].dest;
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) continue;
+
+        degree[src]++;
+        numArcs++;
+        if (!isDirected && src != dest) {
+            degree[dest]++;
+            numArcs++;
+        }
+    }
+
+    CSRGraph* csr = createCSRGraph(numVertices, numArcs, isDirected);
+    if (!csr) {
+        free(degree);
+        return NULL;
+    }
+
+    // Suma prefija: offsets[u] = inicio de los vecinos de u
+    for (int u = 0; u < numVertices; u++) {
+        csr->offsets[u + 1] = csr->offsets[u] + degree[u];
+    }
+
+    // Reutilizar degree como cursor de escritura
+    for (int u = 0; u < numVertices; u++) {
+        degree[u] = csr->offsets[u];
+    }
+
+    for (int i = 0; i < numEdges; i++) {
+        int src = edges[i].src, dest = edges[i].dest;
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) continue;
+
+        int pos = degree[src]++;
+        csr->targets[pos] = dest;
+        csr->weights[pos] = edges[i].weight;
+
+        if (!isDirected && src != dest) {
+            pos = degree[dest]++;
+            csr->targets[pos] = src;
+            csr->weights[pos] = edges[i].weight;
+        }
+    }
+
+    free(degree);
+    return csr;
+}
+
+// Construir desde una matriz densa (0 = sin arista).
+// La matriz ya contiene ambas direcciones en grafos no dirigidos.
+CSRGraph* csrFromMatrix(int** matrix, int numVertices, bool isDirected) {
+    if (!matrix || numVertices < 0) return NULL;
+
+    int numArcs = 0;
+    for (int i = 0; i < numVertices; i++) {
+        for (int j = 0; j < numVertices; j++) {
+            if (matrix[i][j] != 0) numArcs++;
+        }
+    }
+
+    CSRGraph* csr = createCSRGraph(numVertices, numArcs, isDirected);
+    if (!csr) return NULL;
+
+    int pos = 0;
+    for (int i = 0; i < numVertices; i++) {
+        csr->offsets[i] = pos;
+        for (int j = 0; j < numVertices; j++) {
+            if (matrix[i][j] != 0) {
+                csr->targets[pos] = j;
+                csr->weights[pos] = matrix[i][j];
+                pos++;
+            }
+        }
+    }
+    csr->offsets[numVertices] = pos;
+
+    return csr;
+}
+
+// Construir desde el Graph de graph.h (las listas ya son arreglos, así que
+// cada una se copia de corrido)
+CSRGraph* csrFromGraph(Graph* graph) {
+    if (!graph) return NULL;
+
+    int n = graph->numVertices;
+    CSRGraph* csr = createCSRGraph(n, graph->numArcs, graph->isDirected);
+    if (!csr) return NULL;
+
+    int pos = 0;
+    for (int i = 0; i < n; i++) {
+        csr->offsets[i] = pos;
+        const AdjList* list = &graph->adj_list[i];
+        for (int k = 0; k < list->size; k++) {
+            csr->targets[pos] = list->aristas[k].vertice;
+            csr->weights[pos] = list->aristas[k].peso;
+            pos++;
+        }
+    }
+    csr->offsets[n] = pos;
+
+    return csr;
+}
+
+// Grado de salida de un vértice
+int csrDegree(const CSRGraph* csr, int vertex) {
+    if (!csr || vertex < 0 || vertex >= csr->numVertices) return -1;
+    return csr->offsets[vertex + 1] - csr->offsets[vertex];
+}
+
+// Peso del arco from -> to (0 si no existe, igual que en la matriz)
+int csrEdgeWeight(const CSRGraph* csr, int from, int to) {
+    if (!csr || from < 0 || from >= csr->numVertices) return 0;
+
+    for (int e = csr->offsets[from]; e < csr->offsets[from + 1]; e++) {
+        if (csr->targets[e] == to) return csr->weights[e];
+    }
+    return 0;
+}
+
+static int compareArcKeys(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Ordenar por (destino, peso) los vecinos de los vértices [fromVertex, toVertex).
+// Las listas cortas van por inserción; las largas se empaquetan en claves
+// de 64 bits (peso con el bit de signo invertido) y se ordenan con qsort
+void csrSortNeighbors(CSRGraph* csr, int fromVertex, int toVertex) {
+    if (!csr) return;
+    if (fromVertex < 0) fromVertex = 0;
+    if (toVertex > csr->numVertices) toVertex = csr->numVertices;
+
+    for (int u = fromVertex; u < toVertex; u++) {
+        int start = csr->offsets[u], end = csr->offsets[u + 1];
+
+        if (end - start <= CSR_SORT_INSERTION_LIMIT) {
+            for (int i = start + 1; i < end; i++) {
+                int target = csr->targets[i], weight = csr->weights[i];
+                int j = i - 1;
+                while (j >= start && (csr->targets[j] > target ||
+                                      (csr->targets[j] == target && csr->weights[j] > weight))) {
+                    csr->targets[j + 1] = csr->targets[j];
+                    csr->weights[j + 1] = csr->weights[j];
+                    j--;
+                }
+                csr->targets[j + 1] = target;
+                csr->weights[j + 1] = weight;
+            }
+            continue;
+        }
+
+        uint64_t* keys = (uint64_t*)malloc((size_t)(end - start) * sizeof(uint64_t));
+        if (!keys) continue;
+        for (int i = start; i < end; i++) {
+            keys[i - start] = ((uint64_t)(uint32_t)csr->targets[i] << 32) |
+                              ((uint32_t)csr->weights[i] ^ 0x80000000u);
+        }
+        qsort(keys, end - start, sizeof(uint64_t), compareArcKeys);
+        for (int i = start; i < end; i++) {
+            csr->targets[i] = (int)(keys[i - start] >> 32);
+            csr->weights[i] = (int)((uint32_t)keys[i - start] ^ 0x80000000u);
+        }
+        free(keys);
+    }
+}
+
+// Imprimir el grafo CSR
+void printCSRGraph(const CSRGraph* csr) {
+    if (!csr) {
+        printf("❌ Grafo CSR nulo\n");
+        return;
+    }
+
+    printf("\n📦 === GRAFO CSR ===\n");
+    printf("Tipo: %s\n", csr->isDirected ? "Dirigido" : "No dirigido");
+    printf("Vértices: %d, Arcos: %d\n", csr->numVertices, csr->numEdges);
+    printf("Memoria: %zu bytes\n",
+           (size_t)(csr->numVertices + 1) * sizeof(int) + (size_t)csr->numEdges * 2 * sizeof(int));
+
+    for (int u = 0; u < csr->numVertices; u++) {
+        printf("Vértice %d:", u);
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            printf(" -> %d(peso:%d)", csr->targets[e], csr->weights[e]);
+        }
+        printf("\n");
+    }
+    printf("====================\n");
+}
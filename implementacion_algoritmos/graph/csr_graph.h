@@ -0,0 +1,50 @@
+//
+// Created by administrador on 6/16/25.
+//
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "graph.h"
+#include "../algoritmos/common_types.h"
+
+#define CSR_SORT_INSERTION_LIMIT 32   // Vecinos hasta los que se ordena por inserción
+
+// Grafo de solo lectura en formato CSR (compressed sparse row).
+// Los vecinos de u son targets[offsets[u] .. offsets[u+1]-1], con su peso
+// en la misma posición de weights. Un grafo no dirigido guarda cada arista
+// en ambas direcciones, así que numEdges cuenta arcos, no aristas.
+typedef struct {
+    int numVertices;
+    int numEdges;
+    bool isDirected;
+    int* offsets;   // numVertices + 1 entradas
+    int* targets;   // numEdges entradas
+    int* weights;   // numEdges entradas
+} CSRGraph;
+
+// Creación y destrucción
+CSRGraph* createCSRGraph(int numVertices, int numEdges, bool isDirected);
+void destroyCSRGraph(CSRGraph* csr);
+
+// Construcción desde las otras representaciones
+CSRGraph* csrFromEdges(int numVertices, const Edge* edges, int numEdges, bool isDirected);
+CSRGraph* csrFromMatrix(int** matrix, int numVertices, bool isDirected);
+CSRGraph* csrFromGraph(Graph* graph);
+
+// Copia independiente (por ejemplo para publicar pesos nuevos sin tocar
+// la versión que otros siguen leyendo)
+CSRGraph* csrClone(const CSRGraph* csr);
+
+// Consultas
+int csrDegree(const CSRGraph* csr, int vertex);
+int csrEdgeWeight(const CSRGraph* csr, int from, int to);
+void printCSRGraph(const CSRGraph* csr);
+
+// Orden canónico de los vecinos por (destino, peso) en [fromVertex, toVertex)
+void csrSortNeighbors(CSRGraph* csr, int fromVertex, int toVertex);
+
+#endif //CSR_GRAPH_H
@@ -1,24 +1,154 @@
 #include "graph.h"
+#include "../algoritmos/dfs_engine.h"
+
+// ===============================
+// ÍNDICE HASH DE ARCOS
+// ===============================
+
+static uint64_t edgeKey(int src, int dest) {
+    return ((uint64_t)(uint32_t)src << 32) | (uint32_t)dest;
+}
+
+// Mezcla de splitmix64: los pares (src, dest) consecutivos quedan dispersos
+static uint64_t edgeHash(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+static bool initEdgeIndex(EdgeIndex* index, int capacity) {
+    index->keys = (uint64_t*)malloc(capacity * sizeof(uint64_t));
+    index->slots = (int*)malloc(capacity * sizeof(int));
+    if (!index->keys || !index->slots) {
+        free(index->keys);
+        free(index->slots);
+        return false;
+    }
+
+    for (int i = 0; i < capacity; i++) {
+        index->slots[i] = -1;
+    }
+    index->capacity = capacity;
+    index->count = 0;
+    return true;
+}
+
+// Casilla de la tabla que guarda la clave, o -1
+static int edgeIndexLookup(const EdgeIndex* index, uint64_t key) {
+    int mask = index->capacity - 1;
+    int i = (int)(edgeHash(key) & mask);
+
+    while (index->slots[i] != -1) {
+        if (index->keys[i] == key) return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// La clave no debe estar en la tabla y tiene que haber lugar libre
+static void edgeIndexPlace(EdgeIndex* index, uint64_t key, int slot) {
+    int mask = index->capacity - 1;
+    int i = (int)(edgeHash(key) & mask);
+
+    while (index->slots[i] != -1) {
+        i = (i + 1) & mask;
+    }
+    index->keys[i] = key;
+    index->slots[i] = slot;
+    index->count++;
+}
+
+// Mantener el factor de carga en 1/2 para que el sondeo sea corto
+static bool edgeIndexReserve(EdgeIndex* index) {
+    if ((index->count + 1) * 2 <= index->capacity) return true;
+
+    EdgeIndex bigger;
+    if (!initEdgeIndex(&bigger, index->capacity * 2)) return false;
+
+    for (int i = 0; i < index->capacity; i++) {
+        if (index->slots[i] != -1) {
+            edgeIndexPlace(&bigger, index->keys[i], index->slots[i]);
+        }
+    }
+
+    free(index->keys);
+    free(index->slots);
+    *index = bigger;
+    return true;
+}
+
+// Vaciar la casilla i y correr hacia atrás los elementos del mismo grupo
+// que quedarían inalcanzables desde su posición de origen
+static void edgeIndexErase(EdgeIndex* index, int i) {
+    int mask = index->capacity - 1;
+    int j = i;
+
+    while (true) {
+        j = (j + 1) & mask;
+        if (index->slots[j] == -1) break;
+
+        int home = (int)(edgeHash(index->keys[j]) & mask);
+        bool reachable = (i <= j) ? (i < home && home <= j)
+                                  : (i < home || home <= j);
+        if (reachable) continue;
+
+        index->keys[i] = index->keys[j];
+        index->slots[i] = index->slots[j];
+        i = j;
+    }
+
+    index->slots[i] = -1;
+    index->count--;
+}
+
+// ===============================
+// VÉRTICES Y ARCOS
+// ===============================
+
+// Asegurar lugar para numVertices vértices (crece al doble)
+static bool reserveVertices(Graph* graph, int numVertices) {
+    if (numVertices <= graph->vertexCapacity) return true;
+
+    int capacity = graph->vertexCapacity > 0 ? graph->vertexCapacity : 1;
+    while (capacity < numVertices) {
+        capacity = capacity > INT32_MAX / 2 ? numVertices : capacity * 2;
+    }
+
+    AdjList* lists = (AdjList*)realloc(graph->adj_list, capacity * sizeof(AdjList));
+    if (!lists) return false;
+
+    for (int i = graph->vertexCapacity; i < capacity; i++) {
+        lists[i].aristas = NULL;
+        lists[i].size = 0;
+        lists[i].capacity = 0;
+    }
+    graph->adj_list = lists;
+    graph->vertexCapacity = capacity;
+    return true;
+}
 
 // Crear un nuevo grafo
 Graph* crearGraph(int vertices, bool isDirected) {
+    if (vertices < 0) return NULL;
+
     Graph* graph = (Graph*)malloc(sizeof(Graph));
     if (!graph) return NULL;
     
     graph->numVertices = vertices;
+    graph->vertexCapacity = 0;
     graph->isDirected = isDirected;
+    graph->adj_list = NULL;
+    graph->numArcs = 0;
     
-    // Inicializar lista de adyacencia
-    graph->adj_list = (AdjList*)malloc(vertices * sizeof(AdjList));
-    for (int i = 0; i < vertices; i++) {
-        graph->adj_list[i].raiz = NULL;
-    }
-    
-    // Inicializar matriz de adyacencia
-    for (int i = 0; i < vertices; i++) {
-        for (int j = 0; j < vertices; j++) {
-            graph->adjMatrix[i][j] = 0;
-        }
+    // Inicializar listas de adyacencia (vacías hasta la primera arista)
+    if (!reserveVertices(graph, vertices > 0 ? vertices : 1) ||
+        !initEdgeIndex(&graph->edgeIndex, EDGE_INDEX_INITIAL_CAPACITY)) {
+        free(graph->adj_list);
+        free(graph);
+        return NULL;
     }
     
     printf("✅ Grafo creado: %d vértices, %s\n", 
@@ -33,43 +163,103 @@ void destruirGraph(Graph* graph) {
     
     // Liberar listas de adyacencia
     for (int i = 0; i < graph->numVertices; i++) {
-        AdjNode* current = graph->adj_list[i].raiz;
-        while (current) {
-            AdjNode* temp = current;
-            current = current->siguiente;
-            free(temp);
-        }
+        free(graph->adj_list[i].aristas);
     }
     
     free(graph->adj_list);
+    free(graph->edgeIndex.keys);
+    free(graph->edgeIndex.slots);
     free(graph);
     printf("🗑️  Grafo destruido\n");
 }
 
-// Crear un nuevo nodo de adyacencia
-AdjNode* crearAdjNode(int vertice, int peso) {
-    AdjNode* newNode = (AdjNode*)malloc(sizeof(AdjNode));
-    if (!newNode) return NULL;
-    
-    newNode->vertice = vertice;
-    newNode->peso = peso;
-    newNode->siguiente = NULL;
-    return newNode;
+int findEdgeSlot(const Graph* graph, int from, int to) {
+    if (!graph || from < 0 || to < 0 ||
+        from >= graph->numVertices || to >= graph->numVertices) {
+        return -1;
+    }
+
+    int i = edgeIndexLookup(&graph->edgeIndex, edgeKey(from, to));
+    return i == -1 ? -1 : graph->edgeIndex.slots[i];
 }
 
-// Función auxiliar DFS recursiva
-void DFSUtil(Graph* graph, int vertice, bool visitado[]) {
+bool insertArc(Graph* graph, int src, int dest, int weight) {
+    if (!graph || src < 0 || dest < 0 ||
+        src >= graph->numVertices || dest >= graph->numVertices) {
+        return false;
+    }
+
+    AdjList* list = &graph->adj_list[src];
+    int slot = findEdgeSlot(graph, src, dest);
+    if (slot != -1) {
+        list->aristas[slot].peso = weight;
+        return true;
+    }
+
+    if (list->size == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : ADJ_LIST_INITIAL_CAPACITY;
+        AdjNode* aristas = (AdjNode*)realloc(list->aristas, capacity * sizeof(AdjNode));
+        if (!aristas) return false;
+        list->aristas = aristas;
+        list->capacity = capacity;
+    }
+    if (!edgeIndexReserve(&graph->edgeIndex)) return false;
+
+    list->aristas[list->size].vertice = dest;
+    list->aristas[list->size].peso = weight;
+    edgeIndexPlace(&graph->edgeIndex, edgeKey(src, dest), list->size);
+    list->size++;
+    graph->numArcs++;
+    return true;
+}
+
+// El último arco de la lista pasa al hueco y se corrige su posición en el índice
+bool removeArc(Graph* graph, int src, int dest) {
+    if (!graph || src < 0 || dest < 0 ||
+        src >= graph->numVertices || dest >= graph->numVertices) {
+        return false;
+    }
+
+    EdgeIndex* index = &graph->edgeIndex;
+    int i = edgeIndexLookup(index, edgeKey(src, dest));
+    if (i == -1) return false;
+
+    AdjList* list = &graph->adj_list[src];
+    int slot = index->slots[i];
+    int last = list->size - 1;
+    edgeIndexErase(index, i);
+
+    if (slot != last) {
+        list->aristas[slot] = list->aristas[last];
+        int moved = edgeIndexLookup(index, edgeKey(src, list->aristas[slot].vertice));
+        index->slots[moved] = slot;
+    }
+    list->size--;
+    graph->numArcs--;
+    return true;
+}
+
+static bool printAndMark(int vertice, int parent, void* context) {
+    (void)parent;
+    bool* visitado = (bool*)context;
     visitado[vertice] = true;
     printf("%d ", vertice);
-    
-    // Recorrer todos los vértices adyacentes usando lista de adyacencia
-    AdjNode* current = graph->adj_list[vertice].raiz;
-    while (current) {
-        if (!visitado[current->vertice]) {
-            DFSUtil(graph, current->vertice, visitado);
-        }
-        current = current->siguiente;
-    }
+    return true;
+}
+
+// Función auxiliar DFS con la pila explícita del motor de DFS. Los vecinos
+// se visitan en el orden del arreglo de la lista (orden de inserción, y
+// removeEdgeList mueve el último arco al hueco), no al revés como cuando
+// las aristas se insertaban al principio de la lista enlazada
+void DFSUtil(Graph* graph, int vertice, bool visitado[]) {
+    if (!graph || vertice < 0 || vertice >= graph->numVertices) return;
+
+    DFSGraphView view = dfsViewFromGraph(graph);
+    DFSEngine* engine = dfsThreadEngine(graph->numVertices);
+    dfsEngineResetVisited(engine, graph->numVertices, visitado);
+
+    DFSVisitor visitor = {printAndMark, NULL, NULL, visitado};
+    dfsEngineRun(engine, &view, vertice, &visitor);
 }
 
 // Búsqueda en profundidad (DFS)
@@ -109,13 +299,13 @@ void BFS(Graph* graph, int initVertice) {
         printf("%d ", verticeActual);
         
         // Recorrer vértices adyacentes usando lista de adyacencia
-        AdjNode* current = graph->adj_list[verticeActual].raiz;
-        while (current) {
-            if (!visitado[current->vertice]) {
-                visitado[current->vertice] = true;
-                cola[final++] = current->vertice;
+        AdjList* list = &graph->adj_list[verticeActual];
+        for (int i = 0; i < list->size; i++) {
+            int vecino = list->aristas[i].vertice;
+            if (!visitado[vecino]) {
+                visitado[vecino] = true;
+                cola[final++] = vecino;
             }
-            current = current->siguiente;
         }
     }
     
@@ -150,14 +340,7 @@ bool isGraphConnected(Graph* graph) {
 int contarAristas(Graph* graph) {
     if (!graph) return 0;
     
-    int count = 0;
-    for (int i = 0; i < graph->numVertices; i++) {
-        AdjNode* current = graph->adj_list[i].raiz;
-        while (current) {
-            count++;
-            current = current->siguiente;
-        }
-    }
+    int count = graph->numArcs;
     
     // Si es no dirigido, dividir por 2 porque cada arista se cuenta dos veces
     return graph->isDirected ? count : count / 2;
@@ -179,47 +362,20 @@ void mostrarEstadisticas(Graph* graph) {
 }
 
 bool addVertex(Graph* graph, int vertex) {
-    if (!graph || vertex < 0 || vertex >= graph->numVertices) {
+    if (!graph || vertex < 0) {
         return false;
     }
-    return true; // Los vértices ya existen cuando creas el grafo
+    if (vertex < graph->numVertices) {
+        return true; // El vértice ya existe
+    }
+
+    if (!reserveVertices(graph, vertex + 1)) return false;
+    graph->numVertices = vertex + 1;
+    return true;
 }
 
 // Agregar en graph.c
 bool hasEdge(Graph* graph, int from, int to) {
-    if (!graph || from < 0 || to < 0 ||
-        from >= graph->numVertices || to >= graph->numVertices) {
-        return false;
-        }
-
-    // Buscar en la lista de adyacencia
-    AdjNode* current = graph->adj_list[from].raiz;
-    while (current) {
-        if (current->vertice == to) {
-            return true;
-        }
-        current = current->siguiente;
-    }
-
-    return false;
+    // Buscar en el índice de arcos
+    return findEdgeSlot(graph, from, to) != -1;
 }
-
-bool addEdgeList(Graph* graph, int src, int dest, int weight) {
-    if (!graph || src < 0 || dest < 0 ||
-        src >= graph->numVertices || dest >= graph->numVertices) {
-        return false;
-        }
-
-    // Crear nuevo nodo
-    AdjNode* newNode = crearAdjNode(dest, weight);
-    if (!newNode) return false;
-
-    // Agregar al inicio de la lista
-    newNode->siguiente = graph->adj_list[src].raiz;
-    graph->adj_list[src].raiz = newNode;
-
-    // También actualizar matriz
-    graph->adjMatrix[src][dest] = weight;
-
-    return true;
-}
\ No newline at end of file
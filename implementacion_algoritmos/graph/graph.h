@@ -9,31 +9,47 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
-#define MAX_VERTICES 100
+#include <stdint.h>
 
-// Estrucutura para nodos de lista adyacente
+#define ADJ_LIST_INITIAL_CAPACITY 4     // Arcos reservados en la primera inserción
+#define EDGE_INDEX_INITIAL_CAPACITY 64  // Posiciones iniciales del índice (potencia de 2)
+
+// Estrucutura para arcos de lista adyacente
 typedef  struct AdjNode {
     int vertice;
     int peso;
-    struct AdjNode * siguiente;
 }AdjNode;
 
-// Estrucutura para lista de Adjayencia
+// Estrucutura para lista de Adjayencia: arreglo que crece al doble.
+// Al borrar, el último arco ocupa el hueco, así que el orden no es estable
 typedef struct AdjList {
-    AdjNode * raiz;
+    AdjNode * aristas;
+    int size;
+    int capacity;
 }AdjList;
 
+// Índice hash de arcos (origen, destino) -> posición en la lista del origen.
+// Direccionamiento abierto con sondeo lineal; el borrado corre los
+// elementos siguientes hacia atrás, así que no quedan lápidas
+typedef struct EdgeIndex {
+    uint64_t * keys;     // ((uint64_t)origen << 32) | destino
+    int * slots;         // Posición del arco en adj_list[origen].aristas (-1 = libre)
+    int capacity;
+    int count;
+}EdgeIndex;
+
 // Estrucutura principal del grafo
 typedef struct Graph {
     int numVertices;
+    int vertexCapacity;
     bool isDirected; // si es directo o no
     AdjList * adj_list; // para representar  con listas
-    int adjMatrix[MAX_VERTICES][MAX_VERTICES]; //para representar una matrix
+    EdgeIndex edgeIndex; // para hasEdge y removeEdgeList en O(1)
+    int numArcs; // arcos dirigidos guardados (cada arista no dirigida cuenta 2)
 }Graph;
 
 // Funciones de crear y destuir
 Graph * crearGraph(int vertices, bool isDirected);
-AdjNode* crearAdjNode(int vertice, int peso);
 
 void destruirGraph(Graph * graph);
 
@@ -45,13 +61,23 @@ void printEdgeList(Graph * graph);
 void addEdgeMatrix(Graph* graph, int src, int dest, int weight);
 void removeEdgeMatrix(Graph* graph, int src, int dest);
 void printGraphMatrix(Graph* graph);
+// Se conservan por compatibilidad: matriz y listas comparten los arreglos
+void sincronizarMatrizConLista(Graph* graph);
+void sincronizarListaConMatriz(Graph* graph);
 
 // Funciones de busqueda
 void DFS(Graph * graph, int initVertice);
 void BFS(Graph * graph, int initVertice);
 void DFSUtil(Graph * graph, int vertice, bool visitado[]);
 
+// Si el vértice no existe el grafo crece hasta incluirlo
 bool addVertex(Graph* graph, int vertex);
+// Operaciones sobre un solo arco (sin la dirección inversa), O(1) amortizado.
+// insertArc reemplaza el peso si el arco ya existe (no hay arcos repetidos)
+bool insertArc(Graph* graph, int src, int dest, int weight);
+bool removeArc(Graph* graph, int src, int dest);
+// Posición del arco from -> to en adj_list[from].aristas, o -1
+int findEdgeSlot(const Graph* graph, int from, int to);
 // Función para verificar si existe una arista
 bool hasEdge(Graph* graph, int from, int to);
 bool addEdgeList(Graph* graph, int src, int dest, int weight);
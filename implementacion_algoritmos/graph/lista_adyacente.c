@@ -1,34 +1,22 @@
 #include "graph.h"
 
-// Agregar arista usando lista de adyacencia
+// Agregar arista usando lista de adyacencia.
+// Si la arista ya existe solo se actualiza el peso
 bool addEdgeList(Graph* graph, int src, int dest, int weight) {
     if (!graph || src < 0 || dest < 0 || src >= graph->numVertices || dest >= graph->numVertices) {
         return false;
     }
 
-    // Crear nuevo nodo para la lista de adyacencia
-    AdjNode* newNode = (AdjNode*)malloc(sizeof(AdjNode));
-    if (!newNode) {
+    bool existia = findEdgeSlot(graph, src, dest) != -1;
+    if (!insertArc(graph, src, dest, weight)) {
         return false;
     }
 
-    // CORREGIDO: usar los nombres correctos de tu estructura
-    newNode->vertice = dest;        // Tu estructura usa 'vertice', no 'dest'
-    newNode->peso = weight;         // Tu estructura usa 'peso', no 'weight'
-    newNode->siguiente = graph->adj_list[src].raiz;  // Tu estructura usa 'siguiente' y 'adj_list[].raiz'
-    graph->adj_list[src].raiz = newNode;             // No 'graph->array[].head'
-
     // Si el grafo es no dirigido, agregar la arista en ambas direcciones
-    if (!graph->isDirected) {  // Tu estructura usa 'isDirected', no 'directed'
-        AdjNode* newNode2 = (AdjNode*)malloc(sizeof(AdjNode));  // CORREGIDO: AdjNode, no AdjListNode
-        if (!newNode2) {
-            // Limpiar el primer nodo si falla la asignación del segundo
-            return false;
-        }
-        newNode2->vertice = src;    // CORREGIDO: usar 'vertice'
-        newNode2->peso = weight;    // CORREGIDO: usar 'peso'
-        newNode2->siguiente = graph->adj_list[dest].raiz;  // CORREGIDO: usar la estructura correcta
-        graph->adj_list[dest].raiz = newNode2;
+    if (!graph->isDirected && !insertArc(graph, dest, src, weight)) {
+        // Deshacer el primer arco si falla la asignación del segundo
+        if (!existia) removeArc(graph, src, dest);
+        return false;
     }
 
     return true;
@@ -42,45 +30,15 @@ void removeEdgeList(Graph* graph, int raiz, int dest) {
     }
     
     // Remover de la lista del vértice raiz
-    AdjNode* current = graph->adj_list[raiz].raiz;
-    AdjNode* prev = NULL;
-    
-    while (current && current->vertice != dest) {
-        prev = current;
-        current = current->siguiente;
-    }
-    
-    if (current) {
-        if (prev) {
-            prev->siguiente = current->siguiente;
-        } else {
-            graph->adj_list[raiz].raiz = current->siguiente;
-        }
-        free(current);
-        printf("✅ Arista removida: %d -> %d\n", raiz, dest);
-    } else {
+    if (!removeArc(graph, raiz, dest)) {
         printf("⚠️  Arista no encontrada: %d -> %d\n", raiz, dest);
         return;
     }
+    printf("✅ Arista removida: %d -> %d\n", raiz, dest);
     
     // Si el grafo no es dirigido, remover también en dirección opuesta
     if (!graph->isDirected) {
-        current = graph->adj_list[dest].raiz;
-        prev = NULL;
-        
-        while (current && current->vertice != raiz) {
-            prev = current;
-            current = current->siguiente;
-        }
-        
-        if (current) {
-            if (prev) {
-                prev->siguiente = current->siguiente;
-            } else {
-                graph->adj_list[dest].raiz = current->siguiente;
-            }
-            free(current);
-        }
+        removeArc(graph, dest, raiz);
     }
 }
 
@@ -98,14 +56,13 @@ void printEdgeList(Graph* graph) {
     for (int i = 0; i < graph->numVertices; i++) {
         printf("Vértice %d: ", i);
         
-        AdjNode* current = graph->adj_list[i].raiz;
-        if (!current) {
+        AdjList* list = &graph->adj_list[i];
+        if (list->size == 0) {
             printf("(sin conexiones)");
         }
         
-        while (current) {
-            printf("-> %d(peso:%d) ", current->vertice, current->peso);
-            current = current->siguiente;
+        for (int j = 0; j < list->size; j++) {
+            printf("-> %d(peso:%d) ", list->aristas[j].vertice, list->aristas[j].peso);
         }
         printf("\n");
     }
@@ -119,15 +76,7 @@ bool existeArista(Graph* graph, int raiz, int dest) {
         return false;
     }
     
-    AdjNode* current = graph->adj_list[raiz].raiz;
-    while (current) {
-        if (current->vertice == dest) {
-            return true;
-        }
-        current = current->siguiente;
-    }
-    
-    return false;
+    return findEdgeSlot(graph, raiz, dest) != -1;
 }
 
 // Obtener peso de una arista
@@ -137,15 +86,12 @@ int obtenerPesoArista(Graph* graph, int raiz, int dest) {
         return -1;
     }
     
-    AdjNode* current = graph->adj_list[raiz].raiz;
-    while (current) {
-        if (current->vertice == dest) {
-            return current->peso;
-        }
-        current = current->siguiente;
+    int slot = findEdgeSlot(graph, raiz, dest);
+    if (slot == -1) {
+        return -1; // Arista no encontrada
     }
     
-    return -1; // Arista no encontrada
+    return graph->adj_list[raiz].aristas[slot].peso;
 }
 
 // Obtener grado de un vértice
@@ -154,15 +100,7 @@ int obtenerGrado(Graph* graph, int vertice) {
         return -1;
     }
     
-    int grado = 0;
-    AdjNode* current = graph->adj_list[vertice].raiz;
-    
-    while (current) {
-        grado++;
-        current = current->siguiente;
-    }
-    
-    return grado;
+    return graph->adj_list[vertice].size;
 }
 
 // Obtener todos los vértices adyacentes a uno dado
@@ -179,12 +117,9 @@ int* obtenerAdyacentes(Graph* graph, int vertice, int* numAdyacentes) {
     
     // Crear array para almacenar adyacentes
     int* adyacentes = (int*)malloc(grado * sizeof(int));
-    int index = 0;
-    
-    AdjNode* current = graph->adj_list[vertice].raiz;
-    while (current) {
-        adyacentes[index++] = current->vertice;
-        current = current->siguiente;
+    AdjList* list = &graph->adj_list[vertice];
+    for (int i = 0; i < grado; i++) {
+        adyacentes[i] = list->aristas[i].vertice;
     }
     
     *numAdyacentes = grado;
@@ -202,14 +137,13 @@ void mostrarInfoVertice(Graph* graph, int vertice) {
     printf("Grado: %d\n", obtenerGrado(graph, vertice));
     
     printf("Adyacentes: ");
-    AdjNode* current = graph->adj_list[vertice].raiz;
-    if (!current) {
+    AdjList* list = &graph->adj_list[vertice];
+    if (list->size == 0) {
         printf("(ninguno)");
     }
     
-    while (current) {
-        printf("%d ", current->vertice);
-        current = current->siguiente;
+    for (int i = 0; i < list->size; i++) {
+        printf("%d ", list->aristas[i].vertice);
     }
     printf("\n================================\n");
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "graph.h"
 
+// La matriz ya no se guarda: estas funciones la leen y escriben a través de
+// las listas y el índice de arcos, así que la celda (i, j) vale el peso del
+// arco i -> j o 0 si no existe
+
 // Agregar arista usando matriz de adyacencia
 void addEdgeMatrix(Graph* graph, int src, int dest, int weight) {
     if (!graph || src < 0 || src >= graph->numVertices || 
@@ -8,12 +12,25 @@ void addEdgeMatrix(Graph* graph, int src, int dest, int weight) {
         return;
     }
     
+    // Una celda en 0 equivale a no tener arista
+    if (weight == 0) {
+        removeArc(graph, src, dest);
+        if (!graph->isDirected) {
+            removeArc(graph, dest, src);
+        }
+        return;
+    }
+    
     // Agregar arista en la matriz
-    graph->adjMatrix[src][dest] = weight;
+    if (!insertArc(graph, src, dest, weight)) {
+        printf("❌ Error: No se pudo agregar la arista %d -> %d\n", src, dest);
+        return;
+    }
     
     // Si el grafo no es dirigido, agregar en ambas direcciones
-    if (!graph->isDirected) {
-        graph->adjMatrix[dest][src] = weight;
+    if (!graph->isDirected && !insertArc(graph, dest, src, weight)) {
+        printf("❌ Error: No se pudo agregar la arista %d -> %d\n", dest, src);
+        return;
     }
     
     printf("✅ Arista agregada en matriz: %d -> %d (peso: %d)\n", src, dest, weight);
@@ -27,18 +44,15 @@ void removeEdgeMatrix(Graph* graph, int src, int dest) {
         return;
     }
     
-    // Verificar si la arista existe
-    if (graph->adjMatrix[src][dest] == 0) {
+    // Verificar si la arista existe y removerla
+    if (!removeArc(graph, src, dest)) {
         printf("⚠️  Arista no existe: %d -> %d\n", src, dest);
         return;
     }
     
-    // Remover arista
-    graph->adjMatrix[src][dest] = 0;
-    
     // Si el grafo no es dirigido, remover en ambas direcciones
     if (!graph->isDirected) {
-        graph->adjMatrix[dest][src] = 0;
+        removeArc(graph, dest, src);
     }
     
     printf("✅ Arista removida de matriz: %d -> %d\n", src, dest);
@@ -69,18 +83,29 @@ void printGraphMatrix(Graph* graph) {
     }
     printf("\n");
     
-    // Imprimir filas con datos
+    // Imprimir filas con datos (cada fila se arma desde su lista)
+    int* fila = (int*)calloc(graph->numVertices, sizeof(int));
     for (int i = 0; i < graph->numVertices; i++) {
+        AdjList* list = &graph->adj_list[i];
+        for (int k = 0; k < list->size; k++) {
+            fila[list->aristas[k].vertice] = list->aristas[k].peso;
+        }
+        
         printf("%2d | ", i);
         for (int j = 0; j < graph->numVertices; j++) {
-            if (graph->adjMatrix[i][j] == 0) {
+            if (fila[j] == 0) {
                 printf("   .");
             } else {
-                printf("%4d", graph->adjMatrix[i][j]);
+                printf("%4d", fila[j]);
             }
         }
         printf("\n");
+        
+        for (int k = 0; k < list->size; k++) {
+            fila[list->aristas[k].vertice] = 0;
+        }
     }
+    free(fila);
     printf("================================================\n");
 }
 
@@ -91,7 +116,7 @@ bool existeAristaMatrix(Graph* graph, int src, int dest) {
         return false;
     }
     
-    return graph->adjMatrix[src][dest] != 0;
+    return findEdgeSlot(graph, src, dest) != -1;
 }
 
 // Obtener peso de arista en matriz
@@ -101,96 +126,49 @@ int obtenerPesoMatrix(Graph* graph, int src, int dest) {
         return 0;
     }
     
-    return graph->adjMatrix[src][dest];
+    int slot = findEdgeSlot(graph, src, dest);
+    return slot == -1 ? 0 : graph->adj_list[src].aristas[slot].peso;
 }
 
-// Sincronizar matriz con lista de adyacencia
+// Sincronizar matriz con listas de adyacencia. Las dos representaciones
+// comparten los mismos arreglos, así que ya están sincronizadas siempre
 void sincronizarMatrizConLista(Graph* graph) {
     if (!graph) return;
-    
-    // Limpiar matriz
-    for (int i = 0; i < graph->numVertices; i++) {
-        for (int j = 0; j < graph->numVertices; j++) {
-            graph->adjMatrix[i][j] = 0;
-        }
-    }
-    
-    // Llenar matriz basándose en listas de adyacencia
-    for (int i = 0; i < graph->numVertices; i++) {
-        AdjNode* current = graph->adj_list[i].raiz;
-        while (current) {
-            graph->adjMatrix[i][current->vertice] = current->peso;
-            current = current->siguiente;
-        }
-    }
-    
     printf("✅ Matriz sincronizada con listas de adyacencia\n");
 }
 
-// Sincronizar lista con matriz de adyacencia
+// Sincronizar lista con matriz de adyacencia (no hay nada que copiar)
 void sincronizarListaConMatriz(Graph* graph) {
     if (!graph) return;
-    
-    // Limpiar listas de adyacencia
-    for (int i = 0; i < graph->numVertices; i++) {
-        AdjNode* current = graph->adj_list[i].raiz;
-        while (current) {
-            AdjNode* temp = current;
-            current = current->siguiente;
-            free(temp);
-        }
-        graph->adj_list[i].raiz = NULL;
-    }
-    
-    // Llenar listas basándose en matriz
-    for (int i = 0; i < graph->numVertices; i++) {
-        for (int j = 0; j < graph->numVertices; j++) {
-            if (graph->adjMatrix[i][j] != 0) {
-                AdjNode* newNode = crearAdjNode(j, graph->adjMatrix[i][j]);
-                if (newNode) {
-                    newNode->siguiente = graph->adj_list[i].raiz;
-                    graph->adj_list[i].raiz = newNode;
-                }
-            }
-        }
-    }
-    
     printf("✅ Listas sincronizadas con matriz de adyacencia\n");
 }
 
-// Comparar representaciones (lista vs matriz)
+// Comparar representaciones (listas vs índice de arcos): cada arco de las
+// listas tiene que estar en el índice apuntando a su posición, sin sobrantes
 bool compararRepresentaciones(Graph* graph) {
     if (!graph) return false;
     
+    int totalArcos = 0;
     for (int i = 0; i < graph->numVertices; i++) {
-        for (int j = 0; j < graph->numVertices; j++) {
-            // Verificar si existe en matriz
-            bool existeEnMatriz = (graph->adjMatrix[i][j] != 0);
+        AdjList* list = &graph->adj_list[i];
+        for (int k = 0; k < list->size; k++) {
+            int j = list->aristas[k].vertice;
+            int slot = findEdgeSlot(graph, i, j);
             
-            // Verificar si existe en lista
-            bool existeEnLista = false;
-            AdjNode* current = graph->adj_list[i].raiz;
-            while (current) {
-                if (current->vertice == j) {
-                    existeEnLista = true;
-                    // Verificar también si los pesos coinciden
-                    if (current->peso != graph->adjMatrix[i][j]) {
-                        printf("⚠️  Peso diferente en (%d,%d): Lista=%d, Matriz=%d\n", 
-                               i, j, current->peso, graph->adjMatrix[i][j]);
-                        return false;
-                    }
-                    break;
-                }
-                current = current->siguiente;
-            }
-            
-            // Si no coinciden las representaciones
-            if (existeEnMatriz != existeEnLista) {
-                printf("⚠️  Inconsistencia en (%d,%d): Matriz=%s, Lista=%s\n", 
-                       i, j, existeEnMatriz ? "SÍ" : "NO", existeEnLista ? "SÍ" : "NO");
+            if (slot != k) {
+                printf("⚠️  Inconsistencia en (%d,%d): Lista=posición %d, Índice=%d\n", 
+                       i, j, k, slot);
                 return false;
             }
         }
+        totalArcos += list->size;
+    }
+    
+    // Si no coinciden las cantidades
+    if (totalArcos != graph->numArcs || totalArcos != graph->edgeIndex.count) {
+        printf("⚠️  Inconsistencia en cantidad de arcos: Listas=%d, Contador=%d, Índice=%d\n", 
+               totalArcos, graph->numArcs, graph->edgeIndex.count);
+        return false;
     }
     
     return true;
@@ -200,27 +178,19 @@ bool compararRepresentaciones(Graph* graph) {
 double obtenerDensidad(Graph* graph) {
     if (!graph || graph->numVertices <= 1) return 0.0;
     
-    int aristasActuales = 0;
-    
-    // Contar aristas en la matriz
-    for (int i = 0; i < graph->numVertices; i++) {
-        for (int j = 0; j < graph->numVertices; j++) {
-            if (graph->adjMatrix[i][j] != 0) {
-                aristasActuales++;
-            }
-        }
-    }
+    // Cada arco guardado es una celda no nula de la matriz
+    int aristasActuales = graph->numArcs;
     
-    // Calcular máximo de aristas posibles
-    int maxAristas;
+    // Calcular máximo de aristas posibles (en double: n² desborda int)
+    double maxAristas;
     if (graph->isDirected) {
-        maxAristas = graph->numVertices * (graph->numVertices - 1);
+        maxAristas = (double)graph->numVertices * (graph->numVertices - 1);
     } else {
-        maxAristas = graph->numVertices * (graph->numVertices - 1) / 2;
+        maxAristas = (double)graph->numVertices * (graph->numVertices - 1) / 2;
         aristasActuales /= 2; // En grafo no dirigido, cada arista se cuenta dos veces
     }
     
-    return (double)aristasActuales / maxAristas;
+    return aristasActuales / maxAristas;
 }
 
 // Mostrar estadísticas de la matriz
@@ -236,7 +206,7 @@ void mostrarEstadisticasMatrix(Graph* graph) {
     
     // Verificar consistencia
     bool consistente = compararRepresentaciones(graph);
-    printf("🔄 Consistencia Lista-Matriz: %s\n", consistente ? "✅ SÍ" : "❌ NO");
+    printf("🔄 Consistencia Lista-Índice: %s\n", consistente ? "✅ SÍ" : "❌ NO");
     
     printf("==================================\n");
 }
\ No newline at end of file
@@ -0,0 +1,801 @@
+//
+// Created by administrador on 6/18/25.
+//
+// Jerarquías de contracción (CH). Se contraen los vértices de a uno,
+// eligiendo primero los de menor diferencia de aristas; al contraer v se
+// agrega un atajo u-w por cada par de vecinos cuyo camino más corto pasa
+// por v (lo decide una búsqueda de testigos acotada). Una consulta solo
+// sube de rango desde el origen y desde el destino, por lo que visita una
+// fracción mínima del grafo.
+//
+
+#include "contraction_hierarchy.h"
+#include <string.h>
+#include "../estructura_datos/priority_queue.h"
+#include "../utils/parallel_utils.h"
+
+// =================================================================
+// Grafo dinámico usado durante la contracción
+// =================================================================
+
+typedef struct {
+    int target;
+    int weight;
+    int middle;     // -1 si es una carretera original
+} CHArc;
+
+typedef struct {
+    CHArc* arcs;
+    int count;
+    int capacity;
+} CHArcList;
+
+typedef struct {
+    int numVertices;
+    CHArcList* adj;
+    bool* contracted;
+    int* deletedNeighbors;
+
+    // Búsqueda de testigos: dist vale INF salvo en los vértices tocados
+    int* dist;
+    int* touched;
+    int numTouched;
+    IndexedPriorityQueue* witnessQueue;
+
+    // Atajos que requiere el vértice que se está contrayendo
+    Edge* pending;
+    int numPending;
+    int pendingCapacity;
+} CHBuilder;
+
+// Agregar el arco from -> to o bajar su peso si ya existe
+// Devuelve true si el arco cambió
+static bool addOrImproveArc(CHBuilder* b, int from, int to, int weight, int middle) {
+    CHArcList* list = &b->adj[from];
+
+    for (int i = 0; i < list->count; i++) {
+        if (list->arcs[i].target == to) {
+            if (weight >= list->arcs[i].weight) return false;
+            list->arcs[i].weight = weight;
+            list->arcs[i].middle = middle;
+            return true;
+        }
+    }
+
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 4;
+        list->arcs = (CHArc*)realloc(list->arcs, list->capacity * sizeof(CHArc));
+    }
+
+    list->arcs[list->count].target = to;
+    list->arcs[list->count].weight = weight;
+    list->arcs[list->count].middle = middle;
+    list->count++;
+    return true;
+}
+
+// Dijkstra local desde source que ignora excluded y los vértices ya
+// contraídos. Se corta al superar maxDist o CH_WITNESS_SETTLE_LIMIT; si se
+// corta antes de tiempo solo se agregan atajos de más, nunca de menos.
+static void witnessSearch(CHBuilder* b, int source, int excluded, int maxDist) {
+    for (int i = 0; i < b->numTouched; i++) {
+        b->dist[b->touched[i]] = INF;
+    }
+    b->numTouched = 0;
+    ipqClear(b->witnessQueue);
+
+    b->dist[source] = 0;
+    b->touched[b->numTouched++] = source;
+    ipqPush(b->witnessQueue, source, 0);
+
+    int settled = 0;
+    while (!ipqIsEmpty(b->witnessQueue)) {
+        int d;
+        int u = ipqPopWithPriority(b->witnessQueue, &d);
+        if (d > maxDist || ++settled > CH_WITNESS_SETTLE_LIMIT) break;
+
+        CHArcList* list = &b->adj[u];
+        for (int i = 0; i < list->count; i++) {
+            int v = list->arcs[i].target;
+            if (v == excluded || b->contracted[v]) continue;
+
+            int newDist = d + list->arcs[i].weight;
+            if (newDist < b->dist[v]) {
+                if (b->dist[v] == INF) b->touched[b->numTouched++] = v;
+                b->dist[v] = newDist;
+                if (ipqContains(b->witnessQueue, v)) {
+                    ipqDecreaseKey(b->witnessQueue, v, newDist);
+                } else {
+                    ipqPush(b->witnessQueue, v, newDist);
+                }
+            }
+        }
+    }
+
+    ipqClear(b->witnessQueue);
+}
+
+// Calcular los atajos necesarios para contraer v. Si simulate es false
+// quedan en b->pending para aplicarlos. Devuelve cuántos son.
+static int findShortcuts(CHBuilder* b, int v, bool simulate) {
+    CHArcList* list = &b->adj[v];
+    int shortcuts = 0;
+    b->numPending = 0;
+
+    for (int i = 0; i < list->count; i++) {
+        int u = list->arcs[i].target;
+        if (b->contracted[u]) continue;
+
+        // Cota de la búsqueda: el atajo más largo que podría salir de u
+        int maxVia = 0;
+        for (int j = i + 1; j < list->count; j++) {
+            if (!b->contracted[list->arcs[j].target] && list->arcs[j].weight > maxVia) {
+                maxVia = list->arcs[j].weight;
+            }
+        }
+        if (maxVia == 0) continue;
+
+        witnessSearch(b, u, v, list->arcs[i].weight + maxVia);
+
+        for (int j = i + 1; j < list->count; j++) {
+            int w = list->arcs[j].target;
+            if (b->contracted[w]) continue;
+
+            int via = list->arcs[i].weight + list->arcs[j].weight;
+            if (b->dist[w] <= via) continue;  // Hay un testigo que no pasa por v
+
+            shortcuts++;
+            if (simulate) continue;
+
+            if (b->numPending == b->pendingCapacity) {
+                b->pendingCapacity = b->pendingCapacity ? b->pendingCapacity * 2 : 16;
+                b->pending = (Edge*)realloc(b->pending, b->pendingCapacity * sizeof(Edge));
+            }
+            b->pending[b->numPending].src = u;
+            b->pending[b->numPending].dest = w;
+            b->pending[b->numPending].weight = via;
+            b->numPending++;
+        }
+    }
+
+    return shortcuts;
+}
+
+// Prioridad de contracción: diferencia de aristas (atajos agregados menos
+// aristas eliminadas) más los vecinos ya contraídos, para repartir la
+// contracción de manera uniforme sobre la red
+static int contractionPriority(CHBuilder* b, int v) {
+    int degree = 0;
+    CHArcList* list = &b->adj[v];
+    for (int i = 0; i < list->count; i++) {
+        if (!b->contracted[list->arcs[i].target]) degree++;
+    }
+
+    return findShortcuts(b, v, true) - degree + b->deletedNeighbors[v];
+}
+
+// Armar el grafo ascendente a partir del grafo dinámico y los rangos
+static void buildUpwardGraph(ContractionHierarchy* ch, CHBuilder* b) {
+    int n = b->numVertices;
+    int numArcs = 0;
+
+    for (int u = 0; u < n; u++) {
+        for (int i = 0; i < b->adj[u].count; i++) {
+            if (ch->rank[b->adj[u].arcs[i].target] > ch->rank[u]) numArcs++;
+        }
+    }
+
+    ch->upward = createCSRGraph(n, numArcs, true);
+    ch->middle = (int*)malloc((numArcs > 0 ? numArcs : 1) * sizeof(int));
+
+    int pos = 0;
+    for (int u = 0; u < n; u++) {
+        ch->upward->offsets[u] = pos;
+        for (int i = 0; i < b->adj[u].count; i++) {
+            CHArc* arc = &b->adj[u].arcs[i];
+            if (ch->rank[arc->target] <= ch->rank[u]) continue;
+
+            ch->upward->targets[pos] = arc->target;
+            ch->upward->weights[pos] = arc->weight;
+            ch->middle[pos] = arc->middle;
+            pos++;
+        }
+    }
+    ch->upward->offsets[n] = pos;
+}
+
+// Construir la jerarquía. El grafo debe ser no dirigido y sin pesos negativos.
+ContractionHierarchy* buildContractionHierarchy(const CSRGraph* graph) {
+    if (!graph) return NULL;
+    if (graph->isDirected) {
+        printf("❌ Error: La jerarquía de contracción requiere un grafo no dirigido\n");
+        return NULL;
+    }
+
+    int n = graph->numVertices;
+
+    CHBuilder b;
+    b.numVertices = n;
+    b.adj = (CHArcList*)calloc(n > 0 ? n : 1, sizeof(CHArcList));
+    b.contracted = (bool*)calloc(n > 0 ? n : 1, sizeof(bool));
+    b.deletedNeighbors = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    b.dist = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    b.touched = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    b.numTouched = 0;
+    b.witnessQueue = createIndexedPriorityQueue(n);
+    b.pending = NULL;
+    b.numPending = 0;
+    b.pendingCapacity = 0;
+
+    for (int i = 0; i < n; i++) b.dist[i] = INF;
+
+    // El CSR no dirigido ya guarda cada carretera en ambos sentidos
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (graph->targets[e] != u) {
+                addOrImproveArc(&b, u, graph->targets[e], graph->weights[e], -1);
+            }
+        }
+    }
+
+    ContractionHierarchy* ch = (ContractionHierarchy*)malloc(sizeof(ContractionHierarchy));
+    ch->numVertices = n;
+    ch->numShortcuts = 0;
+    ch->rank = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+
+    IndexedPriorityQueue* order = createIndexedPriorityQueue(n);
+    for (int v = 0; v < n; v++) {
+        ipqPush(order, v, contractionPriority(&b, v));
+    }
+
+    int nextRank = 0;
+    while (!ipqIsEmpty(order)) {
+        int v = ipqPop(order);
+
+        // Actualización perezosa: si la prioridad real empeoró, reinsertar
+        int priority = contractionPriority(&b, v);
+        if (!ipqIsEmpty(order) && priority > ipqGetPriority(order, ipqPeek(order))) {
+            ipqPush(order, v, priority);
+            continue;
+        }
+
+        findShortcuts(&b, v, false);
+        for (int i = 0; i < b.numPending; i++) {
+            Edge* s = &b.pending[i];
+            if (addOrImproveArc(&b, s->src, s->dest, s->weight, v)) ch->numShortcuts++;
+            addOrImproveArc(&b, s->dest, s->src, s->weight, v);
+        }
+
+        b.contracted[v] = true;
+        ch->rank[v] = nextRank++;
+
+        // Los vecinos perdieron una arista: recalcular su prioridad
+        for (int i = 0; i < b.adj[v].count; i++) {
+            int u = b.adj[v].arcs[i].target;
+            if (b.contracted[u]) continue;
+
+            b.deletedNeighbors[u]++;
+            ipqUpdatePriority(order, u, contractionPriority(&b, u));
+        }
+    }
+
+    buildUpwardGraph(ch, &b);
+
+    destroyIndexedPriorityQueue(order);
+    destroyIndexedPriorityQueue(b.witnessQueue);
+    for (int i = 0; i < n; i++) free(b.adj[i].arcs);
+    free(b.adj);
+    free(b.contracted);
+    free(b.deletedNeighbors);
+    free(b.dist);
+    free(b.touched);
+    free(b.pending);
+
+    return ch;
+}
+
+void destroyContractionHierarchy(ContractionHierarchy* ch) {
+    if (!ch) return;
+
+    destroyCSRGraph(ch->upward);
+    free(ch->rank);
+    free(ch->middle);
+    free(ch);
+}
+
+// =================================================================
+// Consulta
+// =================================================================
+
+typedef struct {
+    int* vertices;
+    int length;
+    int capacity;
+} CHPathBuffer;
+
+static void appendPathVertex(CHPathBuffer* buffer, int vertex) {
+    if (buffer->length == buffer->capacity) {
+        buffer->capacity = buffer->capacity ? buffer->capacity * 2 : 16;
+        buffer->vertices = (int*)realloc(buffer->vertices, buffer->capacity * sizeof(int));
+    }
+    buffer->vertices[buffer->length++] = vertex;
+}
+
+// Arco ascendente entre a y b (sale del de menor rango)
+static int findUpwardArc(const ContractionHierarchy* ch, int a, int b) {
+    int low = ch->rank[a] < ch->rank[b] ? a : b;
+    int high = low == a ? b : a;
+
+    for (int e = ch->upward->offsets[low]; e < ch->upward->offsets[low + 1]; e++) {
+        if (ch->upward->targets[e] == high) return e;
+    }
+    return -1;
+}
+
+// Expandir el tramo a -> b en carreteras originales (agrega todo menos a)
+static void unpackSegment(const ContractionHierarchy* ch, int a, int b, CHPathBuffer* out) {
+    int e = findUpwardArc(ch, a, b);
+    if (e == -1 || ch->middle[e] == -1) {
+        appendPathVertex(out, b);
+        return;
+    }
+
+    unpackSegment(ch, a, ch->middle[e], out);
+    unpackSegment(ch, ch->middle[e], b, out);
+}
+
+PathResult* queryContractionHierarchy(const ContractionHierarchy* ch, int source, int target,
+                                      int* settledNodes, int* relaxedEdges) {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    result->path = NULL;
+    result->pathLength = 0;
+    result->totalWeight = INF;
+    result->hasPath = false;
+
+    if (settledNodes) *settledNodes = 0;
+    if (relaxedEdges) *relaxedEdges = 0;
+
+    if (!ch || source < 0 || target < 0 || source >= ch->numVertices || target >= ch->numVertices) {
+        return result;
+    }
+
+    int n = ch->numVertices;
+    const CSRGraph* up = ch->upward;
+
+    int* dist[2];
+    int* parent[2];
+    IndexedPriorityQueue* open[2];
+    for (int d = 0; d < 2; d++) {
+        dist[d] = (int*)malloc(n * sizeof(int));
+        parent[d] = (int*)malloc(n * sizeof(int));
+        open[d] = createIndexedPriorityQueue(n);
+        for (int i = 0; i < n; i++) {
+            dist[d][i] = INF;
+            parent[d][i] = -1;
+        }
+    }
+
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    ipqPush(open[0], source, 0);
+    ipqPush(open[1], target, 0);
+
+    int best = INF;
+    int meeting = -1;
+    int d = 0;
+
+    while (true) {
+        // Una dirección sigue mientras su mínimo pueda mejorar best
+        bool active[2];
+        for (int k = 0; k < 2; k++) {
+            active[k] = !ipqIsEmpty(open[k]) && ipqGetPriority(open[k], ipqPeek(open[k])) < best;
+        }
+        if (!active[0] && !active[1]) break;
+        if (!active[d]) d = 1 - d;
+
+        int u = ipqPop(open[d]);
+        if (settledNodes) (*settledNodes)++;
+
+        if (dist[1 - d][u] != INF && dist[d][u] + dist[1 - d][u] < best) {
+            best = dist[d][u] + dist[1 - d][u];
+            meeting = u;
+        }
+
+        for (int e = up->offsets[u]; e < up->offsets[u + 1]; e++) {
+            int v = up->targets[e];
+            int newDist = dist[d][u] + up->weights[e];
+            if (relaxedEdges) (*relaxedEdges)++;
+
+            if (newDist < dist[d][v]) {
+                dist[d][v] = newDist;
+                parent[d][v] = u;
+                if (ipqContains(open[d], v)) {
+                    ipqDecreaseKey(open[d], v, newDist);
+                } else {
+                    ipqPush(open[d], v, newDist);
+                }
+            }
+        }
+
+        d = 1 - d;
+    }
+
+    if (meeting != -1) {
+        // Subida desde el origen hasta meeting, en orden
+        int upLen = 0;
+        for (int v = meeting; v != -1; v = parent[0][v]) upLen++;
+        int* upPath = (int*)malloc(upLen * sizeof(int));
+        int v = meeting;
+        for (int i = upLen - 1; i >= 0; i--) {
+            upPath[i] = v;
+            v = parent[0][v];
+        }
+
+        CHPathBuffer buffer = {NULL, 0, 0};
+        appendPathVertex(&buffer, source);
+        for (int i = 0; i + 1 < upLen; i++) {
+            unpackSegment(ch, upPath[i], upPath[i + 1], &buffer);
+        }
+        // Bajada desde meeting hasta el destino
+        for (v = meeting; parent[1][v] != -1; v = parent[1][v]) {
+            unpackSegment(ch, v, parent[1][v], &buffer);
+        }
+        free(upPath);
+
+        result->path = buffer.vertices;
+        result->pathLength = buffer.length;
+        result->totalWeight = best;
+        result->hasPath = true;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        free(dist[k]);
+        free(parent[k]);
+        destroyIndexedPriorityQueue(open[k]);
+    }
+    return result;
+}
+
+// =================================================================
+// Tablas de distancias (muchos a muchos)
+// =================================================================
+
+typedef struct {
+    int* dist;          // INF salvo en los vértices tocados
+    int* touched;
+    int numTouched;
+    IndexedPriorityQueue* queue;
+} CHScratch;
+
+// Búsqueda ascendente completa desde source: al terminar, touched tiene
+// el espacio de búsqueda y dist sus distancias
+static void upwardSearch(const ContractionHierarchy* ch, CHScratch* s, int source) {
+    const CSRGraph* up = ch->upward;
+
+    for (int i = 0; i < s->numTouched; i++) s->dist[s->touched[i]] = INF;
+    s->numTouched = 0;
+    ipqClear(s->queue);
+
+    s->dist[source] = 0;
+    s->touched[s->numTouched++] = source;
+    ipqPush(s->queue, source, 0);
+
+    while (!ipqIsEmpty(s->queue)) {
+        int du;
+        int u = ipqPopWithPriority(s->queue, &du);
+
+        for (int e = up->offsets[u]; e < up->offsets[u + 1]; e++) {
+            int v = up->targets[e];
+            int newDist = du + up->weights[e];
+            if (newDist >= s->dist[v]) continue;
+
+            if (s->dist[v] == INF) s->touched[s->numTouched++] = v;
+            s->dist[v] = newDist;
+            if (ipqContains(s->queue, v)) {
+                ipqDecreaseKey(s->queue, v, newDist);
+            } else {
+                ipqPush(s->queue, v, newDist);
+            }
+        }
+    }
+}
+
+typedef struct {
+    const ContractionHierarchy* ch;
+    const int* sources;
+    const int* targets;
+    int numTargets;
+    CHScratch* scratch;          // Uno por hilo
+
+    // Espacio de búsqueda de cada destino
+    int** spaceVertices;
+    int** spaceDists;
+    int* spaceSize;
+
+    // Baldes por vértice: entradas bucketOffsets[v] .. bucketOffsets[v+1]-1
+    int* bucketOffsets;
+    int* bucketTarget;
+    int* bucketDist;
+
+    int* table;
+} CHTableJob;
+
+static void backwardTargetSearch(int j, int threadIndex, void* context) {
+    CHTableJob* job = (CHTableJob*)context;
+    CHScratch* s = &job->scratch[threadIndex];
+    int t = job->targets[j];
+
+    job->spaceSize[j] = 0;
+    job->spaceVertices[j] = NULL;
+    job->spaceDists[j] = NULL;
+    if (t < 0 || t >= job->ch->numVertices) return;
+
+    upwardSearch(job->ch, s, t);
+
+    job->spaceSize[j] = s->numTouched;
+    job->spaceVertices[j] = (int*)malloc(s->numTouched * sizeof(int));
+    job->spaceDists[j] = (int*)malloc(s->numTouched * sizeof(int));
+    for (int i = 0; i < s->numTouched; i++) {
+        job->spaceVertices[j][i] = s->touched[i];
+        job->spaceDists[j][i] = s->dist[s->touched[i]];
+    }
+}
+
+static void forwardSourceSearch(int i, int threadIndex, void* context) {
+    CHTableJob* job = (CHTableJob*)context;
+    CHScratch* s = &job->scratch[threadIndex];
+    int* row = job->table + (long)i * job->numTargets;
+    int source = job->sources[i];
+
+    for (int j = 0; j < job->numTargets; j++) row[j] = INF;
+    if (source < 0 || source >= job->ch->numVertices) return;
+
+    upwardSearch(job->ch, s, source);
+
+    // El camino óptimo pasa por el vértice de mayor rango, que está en
+    // ambos espacios de búsqueda
+    for (int k = 0; k < s->numTouched; k++) {
+        int v = s->touched[k];
+        int dv = s->dist[v];
+        for (int b = job->bucketOffsets[v]; b < job->bucketOffsets[v + 1]; b++) {
+            int candidate = dv + job->bucketDist[b];
+            if (candidate < row[job->bucketTarget[b]]) row[job->bucketTarget[b]] = candidate;
+        }
+    }
+}
+
+int* contractionHierarchyDistanceTable(const ContractionHierarchy* ch, const int* sources, int numSources,
+                                       const int* targets, int numTargets, int numThreads) {
+    if (!ch || numSources < 0 || numTargets < 0 ||
+        (numSources > 0 && !sources) || (numTargets > 0 && !targets)) {
+        return NULL;
+    }
+
+    int n = ch->numVertices;
+    long cells = (long)numSources * numTargets;
+    int* table = (int*)malloc((cells > 0 ? cells : 1) * sizeof(int));
+    if (cells == 0) return table;
+
+    numThreads = resolveThreadCount(numThreads);
+
+    CHTableJob job;
+    job.ch = ch;
+    job.sources = sources;
+    job.targets = targets;
+    job.numTargets = numTargets;
+    job.table = table;
+    job.scratch = (CHScratch*)malloc(numThreads * sizeof(CHScratch));
+    job.spaceVertices = (int**)malloc(numTargets * sizeof(int*));
+    job.spaceDists = (int**)malloc(numTargets * sizeof(int*));
+    job.spaceSize = (int*)malloc(numTargets * sizeof(int));
+
+    for (int t = 0; t < numThreads; t++) {
+        CHScratch* s = &job.scratch[t];
+        s->dist = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        s->touched = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        s->numTouched = 0;
+        s->queue = createIndexedPriorityQueue(n);
+        for (int i = 0; i < n; i++) s->dist[i] = INF;
+    }
+
+    // 1. Búsquedas hacia atrás (el grafo es simétrico: también ascendentes)
+    parallelFor(numTargets, numThreads, backwardTargetSearch, &job);
+
+    // 2. Baldes en formato CSR (conteo por vértice y suma prefija)
+    job.bucketOffsets = (int*)calloc(n + 1, sizeof(int));
+    long totalEntries = 0;
+    for (int j = 0; j < numTargets; j++) {
+        for (int k = 0; k < job.spaceSize[j]; k++) job.bucketOffsets[job.spaceVertices[j][k] + 1]++;
+        totalEntries += job.spaceSize[j];
+    }
+    for (int v = 0; v < n; v++) job.bucketOffsets[v + 1] += job.bucketOffsets[v];
+
+    job.bucketTarget = (int*)malloc((totalEntries > 0 ? totalEntries : 1) * sizeof(int));
+    job.bucketDist = (int*)malloc((totalEntries > 0 ? totalEntries : 1) * sizeof(int));
+    int* cursor = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int v = 0; v < n; v++) cursor[v] = job.bucketOffsets[v];
+
+    for (int j = 0; j < numTargets; j++) {
+        for (int k = 0; k < job.spaceSize[j]; k++) {
+            int pos = cursor[job.spaceVertices[j][k]]++;
+            job.bucketTarget[pos] = j;
+            job.bucketDist[pos] = job.spaceDists[j][k];
+        }
+        free(job.spaceVertices[j]);
+        free(job.spaceDists[j]);
+    }
+    free(cursor);
+
+    // 3. Búsquedas hacia adelante, una fila por origen
+    parallelFor(numSources, numThreads, forwardSourceSearch, &job);
+
+    for (int t = 0; t < numThreads; t++) {
+        free(job.scratch[t].dist);
+        free(job.scratch[t].touched);
+        destroyIndexedPriorityQueue(job.scratch[t].queue);
+    }
+    free(job.scratch);
+    free(job.spaceVertices);
+    free(job.spaceDists);
+    free(job.spaceSize);
+    free(job.bucketOffsets);
+    free(job.bucketTarget);
+    free(job.bucketDist);
+
+    return table;
+}
+
+// =================================================================
+// Persistencia
+// =================================================================
+
+// FNV-1a de la estructura y los pesos del grafo base
+static uint64_t baseGraphChecksum(const CSRGraph* graph) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i <= graph->numVertices; i++) {
+        hash = (hash ^ (uint32_t)graph->offsets[i]) * 0x100000001b3ULL;
+    }
+    for (int e = 0; e < graph->numEdges; e++) {
+        hash = (hash ^ (uint32_t)graph->targets[e]) * 0x100000001b3ULL;
+        hash = (hash ^ (uint32_t)graph->weights[e]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Formato: magic[8], versión, vértices, arcos, atajos, métrica, arcos del
+// grafo base, checksum del grafo base (uint64), rank[n], offsets[n+1],
+// targets[m], weights[m], middle[m] (todo int nativo)
+bool saveContractionHierarchy(const ContractionHierarchy* ch, const CSRGraph* base, int metric,
+                              const char* filename) {
+    if (!ch || !base || !filename) return false;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("❌ Error: No se puede crear el archivo %s\n", filename);
+        return false;
+    }
+
+    char magic[8] = {0};
+    strncpy(magic, CH_FILE_MAGIC, sizeof(magic) - 1);
+    int header[6] = {CH_FILE_VERSION, ch->numVertices, ch->upward->numEdges, ch->numShortcuts,
+                     metric, base->numEdges};
+    uint64_t checksum = baseGraphChecksum(base);
+    int n = ch->numVertices;
+    int m = ch->upward->numEdges;
+
+    bool ok = fwrite(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              fwrite(header, sizeof(int), 6, file) == 6 &&
+              fwrite(&checksum, sizeof(checksum), 1, file) == 1 &&
+              fwrite(ch->rank, sizeof(int), n, file) == (size_t)n &&
+              fwrite(ch->upward->offsets, sizeof(int), n + 1, file) == (size_t)(n + 1) &&
+              fwrite(ch->upward->targets, sizeof(int), m, file) == (size_t)m &&
+              fwrite(ch->upward->weights, sizeof(int), m, file) == (size_t)m &&
+              fwrite(ch->middle, sizeof(int), m, file) == (size_t)m;
+
+    fclose(file);
+
+    if (!ok) printf("❌ Error: Escritura incompleta de %s\n", filename);
+    return ok;
+}
+
+// Offsets no decrecientes de 0 a m, destinos dentro del rango, rank una
+// permutación y cada arco hacia un rango mayor. Cada atajo u -> v puentea
+// un vértice de rango menor que u y v, con los arcos hacia u y v en el
+// grafo ascendente: así unpackSegment baja de rango en cada llamada y
+// ninguna consulta lee fuera de los arreglos ni deja de terminar
+static bool validHierarchy(const ContractionHierarchy* ch) {
+    int n = ch->numVertices;
+    const CSRGraph* upward = ch->upward;
+
+    bool ok = upward->offsets[0] == 0 && upward->offsets[n] == upward->numEdges;
+    for (int i = 0; ok && i < n; i++) {
+        ok = upward->offsets[i] <= upward->offsets[i + 1];
+    }
+
+    bool* seen = ok ? (bool*)calloc(n > 0 ? n : 1, sizeof(bool)) : NULL;
+    ok = ok && seen;
+    for (int v = 0; ok && v < n; v++) {
+        ok = ch->rank[v] >= 0 && ch->rank[v] < n && !seen[ch->rank[v]];
+        if (ok) seen[ch->rank[v]] = true;
+    }
+    free(seen);
+
+    for (int u = 0; ok && u < n; u++) {
+        for (int e = upward->offsets[u]; ok && e < upward->offsets[u + 1]; e++) {
+            int v = upward->targets[e];
+            ok = v >= 0 && v < n && ch->rank[v] > ch->rank[u] && upward->weights[e] >= 0 &&
+                 ch->middle[e] >= -1 && ch->middle[e] < n;
+        }
+    }
+
+    // Los atajos se revisan aparte: findUpwardArc necesita rank y targets válidos
+    for (int u = 0; ok && u < n; u++) {
+        for (int e = upward->offsets[u]; ok && e < upward->offsets[u + 1]; e++) {
+            int w = ch->middle[e];
+            if (w == -1) continue;
+            ok = ch->rank[w] < ch->rank[u] &&
+                 findUpwardArc(ch, w, u) != -1 && findUpwardArc(ch, w, upward->targets[e]) != -1;
+        }
+    }
+    return ok;
+}
+
+ContractionHierarchy* loadContractionHierarchy(const CSRGraph* base, int metric, const char* filename) {
+    if (!base || !filename) return NULL;
+
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("❌ Error: No se puede abrir el archivo %s\n", filename);
+        return NULL;
+    }
+
+    char magic[8];
+    int header[6];
+    uint64_t checksum;
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        strncmp(magic, CH_FILE_MAGIC, strlen(CH_FILE_MAGIC)) != 0 ||
+        fread(header, sizeof(int), 6, file) != 6 ||
+        fread(&checksum, sizeof(checksum), 1, file) != 1 ||
+        header[0] != CH_FILE_VERSION || header[1] < 0 || header[2] < 0) {
+        printf("❌ Error: %s no es una jerarquía de contracción válida\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    // Construida sobre otra red, otra métrica u otros pesos
+    if (header[1] != base->numVertices || header[4] != metric || header[5] != base->numEdges ||
+        checksum != baseGraphChecksum(base)) {
+        printf("❌ Error: La jerarquía de %s no corresponde a la red actual "
+               "(métrica %d, %d vértices, %d arcos)\n", filename, header[4], header[1], header[5]);
+        fclose(file);
+        return NULL;
+    }
+
+    int n = header[1];
+    int m = header[2];
+
+    ContractionHierarchy* ch = (ContractionHierarchy*)malloc(sizeof(ContractionHierarchy));
+    ch->numVertices = n;
+    ch->numShortcuts = header[3];
+    ch->rank = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    ch->upward = createCSRGraph(n, m, true);
+    ch->middle = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+
+    bool ok = ch->upward &&
+              fread(ch->rank, sizeof(int), n, file) == (size_t)n &&
+              fread(ch->upward->offsets, sizeof(int), n + 1, file) == (size_t)(n + 1) &&
+              fread(ch->upward->targets, sizeof(int), m, file) == (size_t)m &&
+              fread(ch->upward->weights, sizeof(int), m, file) == (size_t)m &&
+              fread(ch->middle, sizeof(int), m, file) == (size_t)m &&
+              validHierarchy(ch);
+
+    fclose(file);
+
+    if (!ok) {
+        printf("❌ Error: Archivo de jerarquía truncado o corrupto: %s\n", filename);
+        destroyContractionHierarchy(ch);
+        return NULL;
+    }
+
+    return ch;
+}
@@ -0,0 +1,52 @@
+//
+// Created by administrador on 6/18/25.
+//
+
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../graph/csr_graph.h"
+#include "../algoritmos/common_types.h"
+
+#define CH_FILE_MAGIC "GPSCH"
+#define CH_FILE_VERSION 2
+#define CH_WITNESS_SETTLE_LIMIT 500   // Vértices fijados por búsqueda de testigos
+
+// Jerarquía de contracción sobre un grafo no dirigido.
+// Cada vértice recibe un rango (orden de contracción) y upward guarda solo
+// los arcos hacia vértices de rango mayor, incluidos los atajos. Como el
+// grafo es simétrico, el mismo grafo ascendente sirve para la búsqueda
+// desde el origen y desde el destino.
+typedef struct {
+    int numVertices;
+    int numShortcuts;
+    int* rank;           // rank[v] = posición de v en el orden de contracción
+    CSRGraph* upward;    // Arcos u -> v con rank[v] > rank[u]
+    int* middle;         // Vértice puenteado por cada arco de upward (-1 = carretera original)
+} ContractionHierarchy;
+
+// Preprocesamiento (orden por diferencia de aristas, atajos y testigos)
+ContractionHierarchy* buildContractionHierarchy(const CSRGraph* graph);
+void destroyContractionHierarchy(ContractionHierarchy* ch);
+
+// Consulta bidireccional ascendente; settledNodes/relaxedEdges pueden ser NULL
+PathResult* queryContractionHierarchy(const ContractionHierarchy* ch, int source, int target,
+                                      int* settledNodes, int* relaxedEdges);
+
+// Tabla de distancias numSources x numTargets por filas con el método de
+// baldes: una búsqueda ascendente por destino deja (destino, distancia) en
+// cada vértice alcanzado y la búsqueda de cada origen solo lee esos baldes
+int* contractionHierarchyDistanceTable(const ContractionHierarchy* ch, const int* sources, int numSources,
+                                       const int* targets, int numTargets, int numThreads);
+
+// Persistencia en archivo binario. El archivo lleva la métrica, la
+// cantidad de arcos y un checksum del grafo base sobre el que se
+// construyó: al cargar se rechaza si no coinciden con base y metric
+bool saveContractionHierarchy(const ContractionHierarchy* ch, const CSRGraph* base, int metric,
+                              const char* filename);
+ContractionHierarchy* loadContractionHierarchy(const CSRGraph* base, int metric, const char* filename);
+
+#endif //CONTRACTION_HIERARCHY_H
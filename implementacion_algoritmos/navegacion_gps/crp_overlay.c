@@ -0,0 +1,512 @@
+//
+// Created by administrador on 6/20/25.
+//
+// Customizable route planning (CRP). La partición y las fronteras de cada
+// celda se calculan una sola vez; para cada métrica se guardan, por celda,
+// las distancias entre sus vértices frontera (cliques). Un cambio de
+// tráfico solo obliga a recalcular esas matrices, nivel por nivel y con
+// las celdas de cada nivel repartidas entre hilos.
+//
+
+#include "crp_overlay.h"
+#include <string.h>
+#include "../estructura_datos/priority_queue.h"
+#include "../utils/parallel_utils.h"
+
+#define CELL_OF(o, l, v) ((o)->cellOf[(long)(l) * (o)->numVertices + (v)])
+
+// =================================================================
+// Partición por bisección recursiva de coordenadas
+// =================================================================
+
+typedef struct {
+    double key;
+    int vertex;
+} CRPSortItem;
+
+static int compareSortItems(const void* a, const void* b) {
+    double ka = ((const CRPSortItem*)a)->key;
+    double kb = ((const CRPSortItem*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+// Partir items[lo, hi) por la mediana de la coordenada más extendida hasta
+// llegar a la profundidad depth; cada hoja recibe el siguiente número de celda
+static void bisect(CRPSortItem* items, int lo, int hi, int depth,
+                   const double* x, const double* y, int* leafOf, int* nextLeaf) {
+    if (depth == 0 || hi - lo <= 1) {
+        int leaf = (*nextLeaf)++;
+        for (int i = lo; i < hi; i++) leafOf[items[i].vertex] = leaf;
+        // Una hoja corta igual consume la numeración de todo su subárbol
+        *nextLeaf += (1 << depth) - 1;
+        return;
+    }
+
+    double minX = x[items[lo].vertex], maxX = minX;
+    double minY = y[items[lo].vertex], maxY = minY;
+    for (int i = lo + 1; i < hi; i++) {
+        int v = items[i].vertex;
+        if (x[v] < minX) minX = x[v];
+        if (x[v] > maxX) maxX = x[v];
+        if (y[v] < minY) minY = y[v];
+        if (y[v] > maxY) maxY = y[v];
+    }
+
+    const double* axis = (maxX - minX >= maxY - minY) ? x : y;
+    for (int i = lo; i < hi; i++) items[i].key = axis[items[i].vertex];
+    qsort(items + lo, hi - lo, sizeof(CRPSortItem), compareSortItems);
+
+    int mid = lo + (hi - lo) / 2;
+    bisect(items, lo, mid, depth - 1, x, y, leafOf, nextLeaf);
+    bisect(items, mid, hi, depth - 1, x, y, leafOf, nextLeaf);
+}
+
+// Fronteras y offsets de cliques de un nivel
+static void buildLevelBoundaries(CRPOverlay* o, int level) {
+    int n = o->numVertices;
+    int cells = o->numCells[level];
+    const CSRGraph* g = o->topology;
+
+    o->boundaryOffsets[level] = (int*)calloc(cells + 1, sizeof(int));
+    o->boundaryPos[level] = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+
+    int numBoundary = 0;
+    for (int v = 0; v < n; v++) {
+        o->boundaryPos[level][v] = -1;
+        int c = CELL_OF(o, level, v);
+        for (int e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+            if (CELL_OF(o, level, g->targets[e]) != c) {
+                o->boundaryPos[level][v] = o->boundaryOffsets[level][c + 1]++;
+                numBoundary++;
+                break;
+            }
+        }
+    }
+
+    for (int c = 0; c < cells; c++) {
+        o->boundaryOffsets[level][c + 1] += o->boundaryOffsets[level][c];
+    }
+
+    o->boundary[level] = (int*)malloc((numBoundary > 0 ? numBoundary : 1) * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        if (o->boundaryPos[level][v] != -1) {
+            int c = CELL_OF(o, level, v);
+            o->boundary[level][o->boundaryOffsets[level][c] + o->boundaryPos[level][v]] = v;
+        }
+    }
+
+    o->cliqueOffsets[level] = (long*)malloc((cells + 1) * sizeof(long));
+    o->cliqueOffsets[level][0] = 0;
+    for (int c = 0; c < cells; c++) {
+        long b = o->boundaryOffsets[level][c + 1] - o->boundaryOffsets[level][c];
+        o->cliqueOffsets[level][c + 1] = o->cliqueOffsets[level][c] + b * b;
+    }
+    o->cliqueSize[level] = o->cliqueOffsets[level][cells];
+}
+
+CRPOverlay* buildCRPOverlay(int numVertices, const Edge* edges, int numEdges,
+                            const double* x, const double* y, int cellSize) {
+    if (numVertices < 0 || numEdges < 0 || !x || !y) return NULL;
+    if (cellSize <= 0) cellSize = CRP_DEFAULT_CELL_SIZE;
+
+    int n = numVertices;
+    CRPOverlay* o = (CRPOverlay*)calloc(1, sizeof(CRPOverlay));
+    o->numVertices = n;
+
+    // Topología no dirigida; el peso de cada arco es el id de su arista
+    Edge* ids = (Edge*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(Edge));
+    for (int i = 0; i < numEdges; i++) {
+        ids[i].src = edges[i].src;
+        ids[i].dest = edges[i].dest;
+        ids[i].weight = i;
+    }
+    o->topology = csrFromEdges(n, ids, numEdges, false);
+    free(ids);
+
+    // Profundidad para que las hojas tengan a lo sumo cellSize vértices
+    int depth = 0;
+    while ((n >> depth) > cellSize && depth < 30) depth++;
+
+    int* leafOf = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    CRPSortItem* items = (CRPSortItem*)malloc((n > 0 ? n : 1) * sizeof(CRPSortItem));
+    for (int v = 0; v < n; v++) items[v].vertex = v;
+
+    int nextLeaf = 0;
+    if (n > 0) bisect(items, 0, n, depth, x, y, leafOf, &nextLeaf);
+    free(items);
+
+    // Niveles: el nivel l agrupa las hojas de a 2^(l * FANOUT_BITS)
+    int numLeaves = 1 << depth;
+    while (o->numLevels < CRP_MAX_LEVELS &&
+           ((numLeaves - 1) >> (o->numLevels * CRP_LEVEL_FANOUT_BITS)) > 0) {
+        o->numLevels++;
+    }
+
+    o->cellOf = (int*)malloc(((long)o->numLevels * n > 0 ? (long)o->numLevels * n : 1) * sizeof(int));
+    for (int l = 0; l < o->numLevels; l++) {
+        int shift = l * CRP_LEVEL_FANOUT_BITS;
+        o->numCells[l] = ((numLeaves - 1) >> shift) + 1;
+        for (int v = 0; v < n; v++) {
+            CELL_OF(o, l, v) = leafOf[v] >> shift;
+        }
+        buildLevelBoundaries(o, l);
+    }
+
+    free(leafOf);
+    return o;
+}
+
+void destroyCRPOverlay(CRPOverlay* overlay) {
+    if (!overlay) return;
+
+    for (int l = 0; l < overlay->numLevels; l++) {
+        free(overlay->boundaryOffsets[l]);
+        free(overlay->boundary[l]);
+        free(overlay->boundaryPos[l]);
+        free(overlay->cliqueOffsets[l]);
+    }
+    destroyCSRGraph(overlay->topology);
+    free(overlay->cellOf);
+    free(overlay);
+}
+
+// =================================================================
+// Personalización
+// =================================================================
+
+CRPMetric* createCRPMetric(const CRPOverlay* overlay) {
+    if (!overlay) return NULL;
+
+    CRPMetric* metric = (CRPMetric*)calloc(1, sizeof(CRPMetric));
+    metric->overlay = overlay;
+
+    int numArcs = overlay->topology->numEdges;
+    metric->arcWeights = (int*)malloc((numArcs > 0 ? numArcs : 1) * sizeof(int));
+    for (int l = 0; l < overlay->numLevels; l++) {
+        long size = overlay->cliqueSize[l];
+        metric->cliques[l] = (int*)malloc((size > 0 ? size : 1) * sizeof(int));
+    }
+
+    return metric;
+}
+
+void destroyCRPMetric(CRPMetric* metric) {
+    if (!metric) return;
+
+    for (int l = 0; l < CRP_MAX_LEVELS; l++) free(metric->cliques[l]);
+    free(metric->arcWeights);
+    free(metric);
+}
+
+// Memoria de trabajo de un hilo: dist vale INF salvo en los vértices tocados
+typedef struct {
+    int* dist;
+    int* touched;
+    int numTouched;
+    IndexedPriorityQueue* queue;
+} CRPScratch;
+
+static void initScratch(CRPScratch* s, int n) {
+    s->dist = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    s->touched = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    s->numTouched = 0;
+    s->queue = createIndexedPriorityQueue(n);
+    for (int i = 0; i < n; i++) s->dist[i] = INF;
+}
+
+static void freeScratch(CRPScratch* s) {
+    free(s->dist);
+    free(s->touched);
+    destroyIndexedPriorityQueue(s->queue);
+}
+
+static void resetScratch(CRPScratch* s) {
+    for (int i = 0; i < s->numTouched; i++) s->dist[s->touched[i]] = INF;
+    s->numTouched = 0;
+    ipqClear(s->queue);
+}
+
+static void scratchRelax(CRPScratch* s, int v, int newDist) {
+    if (newDist >= s->dist[v]) return;
+
+    if (s->dist[v] == INF) s->touched[s->numTouched++] = v;
+    s->dist[v] = newDist;
+    if (ipqContains(s->queue, v)) {
+        ipqDecreaseKey(s->queue, v, newDist);
+    } else {
+        ipqPush(s->queue, v, newDist);
+    }
+}
+
+// Arcos que salen de u dentro de la celda c del nivel level, usando las
+// cliques del nivel inferior (o las carreteras si level == 0)
+static void relaxInsideCell(const CRPMetric* m, CRPScratch* s, int level, int c, int u, int du) {
+    const CRPOverlay* o = m->overlay;
+    const CSRGraph* g = o->topology;
+
+    if (level == 0) {
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int w = g->targets[e];
+            if (m->arcWeights[e] >= 0 && CELL_OF(o, 0, w) == c) {
+                scratchRelax(s, w, du + m->arcWeights[e]);
+            }
+        }
+        return;
+    }
+
+    int sub = level - 1;
+    int sc = CELL_OF(o, sub, u);
+    int row = o->boundaryPos[sub][u];
+    int first = o->boundaryOffsets[sub][sc];
+    int b = o->boundaryOffsets[sub][sc + 1] - first;
+    const int* clique = m->cliques[sub] + o->cliqueOffsets[sub][sc] + (long)row * b;
+
+    for (int j = 0; j < b; j++) {
+        if (j != row && clique[j] != INF) {
+            scratchRelax(s, o->boundary[sub][first + j], du + clique[j]);
+        }
+    }
+
+    // Arcos de corte entre subceldas de la misma celda
+    for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+        int w = g->targets[e];
+        if (m->arcWeights[e] >= 0 && CELL_OF(o, sub, w) != sc && CELL_OF(o, level, w) == c) {
+            scratchRelax(s, w, du + m->arcWeights[e]);
+        }
+    }
+}
+
+typedef struct {
+    CRPMetric* metric;
+    int level;
+    CRPScratch* scratch;   // Uno por hilo
+} CRPCustomizeJob;
+
+// Calcular la clique de una celda: Dijkstra desde cada vértice frontera
+static void customizeCell(int c, int threadIndex, void* context) {
+    CRPCustomizeJob* job = (CRPCustomizeJob*)context;
+    CRPMetric* m = job->metric;
+    const CRPOverlay* o = m->overlay;
+    CRPScratch* s = &job->scratch[threadIndex];
+    int level = job->level;
+
+    int first = o->boundaryOffsets[level][c];
+    int b = o->boundaryOffsets[level][c + 1] - first;
+    int* clique = m->cliques[level] + o->cliqueOffsets[level][c];
+
+    for (int i = 0; i < b; i++) {
+        resetScratch(s);
+        scratchRelax(s, o->boundary[level][first + i], 0);
+
+        while (!ipqIsEmpty(s->queue)) {
+            int du;
+            int u = ipqPopWithPriority(s->queue, &du);
+            relaxInsideCell(m, s, level, c, u, du);
+        }
+
+        for (int j = 0; j < b; j++) {
+            clique[(long)i * b + j] = s->dist[o->boundary[level][first + j]];
+        }
+    }
+}
+
+void customizeCRPMetric(CRPMetric* metric, const int* edgeWeights, int numThreads) {
+    if (!metric || !edgeWeights) return;
+
+    const CRPOverlay* o = metric->overlay;
+    const CSRGraph* g = o->topology;
+
+    for (int e = 0; e < g->numEdges; e++) {
+        int w = edgeWeights[g->weights[e]];
+        metric->arcWeights[e] = w >= 0 ? w : -1;
+    }
+
+    numThreads = resolveThreadCount(numThreads);
+
+    CRPCustomizeJob job;
+    job.metric = metric;
+    job.scratch = (CRPScratch*)malloc(numThreads * sizeof(CRPScratch));
+    for (int t = 0; t < numThreads; t++) initScratch(&job.scratch[t], o->numVertices);
+
+    // Cada nivel usa las cliques del anterior: los niveles van en orden
+    for (int l = 0; l < o->numLevels; l++) {
+        job.level = l;
+        parallelFor(o->numCells[l], numThreads, customizeCell, &job);
+    }
+
+    for (int t = 0; t < numThreads; t++) freeScratch(&job.scratch[t]);
+    free(job.scratch);
+}
+
+// =================================================================
+// Consulta
+// =================================================================
+
+// Nivel más alto en el que v está en una celda distinta a la del origen y
+// a la del destino (-1 = se usan las carreteras de v)
+static int queryLevel(const CRPOverlay* o, int v, int source, int target) {
+    for (int l = o->numLevels - 1; l >= 0; l--) {
+        int c = CELL_OF(o, l, v);
+        if (c != CELL_OF(o, l, source) && c != CELL_OF(o, l, target)) return l;
+    }
+    return -1;
+}
+
+// Agregar a path el tramo a -> b dentro de la celda c del nivel level,
+// buscándolo sobre las carreteras (todo menos a)
+static void unpackCliqueArc(const CRPMetric* m, CRPScratch* s, int* parent, int level, int c,
+                            int a, int b, int* path, int* pathLen) {
+    const CRPOverlay* o = m->overlay;
+    const CSRGraph* g = o->topology;
+
+    resetScratch(s);
+    scratchRelax(s, a, 0);
+    parent[a] = -1;
+
+    while (!ipqIsEmpty(s->queue)) {
+        int du;
+        int u = ipqPopWithPriority(s->queue, &du);
+        if (u == b) break;
+
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int w = g->targets[e];
+            if (m->arcWeights[e] < 0 || CELL_OF(o, level, w) != c) continue;
+            if (du + m->arcWeights[e] < s->dist[w]) {
+                scratchRelax(s, w, du + m->arcWeights[e]);
+                parent[w] = u;
+            }
+        }
+    }
+
+    int len = 0;
+    for (int v = b; v != a; v = parent[v]) len++;
+    int v = b;
+    for (int i = len - 1; i >= 0; i--) {
+        path[*pathLen + i] = v;
+        v = parent[v];
+    }
+    *pathLen += len;
+}
+
+PathResult* queryCRP(const CRPMetric* metric, int source, int target,
+                     int* settledNodes, int* relaxedEdges) {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    result->path = NULL;
+    result->pathLength = 0;
+    result->totalWeight = INF;
+    result->hasPath = false;
+
+    if (settledNodes) *settledNodes = 0;
+    if (relaxedEdges) *relaxedEdges = 0;
+
+    if (!metric) return result;
+    const CRPOverlay* o = metric->overlay;
+    const CSRGraph* g = o->topology;
+    int n = o->numVertices;
+    if (source < 0 || target < 0 || source >= n || target >= n) return result;
+
+    int* dist = (int*)malloc(n * sizeof(int));
+    int* parent = (int*)malloc(n * sizeof(int));
+    int* parentLevel = (int*)malloc(n * sizeof(int));  // -1 = carretera, l = clique del nivel l
+    IndexedPriorityQueue* open = createIndexedPriorityQueue(n);
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+        parent[i] = -1;
+    }
+
+    dist[source] = 0;
+    ipqPush(open, source, 0);
+
+    while (!ipqIsEmpty(open)) {
+        int u = ipqPop(open);
+        if (settledNodes) (*settledNodes)++;
+        if (u == target) break;
+
+        int level = queryLevel(o, u, source, target);
+        int c = level >= 0 ? CELL_OF(o, level, u) : -1;
+        int row = level >= 0 ? o->boundaryPos[level][u] : -1;
+
+        // Atravesar la celda de u por su clique
+        if (row != -1) {
+            int first = o->boundaryOffsets[level][c];
+            int b = o->boundaryOffsets[level][c + 1] - first;
+            const int* clique = metric->cliques[level] + o->cliqueOffsets[level][c] + (long)row * b;
+
+            for (int j = 0; j < b; j++) {
+                if (j == row || clique[j] == INF) continue;
+                int v = o->boundary[level][first + j];
+                if (relaxedEdges) (*relaxedEdges)++;
+                if (dist[u] + clique[j] < dist[v]) {
+                    dist[v] = dist[u] + clique[j];
+                    parent[v] = u;
+                    parentLevel[v] = level;
+                    if (ipqContains(open, v)) ipqDecreaseKey(open, v, dist[v]);
+                    else ipqPush(open, v, dist[v]);
+                }
+            }
+        }
+
+        // Carreteras: todas en el nivel base, solo las de corte en los demás
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int v = g->targets[e];
+            if (metric->arcWeights[e] < 0) continue;
+            if (row != -1 && CELL_OF(o, level, v) == c) continue;
+
+            if (relaxedEdges) (*relaxedEdges)++;
+            if (dist[u] + metric->arcWeights[e] < dist[v]) {
+                dist[v] = dist[u] + metric->arcWeights[e];
+                parent[v] = u;
+                parentLevel[v] = -1;
+                if (ipqContains(open, v)) ipqDecreaseKey(open, v, dist[v]);
+                else ipqPush(open, v, dist[v]);
+            }
+        }
+    }
+
+    if (dist[target] != INF) {
+        // Vértices del camino multinivel, de target hacia source
+        int hops = 0;
+        for (int v = target; v != -1; v = parent[v]) hops++;
+        int* overlayPath = (int*)malloc(hops * sizeof(int));
+        int v = target;
+        for (int i = hops - 1; i >= 0; i--) {
+            overlayPath[i] = v;
+            v = parent[v];
+        }
+
+        // Expandir los arcos de clique a carreteras
+        CRPScratch scratch;
+        initScratch(&scratch, n);
+        int* unpackParent = (int*)malloc(n * sizeof(int));
+        int* path = (int*)malloc(n * sizeof(int));
+        int pathLen = 0;
+
+        path[pathLen++] = source;
+        for (int i = 1; i < hops; i++) {
+            int a = overlayPath[i - 1], b = overlayPath[i];
+            int level = parentLevel[b];
+            if (level == -1) {
+                path[pathLen++] = b;
+            } else {
+                unpackCliqueArc(metric, &scratch, unpackParent, level, CELL_OF(o, level, a),
+                                a, b, path, &pathLen);
+            }
+        }
+
+        result->path = path;
+        result->pathLength = pathLen;
+        result->totalWeight = dist[target];
+        result->hasPath = true;
+
+        freeScratch(&scratch);
+        free(unpackParent);
+        free(overlayPath);
+    }
+
+    destroyIndexedPriorityQueue(open);
+    free(dist);
+    free(parent);
+    free(parentLevel);
+    return result;
+}
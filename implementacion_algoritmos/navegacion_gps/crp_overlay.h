@@ -0,0 +1,58 @@
+//
+// Created by administrador on 6/20/25.
+//
+
+#ifndef CRP_OVERLAY_H
+#define CRP_OVERLAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../graph/csr_graph.h"
+#include "../algoritmos/common_types.h"
+
+#define CRP_MAX_LEVELS 4
+#define CRP_DEFAULT_CELL_SIZE 32     // Vértices por celda del nivel más fino
+#define CRP_LEVEL_FANOUT_BITS 3      // Cada celda de nivel l+1 agrupa 2^3 de nivel l
+
+// Partición multinivel de la red (customizable route planning).
+// Solo depende de la topología y de las coordenadas: se calcula una vez y
+// sirve para cualquier métrica. Las celdas están anidadas, así que una
+// celda del nivel l+1 es la unión de celdas del nivel l.
+typedef struct {
+    int numVertices;
+    int numLevels;
+    CSRGraph* topology;                   // weights guarda el id de la arista de cada arco
+    int* cellOf;                          // cellOf[l * numVertices + v]
+    int numCells[CRP_MAX_LEVELS];
+    int* boundaryOffsets[CRP_MAX_LEVELS]; // Frontera de la celda c: boundary[off[c] .. off[c+1]-1]
+    int* boundary[CRP_MAX_LEVELS];        // Vértices con algún arco hacia otra celda
+    int* boundaryPos[CRP_MAX_LEVELS];     // Posición de v en la frontera de su celda (-1 si no está)
+    long* cliqueOffsets[CRP_MAX_LEVELS];  // Inicio de la matriz frontera x frontera de cada celda
+    long cliqueSize[CRP_MAX_LEVELS];
+} CRPOverlay;
+
+// Personalización de la partición para una métrica
+typedef struct {
+    const CRPOverlay* overlay;
+    int* arcWeights;                      // Peso de cada arco de topology (-1 = intransitable)
+    int* cliques[CRP_MAX_LEVELS];         // Distancias entre fronteras dentro de cada celda (INF = sin camino)
+} CRPMetric;
+
+// Preprocesamiento independiente de la métrica (bisección por coordenadas).
+// La arista i une edges[i].src y edges[i].dest; su peso se ignora.
+CRPOverlay* buildCRPOverlay(int numVertices, const Edge* edges, int numEdges,
+                            const double* x, const double* y, int cellSize);
+void destroyCRPOverlay(CRPOverlay* overlay);
+
+// Personalización: edgeWeights[i] es el peso de la arista i (< 0 = cerrada).
+// Las celdas de cada nivel se procesan en paralelo (numThreads <= 0 = todos los núcleos).
+CRPMetric* createCRPMetric(const CRPOverlay* overlay);
+void customizeCRPMetric(CRPMetric* metric, const int* edgeWeights, int numThreads);
+void destroyCRPMetric(CRPMetric* metric);
+
+// Consulta sobre el grafo multinivel; settledNodes/relaxedEdges pueden ser NULL
+PathResult* queryCRP(const CRPMetric* metric, int source, int target,
+                     int* settledNodes, int* relaxedEdges);
+
+#endif //CRP_OVERLAY_H
@@ -0,0 +1,1286 @@
+//
+// Created by administrador on 6/16/25.
+//
+// Búsquedas punto a punto sobre la red de carreteras: Dijkstra
+// unidireccional, Dijkstra bidireccional, A* con heurística Haversine y
+// consultas sobre jerarquías de contracción (contraction_hierarchy.c) y
+// sobre la partición multinivel CRP (crp_overlay.c). Dijkstra y A*
+// dependientes del tiempo usan los perfiles de speed_profile.c.
+// Todas trabajan sobre una vista CSR de la red que se reconstruye solo
+// cuando cambian las carreteras o el tráfico.
+//
+
+#include "gps_system.h"
+#include "../utils/parallel_utils.h"
+
+// Si la carretera entra en la vista de la métrica. Las métricas de tiempo
+// respetan la matriz: un tiempo 0 significa sin arista. El peaje puede ser
+// negativo, así que el peso no sirve para decidir si la carretera está
+bool roadMetricUsable(const Road* road, RouteMetric metric) {
+    switch (metric) {
+        case ROUTE_METRIC_SHORTEST:
+            return (int)road->currentTime > 0;
+        case ROUTE_METRIC_FASTEST:
+            return !road->isClosed && (int)road->currentTime > 0;
+        case ROUTE_METRIC_DISTANCE:
+        case ROUTE_METRIC_TOLL:
+            return !road->isClosed;
+        default:
+            return false;
+    }
+}
+
+// Peso entero de una carretera según la métrica (solo tiene sentido si
+// roadMetricUsable)
+int roadMetricWeight(const Road* road, RouteMetric metric) {
+    switch (metric) {
+        case ROUTE_METRIC_SHORTEST:
+        case ROUTE_METRIC_FASTEST:
+            return (int)road->currentTime;
+        case ROUTE_METRIC_DISTANCE:
+            return (int)(road->distance * 1000);
+        case ROUTE_METRIC_TOLL:
+            return (int)(road->toll * 100);
+        default:
+            return 0;
+    }
+}
+
+// Factor costo/km que nunca sobreestima el costo restante.
+// Se parte de la velocidad máxima de la red y se acota con la arista más
+// "rápida" respecto de su distancia en línea recta; así la heurística
+// h(v) = factor * haversine(v, destino) es consistente aunque los datos
+// de tiempos no respeten los límites de velocidad.
+static double computeHeuristicScale(NavigationSystem* gps, const CSRGraph* graph, RouteMetric metric) {
+    RoadNetwork* net = gps->network;
+
+    int maxSpeed = 0;
+    if (metric == ROUTE_METRIC_SHORTEST || metric == ROUTE_METRIC_FASTEST) {
+        for (int r = 0; r < net->numRoads; r++) {
+            if (net->roads[r].speedLimit > maxSpeed) maxSpeed = net->roads[r].speedLimit;
+        }
+    }
+
+    double scale = maxSpeed > 0 ? 60.0 / maxSpeed : 1e9;
+
+    for (int u = 0; u < graph->numVertices; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            double straight = calculateHaversineDistance(net->cities[u].location, net->cities[v].location);
+            if (straight > 0 && graph->weights[e] / straight < scale) {
+                scale = graph->weights[e] / straight;
+            }
+        }
+    }
+
+    // Con un peso negativo (un descuento) no hay cota admisible
+    return scale > 0 && scale < 1e9 ? scale : 0.0;
+}
+
+// =================================================================
+// Pesos publicados por métrica
+// =================================================================
+
+static RoadWeights* createRoadWeights(CSRGraph* graph, double heuristicScale, long version, long arcsVersion) {
+    RoadWeights* weights = (RoadWeights*)malloc(sizeof(RoadWeights));
+    if (!weights) return NULL;
+
+    weights->graph = graph;
+    weights->heuristicScale = heuristicScale;
+    weights->version = version;
+    weights->arcsVersion = arcsVersion;
+    atomic_init(&weights->hierarchy, NULL);
+    atomic_init(&weights->overlayMetric, NULL);
+    atomic_init(&weights->timeDependent, NULL);
+    atomic_init(&weights->staleDerived, 0);
+    return weights;
+}
+
+static void destroyTimeDependentArcs(void* object) {
+    TimeDependentArcs* td = (TimeDependentArcs*)object;
+    if (!td) return;
+    free(td->arcs);
+    destroySpeedProfileStore(td->profiles);
+    free(td);
+}
+
+static void destroyRoadWeights(void* object) {
+    RoadWeights* weights = (RoadWeights*)object;
+    destroyCSRGraph(weights->graph);
+    destroyContractionHierarchy(atomic_load(&weights->hierarchy));
+    destroyCRPMetric(atomic_load(&weights->overlayMetric));
+    destroyTimeDependentArcs(atomic_load(&weights->timeDependent));
+    free(weights);
+}
+
+static void destroyRetiredHierarchy(void* object) {
+    destroyContractionHierarchy((ContractionHierarchy*)object);
+}
+
+static void destroyRetiredOverlayMetric(void* object) {
+    destroyCRPMetric((CRPMetric*)object);
+}
+
+static void destroyRetiredOverlay(void* object) {
+    destroyCRPOverlay((CRPOverlay*)object);
+}
+
+static void requestRoadRebuild(NavigationSystem* gps);
+static TimeDependentArcs* buildTimeDependentArcs(NavigationSystem* gps, const RoadWeights* weights);
+
+// Jerarquía o cliques CRP de una versión de pesos, según kind
+static void* loadDerived(RoadWeights* weights, int kind) {
+    return kind == ROAD_DERIVED_HIERARCHY ? (void*)atomic_load(&weights->hierarchy)
+                                          : (void*)atomic_load(&weights->overlayMetric);
+}
+
+static void* exchangeDerived(RoadWeights* weights, int kind, void* object) {
+    return kind == ROAD_DERIVED_HIERARCHY
+        ? (void*)atomic_exchange(&weights->hierarchy, (ContractionHierarchy*)object)
+        : (void*)atomic_exchange(&weights->overlayMetric, (CRPMetric*)object);
+}
+
+static EpochDestructor derivedDestructor(int kind) {
+    return kind == ROAD_DERIVED_HIERARCHY ? destroyRetiredHierarchy : destroyRetiredOverlayMetric;
+}
+
+// Pasar la jerarquía y las cliques de published a next (mismos arcos) y
+// marcarlas para rearmar. Devuelve los bits heredados. Requiere writeLock
+static int inheritDerivedStructures(RoadWeights* published, RoadWeights* next) {
+    int inherited = 0;
+    for (int kind = ROAD_DERIVED_HIERARCHY; kind <= ROAD_DERIVED_OVERLAY; kind <<= 1) {
+        void* object = loadDerived(published, kind);
+        if (!object) continue;
+        exchangeDerived(next, kind, object);
+        inherited |= kind;
+    }
+    atomic_store(&next->staleDerived, inherited);
+    return inherited;
+}
+
+// Publicar object, armado con los pesos de built, y devolver lo que debe
+// usar quien lo armó (lo que devuelve vive mientras tenga la época fijada).
+// Va a la versión vigente si es built o si tiene sus mismos arcos y lo que
+// tiene ahí es heredado o nada (entonces queda como heredado y se pide
+// otra pasada). Si no, se cuelga de built y se libera con ella; si built ya
+// tenía uno, object se descarta y se devuelve el de built. Unas cliques de
+// una partición ya reemplazada se descartan (devuelve NULL)
+static void* publishDerivedStructure(NavigationSystem* gps, RouteMetric metric, RoadWeights* built,
+                                     int kind, void* object) {
+    RoadNetwork* net = gps->network;
+    RetiredObject* node = epochReserveRetire();
+
+    pthread_mutex_lock(&gps->writeLock);
+    RoadWeights* current = atomic_load(&net->weights[metric]);
+    bool sameArcs = current && current->arcsVersion == built->arcsVersion;
+    bool currentFresh = current && loadDerived(current, kind) && !(atomic_load(&current->staleDerived) & kind);
+    bool sameOverlay = kind != ROAD_DERIVED_OVERLAY || ((CRPMetric*)object)->overlay == net->overlay;
+
+    if (!sameOverlay) {
+        pthread_mutex_unlock(&gps->writeLock);
+        epochRetireReserved(gps->readers, node, NULL, NULL);
+        derivedDestructor(kind)(object);
+        return NULL;
+    }
+
+    if (node && (current == built || (sameArcs && !currentFresh))) {
+        void* previous = exchangeDerived(current, kind, object);
+        if (current == built) {
+            atomic_fetch_and(&current->staleDerived, ~kind);
+        } else {
+            atomic_fetch_or(&current->staleDerived, kind);
+            requestRoadRebuild(gps);
+        }
+        pthread_mutex_unlock(&gps->writeLock);
+        epochRetireReserved(gps->readers, node, previous, derivedDestructor(kind));
+        return object;
+    }
+
+    void* existing = loadDerived(built, kind);
+    if (!existing) exchangeDerived(built, kind, object);
+    pthread_mutex_unlock(&gps->writeLock);
+    epochRetireReserved(gps->readers, node, NULL, NULL);
+
+    if (!existing) return object;
+    derivedDestructor(kind)(object);
+    return existing;
+}
+
+// Publicar next como versión de la métrica (NULL = reconstruir en la
+// próxima consulta) y retirar la anterior. El nodo de retiro se reserva
+// antes: sin memoria next no se publica (sigue siendo de quien llama) y
+// se devuelve false. Requiere writeLock
+static bool replaceRoadWeights(NavigationSystem* gps, RouteMetric metric, RoadWeights* next) {
+    RoadNetwork* net = gps->network;
+    RetiredObject* node = next ? epochReserveRetire() : NULL;
+    if (next && !node) return false;
+
+    RoadWeights* previous = atomic_exchange(&net->weights[metric], next);
+    if (node) epochRetireReserved(gps->readers, node, previous, destroyRoadWeights);
+    else if (previous) epochRetire(gps->readers, previous, destroyRoadWeights);
+
+    if (!next) {
+        free(net->roadArcs[metric]);
+        net->roadArcs[metric] = NULL;
+    }
+    return true;
+}
+
+// Descartar los pesos publicados (cambiaron los pesos o las carreteras)
+void invalidateRoadGraphs(NavigationSystem* gps) {
+    if (!gps || !gps->network) return;
+
+    pthread_mutex_lock(&gps->writeLock);
+    for (int m = 0; m < ROUTE_METRIC_COUNT; m++) {
+        replaceRoadWeights(gps, (RouteMetric)m, NULL);
+    }
+    pthread_mutex_unlock(&gps->writeLock);
+}
+
+// Escribir el peso nuevo en los dos arcos de la carretera. Con heurística
+// activa se mantiene por debajo del arco más "rápido" (solo puede bajar)
+static void patchRoadArcs(RoadNetwork* net, RoadWeights* weights, RouteMetric metric, int roadId, int weight) {
+    const Road* road = &net->roads[roadId];
+    weights->graph->weights[net->roadArcs[metric][2 * roadId]] = weight;
+    weights->graph->weights[net->roadArcs[metric][2 * roadId + 1]] = weight;
+
+    double straight = calculateHaversineDistance(net->cities[road->from].location,
+                                                 net->cities[road->to].location);
+    if (weights->heuristicScale > 0 && straight > 0 && weight / straight < weights->heuristicScale) {
+        weights->heuristicScale = weight > 0 ? weight / straight : 0.0;
+    }
+}
+
+// Publicar los pesos de un lote de carreteras ya modificadas (previous =
+// estado anterior de cada una). Cada métrica afectada se copia, se corrige
+// entera y recién entonces reemplaza a la publicada, así una búsqueda ve el
+// lote completo o nada de él. La versión nueva hereda la jerarquía y las
+// cliques CRP, que el hilo de reconstrucción rearma sin frenar a nadie; la
+// vista de tiempos (lineal) se rearma acá. Si alguna carretera entra o
+// sale de la vista (se cerró, o su tiempo llegó a 0) no hay nada que
+// heredar y esa métrica se reconstruye en la próxima consulta.
+// Requiere writeLock.
+void publishRoadGraphWeights(NavigationSystem* gps, const int* roadIds, const Road* previous, int count) {
+    if (!gps || !gps->network || count <= 0) return;
+
+    RoadNetwork* net = gps->network;
+    long version = atomic_load(&net->weightsVersion) + 1;
+    bool rebuild = false;
+
+    for (int m = 0; m < ROUTE_METRIC_COUNT; m++) {
+        bool changed = false, entersOrLeaves = false;
+        for (int i = 0; i < count; i++) {
+            const Road* road = &net->roads[roadIds[i]];
+            bool wasUsable = roadMetricUsable(&previous[i], (RouteMetric)m);
+            bool isUsable = roadMetricUsable(road, (RouteMetric)m);
+            if (wasUsable != isUsable) {
+                changed = entersOrLeaves = true;
+            } else if (isUsable && roadMetricWeight(&previous[i], (RouteMetric)m) != roadMetricWeight(road, (RouteMetric)m)) {
+                changed = true;
+            }
+        }
+        if (!changed) continue;
+
+        RoadWeights* published = atomic_load(&net->weights[m]);
+        if (!published) continue;
+
+        CSRGraph* graph = entersOrLeaves ? NULL : csrClone(published->graph);
+        RoadWeights* next = graph
+            ? createRoadWeights(graph, published->heuristicScale, version, published->arcsVersion) : NULL;
+        RetiredObject* node = next ? epochReserveRetire() : NULL;
+        if (!node) {
+            if (next) destroyRoadWeights(next);
+            else destroyCSRGraph(graph);
+            replaceRoadWeights(gps, (RouteMetric)m, NULL);
+            continue;
+        }
+
+        for (int i = 0; i < count; i++) {
+            patchRoadArcs(net, next, (RouteMetric)m, roadIds[i],
+                          roadMetricWeight(&net->roads[roadIds[i]], (RouteMetric)m));
+        }
+        if (atomic_load(&published->timeDependent)) {
+            atomic_store(&next->timeDependent, buildTimeDependentArcs(gps, next));
+        }
+
+        // Sin hilo de reconstrucción no se hereda: la próxima consulta arma
+        // lo suyo. Lo heredado se saca de published recién cuando next ya
+        // está publicada, así ninguna consulta lo ve faltar
+        int inherited = gps->rebuildRunning ? inheritDerivedStructures(published, next) : 0;
+        atomic_store(&net->weights[m], next);
+        if (inherited) {
+            atomic_store(&published->hierarchy, NULL);
+            atomic_store(&published->overlayMetric, NULL);
+            rebuild = true;
+        }
+        epochRetireReserved(gps->readers, node, published, destroyRoadWeights);
+    }
+
+    atomic_fetch_add(&net->weightsVersion, 1);
+    if (rebuild) requestRoadRebuild(gps);
+}
+
+// Cambió la topología (ciudades o carreteras): además rehacer la partición
+void invalidateRoadTopology(NavigationSystem* gps) {
+    if (!gps || !gps->network) return;
+
+    pthread_mutex_lock(&gps->writeLock);
+    invalidateRoadGraphs(gps);
+    gps->network->overlayTopologyDirty = true;
+    pthread_mutex_unlock(&gps->writeLock);
+}
+
+// Cambió qué perfil usa alguna carretera: la vista de tiempos se rearma
+// en la próxima consulta dependiente del tiempo
+void invalidateRoadProfiles(NavigationSystem* gps) {
+    if (!gps || !gps->network) return;
+
+    pthread_mutex_lock(&gps->writeLock);
+    RoadWeights* weights = atomic_load(&gps->network->weights[ROUTE_METRIC_FASTEST]);
+    TimeDependentArcs* td = weights ? atomic_exchange(&weights->timeDependent, NULL) : NULL;
+    if (td) epochRetire(gps->readers, td, destroyTimeDependentArcs);
+    pthread_mutex_unlock(&gps->writeLock);
+}
+
+// Armar la vista CSR de la métrica con los pesos actuales y publicarla.
+// Requiere writeLock
+static RoadWeights* buildRoadWeights(NavigationSystem* gps, RouteMetric metric) {
+    RoadNetwork* net = gps->network;
+    int numRoads = net->numRoads;
+    Edge* edges = (Edge*)malloc((numRoads > 0 ? numRoads : 1) * sizeof(Edge));
+    int* arcs = (int*)malloc((numRoads > 0 ? 2 * numRoads : 1) * sizeof(int));
+    int numEdges = 0;
+
+    // El peso provisorio de cada arco es su carretera: así se sabe
+    // dónde quedó cada una sin depender del orden de csrFromEdges
+    for (int r = 0; r < numRoads; r++) {
+        arcs[2 * r] = arcs[2 * r + 1] = -1;
+        if (!roadMetricUsable(&net->roads[r], metric)) continue;
+
+        edges[numEdges].src = net->roads[r].from;
+        edges[numEdges].dest = net->roads[r].to;
+        edges[numEdges].weight = r;
+        numEdges++;
+    }
+
+    // Las carreteras son de doble mano
+    CSRGraph* graph = csrFromEdges(net->numCities, edges, numEdges, false);
+    free(edges);
+
+    RoadWeights* weights = graph
+        ? createRoadWeights(graph, 0.0, atomic_load(&net->weightsVersion), ++net->arcsBuilt) : NULL;
+    if (!weights) {
+        destroyCSRGraph(graph);
+        free(arcs);
+        return NULL;
+    }
+
+    for (int u = 0; u < graph->numVertices; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int r = graph->weights[e];
+            arcs[2 * r + (net->roads[r].from == u ? 0 : 1)] = e;
+            graph->weights[e] = roadMetricWeight(&net->roads[r], metric);
+        }
+    }
+    weights->heuristicScale = computeHeuristicScale(gps, graph, metric);
+
+    if (!replaceRoadWeights(gps, metric, weights)) {
+        destroyRoadWeights(weights);
+        free(arcs);
+        return NULL;
+    }
+    free(net->roadArcs[metric]);
+    net->roadArcs[metric] = arcs;
+    return weights;
+}
+
+// Pesos vigentes de la métrica, construyéndolos si hace falta
+RoadWeights* getRoadWeights(NavigationSystem* gps, RouteMetric metric) {
+    if (!gps || metric < 0 || metric >= ROUTE_METRIC_COUNT) return NULL;
+
+    RoadWeights* weights = atomic_load(&gps->network->weights[metric]);
+    if (weights) return weights;
+
+    // Otra consulta pudo haberla construido mientras se esperaba el lock
+    pthread_mutex_lock(&gps->writeLock);
+    weights = atomic_load(&gps->network->weights[metric]);
+    if (!weights) weights = buildRoadWeights(gps, metric);
+    pthread_mutex_unlock(&gps->writeLock);
+    return weights;
+}
+
+// Obtener la vista CSR de la red para una métrica
+CSRGraph* getRoadGraph(NavigationSystem* gps, RouteMetric metric) {
+    RoadWeights* weights = getRoadWeights(gps, metric);
+    return weights ? weights->graph : NULL;
+}
+
+static PathResult* createSearchPathResult() {
+    PathResult* result = (PathResult*)malloc(sizeof(PathResult));
+    result->path = NULL;
+    result->pathLength = 0;
+    result->totalWeight = INF;
+    result->hasPath = false;
+    return result;
+}
+
+// Copiar en result el camino que termina en end siguiendo parent
+static void fillPathFromParents(PathResult* result, const int* parent, int end, int totalWeight) {
+    int pathLen = 0;
+    for (int v = end; v != -1; v = parent[v]) pathLen++;
+
+    result->path = (int*)malloc(pathLen * sizeof(int));
+    result->pathLength = pathLen;
+    result->totalWeight = totalWeight;
+    result->hasPath = true;
+
+    int v = end;
+    for (int i = pathLen - 1; i >= 0; i--) {
+        result->path[i] = v;
+        v = parent[v];
+    }
+}
+
+// Dijkstra unidireccional (A* si heuristicScale > 0)
+static PathResult* searchUnidirectional(NavigationSystem* gps, const CSRGraph* graph, int source, int target,
+                                        double heuristicScale, SearchStats* stats) {
+    int n = graph->numVertices;
+    PathResult* result = createSearchPathResult();
+
+    int* dist = (int*)malloc(n * sizeof(int));
+    int* parent = (int*)malloc(n * sizeof(int));
+    bool* settled = (bool*)calloc(n, sizeof(bool));
+    IndexedPriorityQueue* open = createIndexedPriorityQueue(n);
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+        parent[i] = -1;
+    }
+
+    GeoCoordinate goal = gps->network->cities[target].location;
+    #define HEURISTIC(v) (heuristicScale > 0 \
+        ? (int)(heuristicScale * calculateHaversineDistance(gps->network->cities[v].location, goal)) : 0)
+
+    dist[source] = 0;
+    ipqPush(open, source, HEURISTIC(source));
+
+    while (!ipqIsEmpty(open)) {
+        int u = ipqPop(open);
+        settled[u] = true;
+        stats->settledNodes++;
+
+        if (u == target) break;
+
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            stats->relaxedEdges++;
+            if (settled[v]) continue;
+
+            int newDist = dist[u] + graph->weights[e];
+            if (newDist < dist[v]) {
+                dist[v] = newDist;
+                parent[v] = u;
+                int key = newDist + HEURISTIC(v);
+                if (ipqContains(open, v)) {
+                    ipqDecreaseKey(open, v, key);
+                } else {
+                    ipqPush(open, v, key);
+                }
+            }
+        }
+    }
+    #undef HEURISTIC
+
+    if (dist[target] != INF) {
+        fillPathFromParents(result, parent, target, dist[target]);
+    }
+
+    destroyIndexedPriorityQueue(open);
+    free(dist);
+    free(parent);
+    free(settled);
+    return result;
+}
+
+// Dijkstra bidireccional. La red es no dirigida, así que la búsqueda hacia
+// atrás usa el mismo grafo. Se alterna la dirección con menor mínimo y se
+// corta cuando topeAdelante + topeAtrás >= mejor camino encontrado.
+static PathResult* searchBidirectional(const CSRGraph* graph, int source, int target, SearchStats* stats) {
+    int n = graph->numVertices;
+    PathResult* result = createSearchPathResult();
+
+    if (source == target) {
+        result->path = (int*)malloc(sizeof(int));
+        result->path[0] = source;
+        result->pathLength = 1;
+        result->totalWeight = 0;
+        result->hasPath = true;
+        stats->settledNodes = 1;
+        return result;
+    }
+
+    int* dist[2];
+    int* parent[2];
+    bool* settled[2];
+    IndexedPriorityQueue* open[2];
+
+    for (int d = 0; d < 2; d++) {
+        dist[d] = (int*)malloc(n * sizeof(int));
+        parent[d] = (int*)malloc(n * sizeof(int));
+        settled[d] = (bool*)calloc(n, sizeof(bool));
+        open[d] = createIndexedPriorityQueue(n);
+        for (int i = 0; i < n; i++) {
+            dist[d][i] = INF;
+            parent[d][i] = -1;
+        }
+    }
+
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    ipqPush(open[0], source, 0);
+    ipqPush(open[1], target, 0);
+
+    int best = INF;
+    int meeting = -1;
+
+    while (!ipqIsEmpty(open[0]) && !ipqIsEmpty(open[1])) {
+        int topForward = ipqGetPriority(open[0], ipqPeek(open[0]));
+        int topBackward = ipqGetPriority(open[1], ipqPeek(open[1]));
+
+        // Ningún camino por vértices aún abiertos puede mejorar best
+        if (best != INF && (long long)topForward + topBackward >= best) break;
+
+        int d = topForward <= topBackward ? 0 : 1;
+        int other = 1 - d;
+
+        int u = ipqPop(open[d]);
+        settled[d][u] = true;
+        stats->settledNodes++;
+
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            stats->relaxedEdges++;
+            if (settled[d][v]) continue;
+
+            int newDist = dist[d][u] + graph->weights[e];
+            if (newDist >= dist[d][v]) continue;
+
+            dist[d][v] = newDist;
+            parent[d][v] = u;
+            if (ipqContains(open[d], v)) {
+                ipqDecreaseKey(open[d], v, newDist);
+            } else {
+                ipqPush(open[d], v, newDist);
+            }
+
+            // ¿v ya fue alcanzado por la otra búsqueda con un camino mejor?
+            if (dist[other][v] != INF && newDist + dist[other][v] < best) {
+                best = newDist + dist[other][v];
+                meeting = v;
+            }
+        }
+    }
+
+    if (meeting != -1) {
+        // Tramo origen -> meeting por los padres hacia adelante
+        int forwardLen = 0;
+        for (int v = meeting; v != -1; v = parent[0][v]) forwardLen++;
+        int backwardLen = 0;
+        for (int v = parent[1][meeting]; v != -1; v = parent[1][v]) backwardLen++;
+
+        result->pathLength = forwardLen + backwardLen;
+        result->path = (int*)malloc(result->pathLength * sizeof(int));
+        result->totalWeight = best;
+        result->hasPath = true;
+
+        int v = meeting;
+        for (int i = forwardLen - 1; i >= 0; i--) {
+            result->path[i] = v;
+            v = parent[0][v];
+        }
+        // Tramo meeting -> destino por los padres hacia atrás
+        v = parent[1][meeting];
+        for (int i = forwardLen; i < result->pathLength; i++) {
+            result->path[i] = v;
+            v = parent[1][v];
+        }
+    }
+
+    for (int d = 0; d < 2; d++) {
+        free(dist[d]);
+        free(parent[d]);
+        free(settled[d]);
+        destroyIndexedPriorityQueue(open[d]);
+    }
+    return result;
+}
+
+// =================================================================
+// Búsqueda dependiente del tiempo
+// =================================================================
+
+// Vista de tiempos alineada con los arcos de weights. Requiere writeLock
+// y que roadArcs corresponda a esos arcos (la versión vigente o la que la
+// reemplaza con los mismos arcos)
+static TimeDependentArcs* buildTimeDependentArcs(NavigationSystem* gps, const RoadWeights* weights) {
+    RoadNetwork* net = gps->network;
+    const CSRGraph* graph = weights->graph;
+    const int* roadArcs = net->roadArcs[ROUTE_METRIC_FASTEST];
+
+    TimeDependentArcs* td = (TimeDependentArcs*)malloc(sizeof(TimeDependentArcs));
+    if (!td) return NULL;
+    td->arcs = (TimeDependentArc*)malloc((graph->numEdges > 0 ? graph->numEdges : 1) * sizeof(TimeDependentArc));
+    td->profiles = net->profiles ? cloneSpeedProfileStore(net->profiles) : NULL;
+    if (!td->arcs || (net->profiles && !td->profiles) || !roadArcs) {
+        destroyTimeDependentArcs(td);
+        return NULL;
+    }
+
+    for (int e = 0; e < graph->numEdges; e++) {
+        td->arcs[e].baseSeconds = graph->weights[e] * 60;
+        td->arcs[e].profile = -1;
+    }
+
+    for (int r = 0; r < net->numRoads; r++) {
+        const Road* road = &net->roads[r];
+        int profile = r < net->roadProfileSize ? net->roadProfile[r] : -1;
+        int baseSeconds = (int)lround((profile >= 0 ? road->baseTime : road->currentTime) * 60);
+
+        for (int k = 0; k < 2; k++) {
+            int e = roadArcs[2 * r + k];
+            if (e < 0) continue;
+            td->arcs[e].baseSeconds = baseSeconds;
+            td->arcs[e].profile = profile;
+        }
+    }
+
+    // Cota de A*: el arco recorrido a su factor mínimo (truncado como al
+    // evaluarlo) contra la distancia en línea recta
+    double scale = 1e9;
+    for (int u = 0; u < graph->numVertices; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            const TimeDependentArc* arc = &td->arcs[e];
+            long fastest = arc->profile >= 0
+                ? (long)arc->baseSeconds * td->profiles->profiles[arc->profile].minFactor / PROFILE_FACTOR_SCALE
+                : arc->baseSeconds;
+            double straight = calculateHaversineDistance(net->cities[u].location,
+                                                         net->cities[graph->targets[e]].location);
+            if (straight > 0 && fastest / straight < scale) scale = fastest / straight;
+        }
+    }
+    td->heuristicScale = scale < 1e9 ? scale : 0.0;
+    return td;
+}
+
+// Vista de tiempos vigente y su grafo, armándola si hace falta. Lo devuelto
+// sigue vivo mientras quien llama tenga fijada una época
+static TimeDependentArcs* getTimeDependentArcs(NavigationSystem* gps, const CSRGraph** graph) {
+    RoadWeights* weights = getRoadWeights(gps, ROUTE_METRIC_FASTEST);
+    if (!weights) return NULL;
+
+    TimeDependentArcs* td = atomic_load(&weights->timeDependent);
+    if (!td) {
+        pthread_mutex_lock(&gps->writeLock);
+        weights = getRoadWeights(gps, ROUTE_METRIC_FASTEST);
+        td = weights ? atomic_load(&weights->timeDependent) : NULL;
+        if (weights && !td) {
+            td = buildTimeDependentArcs(gps, weights);
+            atomic_store(&weights->timeDependent, td);
+        }
+        pthread_mutex_unlock(&gps->writeLock);
+    }
+
+    if (td) *graph = weights->graph;
+    return td;
+}
+
+// Dijkstra dependiente del tiempo (A* si useHeuristic). La etiqueta de un
+// vértice es su llegada en segundos desde la salida y cada arco se evalúa
+// en ese momento. Con perfiles FIFO llegar antes nunca hace llegar más
+// tarde, así que fijar los vértices en orden de llegada sigue siendo exacto.
+static PathResult* searchTimeDependentArcs(NavigationSystem* gps, const CSRGraph* graph,
+                                           const TimeDependentArcs* td, int source, int target,
+                                           long departure, bool useHeuristic, SearchStats* stats) {
+    int n = graph->numVertices;
+    PathResult* result = createSearchPathResult();
+
+    int* dist = (int*)malloc(n * sizeof(int));
+    int* parent = (int*)malloc(n * sizeof(int));
+    bool* settled = (bool*)calloc(n, sizeof(bool));
+    IndexedPriorityQueue* open = createIndexedPriorityQueue(n);
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+        parent[i] = -1;
+    }
+
+    double heuristicScale = useHeuristic ? td->heuristicScale : 0.0;
+    GeoCoordinate goal = gps->network->cities[target].location;
+    #define HEURISTIC(v) (heuristicScale > 0 \
+        ? (int)(heuristicScale * calculateHaversineDistance(gps->network->cities[v].location, goal)) : 0)
+
+    dist[source] = 0;
+    ipqPush(open, source, HEURISTIC(source));
+
+    while (!ipqIsEmpty(open)) {
+        int u = ipqPop(open);
+        settled[u] = true;
+        stats->settledNodes++;
+
+        if (u == target) break;
+
+        long now = departure + dist[u];
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            stats->relaxedEdges++;
+            if (settled[v]) continue;
+
+            const TimeDependentArc* arc = &td->arcs[e];
+            int travel = arc->profile >= 0
+                ? profileTravelSeconds(td->profiles, arc->profile, arc->baseSeconds, now)
+                : arc->baseSeconds;
+
+            int newDist = dist[u] + travel;
+            if (newDist < dist[v]) {
+                dist[v] = newDist;
+                parent[v] = u;
+                int key = newDist + HEURISTIC(v);
+                if (ipqContains(open, v)) {
+                    ipqDecreaseKey(open, v, key);
+                } else {
+                    ipqPush(open, v, key);
+                }
+            }
+        }
+    }
+    #undef HEURISTIC
+
+    if (dist[target] != INF) {
+        fillPathFromParents(result, parent, target, dist[target]);
+    }
+
+    destroyIndexedPriorityQueue(open);
+    free(dist);
+    free(parent);
+    free(settled);
+    return result;
+}
+
+// Buscar camino entre dos ciudades por id con la métrica y estrategia dadas
+PathResult* searchRoadNetwork(NavigationSystem* gps, int fromId, int toId,
+                              RouteMetric metric, RouteSearchStrategy strategy) {
+    if (!gps || fromId < 0 || toId < 0) return NULL;
+
+    flushStaleTrafficUpdates(gps);
+
+    // Los pesos fijados no se liberan hasta epochExit aunque llegue tráfico
+    int slot = epochEnter(gps->readers);
+    RoadWeights* weights = getRoadWeights(gps, metric);
+
+    // Una vista armada antes de agregar ciudades no las tiene
+    if (!weights || fromId >= weights->graph->numVertices || toId >= weights->graph->numVertices) {
+        epochExit(gps->readers, slot);
+        return NULL;
+    }
+
+    CSRGraph* graph = weights->graph;
+    SearchStats stats = {strategy, 0, 0};
+    PathResult* result;
+
+    // Los descuentos son peajes negativos: con esa vista solo Bellman-Ford
+    // es exacto, sea cual sea la estrategia
+    if (metric == ROUTE_METRIC_TOLL) {
+        result = bellmanFordQueueCSR(graph, fromId, toId);
+    } else {
+        switch (strategy) {
+            case ROUTE_SEARCH_BIDIRECTIONAL:
+                result = searchBidirectional(graph, fromId, toId, &stats);
+                break;
+            case ROUTE_SEARCH_ASTAR:
+                result = searchUnidirectional(gps, graph, fromId, toId, weights->heuristicScale, &stats);
+                break;
+            case ROUTE_SEARCH_CONTRACTION_HIERARCHY: {
+                // El preprocesamiento se hace en la primera consulta si no se cargó
+                ContractionHierarchy* ch = buildRoadHierarchy(gps, metric);
+                result = queryContractionHierarchy(ch, fromId, toId, &stats.settledNodes, &stats.relaxedEdges);
+                break;
+            }
+            case ROUTE_SEARCH_OVERLAY: {
+                CRPMetric* crp = getRoadOverlayMetric(gps, metric);
+                result = queryCRP(crp, fromId, toId, &stats.settledNodes, &stats.relaxedEdges);
+                break;
+            }
+            case ROUTE_SEARCH_DIJKSTRA:
+            default:
+                result = searchUnidirectional(gps, graph, fromId, toId, 0.0, &stats);
+                break;
+        }
+    }
+
+    epochExit(gps->readers, slot);
+
+    // Con consultas concurrentes queda la de alguna de ellas, sin esperar
+    if (pthread_mutex_trylock(&gps->statsLock) == 0) {
+        gps->lastSearchStats = stats;
+        pthread_mutex_unlock(&gps->statsLock);
+    }
+
+    if (gps->debugMode) {
+        printf("🔎 %s: %d vértices fijados, %d arcos examinados\n",
+               routeSearchStrategyName(strategy), stats.settledNodes, stats.relaxedEdges);
+    }
+
+    return result;
+}
+
+// Camino más rápido saliendo en departure según los perfiles de velocidad
+PathResult* searchTimeDependent(NavigationSystem* gps, int fromId, int toId, time_t departure,
+                                RouteSearchStrategy strategy) {
+    if (!gps || fromId < 0 || toId < 0) return NULL;
+
+    flushStaleTrafficUpdates(gps);
+
+    int slot = epochEnter(gps->readers);
+    const CSRGraph* graph = NULL;
+    TimeDependentArcs* td = getTimeDependentArcs(gps, &graph);
+    if (!td || fromId >= graph->numVertices || toId >= graph->numVertices) {
+        epochExit(gps->readers, slot);
+        return NULL;
+    }
+
+    bool useHeuristic = strategy == ROUTE_SEARCH_ASTAR;
+    SearchStats stats = {useHeuristic ? ROUTE_SEARCH_ASTAR : ROUTE_SEARCH_DIJKSTRA, 0, 0};
+    PathResult* result = searchTimeDependentArcs(gps, graph, td, fromId, toId, secondOfWeek(departure),
+                                                 useHeuristic, &stats);
+    epochExit(gps->readers, slot);
+
+    if (pthread_mutex_trylock(&gps->statsLock) == 0) {
+        gps->lastSearchStats = stats;
+        pthread_mutex_unlock(&gps->statsLock);
+    }
+
+    if (gps->debugMode) {
+        printf("🕒 %s dependiente del tiempo: %d vértices fijados, %d arcos examinados\n",
+               routeSearchStrategyName(stats.strategy), stats.settledNodes, stats.relaxedEdges);
+    }
+
+    return result;
+}
+
+void setRouteSearchStrategy(NavigationSystem* gps, RouteSearchStrategy strategy) {
+    if (!gps) return;
+    gps->searchStrategy = strategy;
+
+    // Las rutas cacheadas no dependen de la estrategia, pero se limpian para
+    // que las estadísticas de la próxima consulta sean reales
+    clearRouteCache(gps);
+}
+
+const char* routeSearchStrategyName(RouteSearchStrategy strategy) {
+    switch (strategy) {
+        case ROUTE_SEARCH_DIJKSTRA: return "Dijkstra";
+        case ROUTE_SEARCH_BIDIRECTIONAL: return "Dijkstra bidireccional";
+        case ROUTE_SEARCH_ASTAR: return "A*";
+        case ROUTE_SEARCH_CONTRACTION_HIERARCHY: return "Jerarquía de contracción";
+        case ROUTE_SEARCH_OVERLAY: return "Overlay multinivel (CRP)";
+    }
+    return "Desconocida";
+}
+
+// Comparar las estrategias para un mismo par de ciudades
+void compareSearchStrategies(NavigationSystem* gps, const char* from, const char* to) {
+    City* fromCity = findCity(gps, from);
+    City* toCity = findCity(gps, to);
+
+    if (!fromCity || !toCity) {
+        printf("❌ Error: Ciudad no encontrada\n");
+        return;
+    }
+
+    printf("\n🔬 === COMPARACIÓN DE ESTRATEGIAS: %s → %s ===\n", from, to);
+    printf("%-24s %-10s %-10s %-10s\n", "Estrategia", "Costo", "Fijados", "Arcos");
+
+    RouteSearchStrategy strategies[] = {ROUTE_SEARCH_DIJKSTRA, ROUTE_SEARCH_BIDIRECTIONAL,
+                                        ROUTE_SEARCH_ASTAR, ROUTE_SEARCH_CONTRACTION_HIERARCHY,
+                                        ROUTE_SEARCH_OVERLAY};
+    for (int i = 0; i < 5; i++) {
+        PathResult* result = searchRoadNetwork(gps, fromCity->id, toCity->id,
+                                               ROUTE_METRIC_FASTEST, strategies[i]);
+        printf("%-24s %-10d %-10d %-10d\n", routeSearchStrategyName(strategies[i]),
+               result && result->hasPath ? result->totalWeight : -1,
+               gps->lastSearchStats.settledNodes, gps->lastSearchStats.relaxedEdges);
+        freePathResult(result);
+    }
+    printf("==============================================\n");
+}
+
+// =================================================================
+// Jerarquías de contracción
+// =================================================================
+
+// Contraer los pesos de weights y publicar la jerarquía. Requiere
+// derivedLock y la época fijada; el preprocesamiento no toma writeLock
+static ContractionHierarchy* contractRoadWeights(NavigationSystem* gps, RouteMetric metric, RoadWeights* weights) {
+    clock_t start = clock();
+    ContractionHierarchy* ch = buildContractionHierarchy(weights->graph);
+    if (!ch) return NULL;
+
+    if (gps->debugMode) {
+        printf("🏗️  Jerarquía de contracción: %d vértices, %d atajos, %.1f ms\n",
+               weights->graph->numVertices, ch->numShortcuts,
+               (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    }
+    return (ContractionHierarchy*)publishDerivedStructure(gps, metric, weights, ROAD_DERIVED_HIERARCHY, ch);
+}
+
+// Devolver la jerarquía de los pesos vigentes, construyéndola si hace
+// falta. Tras un lote de tráfico es la heredada hasta que se rearme
+ContractionHierarchy* buildRoadHierarchy(NavigationSystem* gps, RouteMetric metric) {
+    RoadWeights* weights = getRoadWeights(gps, metric);
+    if (!weights) return NULL;
+
+    ContractionHierarchy* ch = atomic_load(&weights->hierarchy);
+    if (ch) return ch;
+
+    // Una sola consulta la construye; las demás esperan y la reutilizan
+    pthread_mutex_lock(&gps->derivedLock);
+    weights = getRoadWeights(gps, metric);
+    ch = weights ? atomic_load(&weights->hierarchy) : NULL;
+    if (weights && !ch) ch = contractRoadWeights(gps, metric, weights);
+    pthread_mutex_unlock(&gps->derivedLock);
+
+    return ch;
+}
+
+// Se guarda la jerarquía de los pesos vigentes junto con ellos como base
+// (si la vigente es heredada se arma la de esos pesos)
+bool saveRoadHierarchy(NavigationSystem* gps, RouteMetric metric, const char* filename) {
+    if (!gps) return false;
+
+    int slot = epochEnter(gps->readers);
+    pthread_mutex_lock(&gps->derivedLock);
+    RoadWeights* weights = getRoadWeights(gps, metric);
+    ContractionHierarchy* ch = weights ? atomic_load(&weights->hierarchy) : NULL;
+    if (weights && (!ch || (atomic_load(&weights->staleDerived) & ROAD_DERIVED_HIERARCHY))) {
+        ch = contractRoadWeights(gps, metric, weights);
+    }
+    bool saved = ch && saveContractionHierarchy(ch, weights->graph, metric, filename);
+    pthread_mutex_unlock(&gps->derivedLock);
+    epochExit(gps->readers, slot);
+    return saved;
+}
+
+// Reemplazar la jerarquía por la guardada en filename. Se rechaza si se
+// generó sobre otra red, otra métrica u otros pesos.
+bool loadRoadHierarchy(NavigationSystem* gps, RouteMetric metric, const char* filename) {
+    if (!gps) return false;
+
+    // Se asocia a los pesos vigentes: el próximo tráfico la hereda
+    int slot = epochEnter(gps->readers);
+    pthread_mutex_lock(&gps->derivedLock);
+    RoadWeights* weights = getRoadWeights(gps, metric);
+    ContractionHierarchy* ch = weights ? loadContractionHierarchy(weights->graph, metric, filename) : NULL;
+    if (ch) publishDerivedStructure(gps, metric, weights, ROAD_DERIVED_HIERARCHY, ch);
+    pthread_mutex_unlock(&gps->derivedLock);
+    epochExit(gps->readers, slot);
+
+    return ch != NULL;
+}
+
+// =================================================================
+// Partición multinivel (CRP)
+// =================================================================
+
+// Preprocesamiento independiente de la métrica: partición por
+// coordenadas y fronteras de cada celda. Solo hace falta repetirlo si
+// cambian las ciudades o las carreteras, no con el tráfico.
+bool buildRoadOverlay(NavigationSystem* gps, int cellSize) {
+    if (!gps) return false;
+
+    RoadNetwork* net = gps->network;
+
+    // Las carreteras se copian con writeLock y la partición se arma sin él
+    pthread_mutex_lock(&gps->writeLock);
+    int n = net->numCities;
+    int numRoads = net->numRoads;
+    Edge* edges = (Edge*)malloc((numRoads > 0 ? numRoads : 1) * sizeof(Edge));
+    double* x = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+    double* y = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+
+    for (int r = 0; r < numRoads; r++) {
+        edges[r].src = net->roads[r].from;
+        edges[r].dest = net->roads[r].to;
+        edges[r].weight = 0;
+    }
+    for (int i = 0; i < n; i++) {
+        x[i] = net->cities[i].location.longitude;
+        y[i] = net->cities[i].location.latitude;
+    }
+    pthread_mutex_unlock(&gps->writeLock);
+
+    clock_t start = clock();
+    CRPOverlay* overlay = buildCRPOverlay(n, edges, numRoads, x, y, cellSize);
+
+    free(edges);
+    free(x);
+    free(y);
+
+    RetiredObject* node = overlay ? epochReserveRetire() : NULL;
+    if (!node) {
+        destroyCRPOverlay(overlay);
+        return false;
+    }
+
+    // Las cliques de la partición vieja se retiran antes que ella. Si
+    // mientras tanto se agregaron ciudades o carreteras, esta ya no sirve
+    pthread_mutex_lock(&gps->writeLock);
+    bool current = net->numCities == n && net->numRoads == numRoads;
+    if (current) {
+        for (int m = 0; m < ROUTE_METRIC_COUNT; m++) {
+            RoadWeights* weights = atomic_load(&net->weights[m]);
+            CRPMetric* previous = weights ? atomic_exchange(&weights->overlayMetric, NULL) : NULL;
+            if (weights) atomic_fetch_and(&weights->staleDerived, ~ROAD_DERIVED_OVERLAY);
+            if (previous) epochRetire(gps->readers, previous, destroyRetiredOverlayMetric);
+        }
+        epochRetireReserved(gps->readers, node, net->overlay, destroyRetiredOverlay);
+        net->overlay = overlay;
+        net->overlayTopologyDirty = false;
+    }
+    pthread_mutex_unlock(&gps->writeLock);
+
+    if (!current) {
+        epochRetireReserved(gps->readers, node, NULL, NULL);
+        destroyCRPOverlay(overlay);
+        return false;
+    }
+
+    if (gps->debugMode) {
+        printf("🧩 Partición CRP: %d niveles, %d celdas en el nivel base, %.1f ms\n",
+               overlay->numLevels, overlay->numLevels > 0 ? overlay->numCells[0] : 1,
+               (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    }
+
+    return true;
+}
+
+// Calcular y publicar las cliques de los pesos vigentes de la métrica.
+// Requiere derivedLock y la época fijada. Con writeLock solo se copian los
+// pesos por carretera (de la vista, así corresponden a esa versión); la
+// personalización corre sin él. Si entretanto cambian las carreteras se
+// vuelve a intentar
+static CRPMetric* customizeOverlayMetric(NavigationSystem* gps, RouteMetric metric, int numThreads) {
+    RoadNetwork* net = gps->network;
+
+    for (int attempt = 0; attempt < 3; attempt++) {
+        pthread_mutex_lock(&gps->writeLock);
+        bool dirty = !net->overlay || net->overlayTopologyDirty;
+        pthread_mutex_unlock(&gps->writeLock);
+        if (dirty && !buildRoadOverlay(gps, CRP_DEFAULT_CELL_SIZE)) continue;
+
+        RoadWeights* weights = getRoadWeights(gps, metric);
+        if (!weights) return NULL;
+
+        pthread_mutex_lock(&gps->writeLock);
+        if (atomic_load(&net->weights[metric]) != weights || !net->overlay || net->overlayTopologyDirty) {
+            pthread_mutex_unlock(&gps->writeLock);
+            continue;
+        }
+        const CRPOverlay* overlay = net->overlay;
+        const int* arcs = net->roadArcs[metric];
+        int* roadWeights = (int*)malloc((net->numRoads > 0 ? net->numRoads : 1) * sizeof(int));
+        for (int r = 0; roadWeights && r < net->numRoads; r++) {
+            roadWeights[r] = arcs[2 * r] >= 0 ? weights->graph->weights[arcs[2 * r]] : -1;
+        }
+        pthread_mutex_unlock(&gps->writeLock);
+
+        CRPMetric* crp = roadWeights ? createCRPMetric(overlay) : NULL;
+        if (!crp) {
+            free(roadWeights);
+            return NULL;
+        }
+        customizeCRPMetric(crp, roadWeights, numThreads);
+        free(roadWeights);
+        crp = (CRPMetric*)publishDerivedStructure(gps, metric, weights, ROAD_DERIVED_OVERLAY, crp);
+        if (crp) return crp;
+    }
+    return NULL;
+}
+
+// Personalizar ya las métricas sin cliques o con las heredadas (por
+// ejemplo tras un lote de tráfico, sin esperar al hilo de reconstrucción)
+void customizeRoadOverlay(NavigationSystem* gps, int numThreads) {
+    if (!gps) return;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int slot = epochEnter(gps->readers);
+    pthread_mutex_lock(&gps->derivedLock);
+    for (int m = 0; m < ROUTE_METRIC_COUNT; m++) {
+        RoadWeights* weights = getRoadWeights(gps, (RouteMetric)m);
+        if (weights && (!atomic_load(&weights->overlayMetric) ||
+                        (atomic_load(&weights->staleDerived) & ROAD_DERIVED_OVERLAY))) {
+            customizeOverlayMetric(gps, (RouteMetric)m, numThreads);
+        }
+    }
+    pthread_mutex_unlock(&gps->derivedLock);
+    epochExit(gps->readers, slot);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (gps->debugMode) {
+        printf("🎛️  Personalización CRP de %d métricas con %d hilos: %.1f ms\n",
+               ROUTE_METRIC_COUNT, resolveThreadCount(numThreads),
+               (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1e6);
+    }
+}
+
+// Métrica personalizada lista para consultar (se arma una vez por versión
+// de arcos; tras un lote de tráfico es la heredada hasta que se rearme)
+CRPMetric* getRoadOverlayMetric(NavigationSystem* gps, RouteMetric metric) {
+    RoadWeights* weights = getRoadWeights(gps, metric);
+    if (!weights) return NULL;
+
+    CRPMetric* crp = atomic_load(&weights->overlayMetric);
+    if (crp) return crp;
+
+    pthread_mutex_lock(&gps->derivedLock);
+    weights = getRoadWeights(gps, metric);
+    crp = weights ? atomic_load(&weights->overlayMetric) : NULL;
+    if (weights && !crp) crp = customizeOverlayMetric(gps, metric, 0);
+    pthread_mutex_unlock(&gps->derivedLock);
+
+    return crp;
+}
+
+// =================================================================
+// Reconstrucción en segundo plano
+// =================================================================
+
+static void requestRoadRebuild(NavigationSystem* gps) {
+    pthread_mutex_lock(&gps->rebuildLock);
+    gps->rebuildPending = true;
+    pthread_cond_signal(&gps->rebuildSignal);
+    pthread_mutex_unlock(&gps->rebuildLock);
+}
+
+// Rearmar lo heredado de la versión vigente de cada métrica. Cada
+// estructura se arma con derivedLock; el tráfico sigue publicando y las
+// consultas siguen usando la heredada mientras tanto
+static void rebuildStaleStructures(NavigationSystem* gps) {
+    for (int m = 0; m < ROUTE_METRIC_COUNT; m++) {
+        for (int kind = ROAD_DERIVED_HIERARCHY; kind <= ROAD_DERIVED_OVERLAY; kind <<= 1) {
+            int slot = epochEnter(gps->readers);
+            pthread_mutex_lock(&gps->derivedLock);
+            RoadWeights* weights = atomic_load(&gps->network->weights[m]);
+            if (weights && (atomic_load(&weights->staleDerived) & kind)) {
+                if (kind == ROAD_DERIVED_HIERARCHY) contractRoadWeights(gps, (RouteMetric)m, weights);
+                else customizeOverlayMetric(gps, (RouteMetric)m, 1);
+            }
+            pthread_mutex_unlock(&gps->derivedLock);
+            epochExit(gps->readers, slot);
+        }
+    }
+}
+
+static void* roadRebuildLoop(void* arg) {
+    NavigationSystem* gps = (NavigationSystem*)arg;
+
+    pthread_mutex_lock(&gps->rebuildLock);
+    while (!gps->rebuildStop) {
+        if (!gps->rebuildPending) {
+            pthread_cond_wait(&gps->rebuildSignal, &gps->rebuildLock);
+            continue;
+        }
+
+        // Los lotes que llegan durante la pasada piden otra
+        gps->rebuildPending = false;
+        gps->rebuildBusy = true;
+        pthread_mutex_unlock(&gps->rebuildLock);
+
+        rebuildStaleStructures(gps);
+
+        pthread_mutex_lock(&gps->rebuildLock);
+        gps->rebuildBusy = false;
+        if (!gps->rebuildPending) pthread_cond_broadcast(&gps->rebuildIdle);
+    }
+    pthread_cond_broadcast(&gps->rebuildIdle);
+    pthread_mutex_unlock(&gps->rebuildLock);
+    return NULL;
+}
+
+bool startRoadRebuilder(NavigationSystem* gps) {
+    if (!gps || gps->rebuildRunning) return false;
+
+    gps->rebuildPending = false;
+    gps->rebuildBusy = false;
+    gps->rebuildStop = false;
+    if (pthread_create(&gps->rebuildThread, NULL, roadRebuildLoop, gps) != 0) {
+        printf("⚠️  Sin hilo de reconstrucción: las consultas rearman las jerarquías\n");
+        return false;
+    }
+    gps->rebuildRunning = true;
+    return true;
+}
+
+// Lo que quede heredado se sigue usando; ya no se rearma
+void stopRoadRebuilder(NavigationSystem* gps) {
+    if (!gps || !gps->rebuildRunning) return;
+
+    pthread_mutex_lock(&gps->rebuildLock);
+    gps->rebuildStop = true;
+    pthread_cond_signal(&gps->rebuildSignal);
+    pthread_mutex_unlock(&gps->rebuildLock);
+
+    pthread_join(gps->rebuildThread, NULL);
+    gps->rebuildRunning = false;
+}
+
+void waitRoadRebuild(NavigationSystem* gps) {
+    if (!gps || !gps->rebuildRunning) return;
+
+    pthread_mutex_lock(&gps->rebuildLock);
+    while ((gps->rebuildPending || gps->rebuildBusy) && !gps->rebuildStop) {
+        pthread_cond_wait(&gps->rebuildIdle, &gps->rebuildLock);
+    }
+    pthread_mutex_unlock(&gps->rebuildLock);
+}
+
+bool roadSearchIsCurrent(NavigationSystem* gps, RouteMetric metric, RouteSearchStrategy strategy) {
+    if (!gps || metric < 0 || metric >= ROUTE_METRIC_COUNT) return false;
+
+    int kind = strategy == ROUTE_SEARCH_CONTRACTION_HIERARCHY ? ROAD_DERIVED_HIERARCHY
+             : strategy == ROUTE_SEARCH_OVERLAY ? ROAD_DERIVED_OVERLAY : 0;
+    if (!kind) return true;
+
+    // Sin versión publicada la consulta arma todo con los pesos vigentes
+    int slot = epochEnter(gps->readers);
+    RoadWeights* weights = atomic_load(&gps->network->weights[metric]);
+    bool current = !weights || !(atomic_load(&weights->staleDerived) & kind);
+    epochExit(gps->readers, slot);
+    return current;
+}
+
+// =================================================================
+// Tablas de distancias
+// =================================================================
+
+int* computeRoadDistanceTable(NavigationSystem* gps, const int* fromIds, int numFrom,
+                              const int* toIds, int numTo, RouteMetric metric, int numThreads) {
+    if (!gps) return NULL;
+
+    int slot = epochEnter(gps->readers);
+    int* table = NULL;
+
+    if (gps->searchStrategy == ROUTE_SEARCH_CONTRACTION_HIERARCHY) {
+        ContractionHierarchy* ch = buildRoadHierarchy(gps, metric);
+        if (ch) table = contractionHierarchyDistanceTable(ch, fromIds, numFrom, toIds, numTo, numThreads);
+    }
+
+    if (!table) {
+        CSRGraph* graph = getRoadGraph(gps, metric);
+        if (graph) table = distanceTable(graph, fromIds, numFrom, toIds, numTo, numThreads);
+    }
+
+    epochExit(gps->readers, slot);
+    return table;
+}
@@ -1,5 +1,8 @@
 #include "gps_system.h"
 
+static void cacheRouteAt(NavigationSystem* gps, int fromId, int toId, RouteMetric metric,
+                         const Route* route, long version);
+
 // Crear sistema de navegación
 NavigationSystem* createNavigationSystem(int maxCities) {
     NavigationSystem* gps = (NavigationSystem*)malloc(sizeof(NavigationSystem));
@@ -12,6 +15,18 @@ NavigationSystem* createNavigationSystem(int maxCities) {
     gps->network->numCities = 0;
     gps->network->numRoads = 0;
     gps->network->capacity = maxCities;
+    for (int m = 0; m < ROUTE_METRIC_COUNT; m++) {
+        atomic_init(&gps->network->weights[m], NULL);
+        gps->network->roadArcs[m] = NULL;
+    }
+    atomic_init(&gps->network->weightsVersion, 0);
+    gps->network->arcsBuilt = 0;
+    atomic_init(&gps->network->roadIndex, NULL);
+    gps->network->overlay = NULL;
+    gps->network->overlayTopologyDirty = true;
+    gps->network->profiles = createSpeedProfileStore();
+    gps->network->roadProfile = NULL;
+    gps->network->roadProfileSize = 0;
     
     // Inicializar matriz de adyacencia
     gps->network->adjacencyMatrix = (int**)malloc(maxCities * sizeof(int*));
@@ -24,15 +39,33 @@ NavigationSystem* createNavigationSystem(int maxCities) {
     
     // Inicializar cola de prioridad para tráfico
     gps->trafficQueue = createPriorityQueue(100, true); // Min-heap
+    gps->trafficBatch = (TrafficBatch*)calloc(1, sizeof(TrafficBatch));
     
     // Inicializar caché de rutas
-    gps->routeCache = (RouteCache*)malloc(sizeof(RouteCache));
-    gps->routeCache->capacity = CACHE_SIZE;
-    gps->routeCache->buckets = (CacheEntry**)calloc(CACHE_SIZE, sizeof(CacheEntry*));
-    gps->routeCache->size = 0;
+    gps->routeCache = createRouteCache(CACHE_SIZE, CACHE_MEMORY_BUDGET);
     
     gps->lastMaintenanceTime = time(NULL);
     gps->debugMode = false;
+    gps->searchStrategy = ROUTE_SEARCH_ASTAR;
+    memset(&gps->lastSearchStats, 0, sizeof(SearchStats));
+
+    // Lectores por épocas y escritores serializados
+    gps->readers = createEpochDomain();
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&gps->writeLock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    pthread_mutex_init(&gps->statsLock, NULL);
+    pthread_rwlock_init(&gps->cityLock, NULL);
+    pthread_mutex_init(&gps->derivedLock, NULL);
+
+    // Las jerarquías que deja vencidas el tráfico se rearman en segundo plano
+    pthread_mutex_init(&gps->rebuildLock, NULL);
+    pthread_cond_init(&gps->rebuildSignal, NULL);
+    pthread_cond_init(&gps->rebuildIdle, NULL);
+    gps->rebuildRunning = false;
+    startRoadRebuilder(gps);
     
     printf("✅ Sistema de navegación GPS creado exitosamente\n");
     printf("   Capacidad máxima: %d ciudades\n", maxCities);
@@ -42,13 +75,18 @@ NavigationSystem* createNavigationSystem(int maxCities) {
 
 // Agregar ciudad al sistema
 int addCity(NavigationSystem* gps, const char* name, double lat, double lon, int population, const char* region) {
-    if (!gps || gps->network->numCities >= gps->network->capacity) {
+    if (!gps) return -1;
+
+    pthread_mutex_lock(&gps->writeLock);
+    if (gps->network->numCities >= gps->network->capacity) {
+        pthread_mutex_unlock(&gps->writeLock);
         printf("❌ Error: No se puede agregar más ciudades\n");
         return -1;
     }
     
     // Verificar si la ciudad ya existe
     if (hashMapGet(gps->cityIndex, name)) {
+        pthread_mutex_unlock(&gps->writeLock);
         printf("⚠️  Ciudad '%s' ya existe en el sistema\n", name);
         return -1;
     }
@@ -65,10 +103,14 @@ int addCity(NavigationSystem* gps, const char* name, double lat, double lon, int
     strncpy(city->region, region, MAX_NAME_LENGTH - 1);
     city->isActive = true;
     
-    // Agregar al HashMap
+    // Agregar al HashMap (las consultas lo leen con findCity)
+    pthread_rwlock_wrlock(&gps->cityLock);
     hashMapPut(gps->cityIndex, name, (void*)(intptr_t)cityId);
-    
     gps->network->numCities++;
+    pthread_rwlock_unlock(&gps->cityLock);
+    
+    invalidateRoadTopology(gps);
+    pthread_mutex_unlock(&gps->writeLock);
     
     if (gps->debugMode) {
         printf("🏙️  Ciudad agregada: %s (ID: %d, Población: %d, Región: %s)\n", 
@@ -82,33 +124,156 @@ int addCity(NavigationSystem* gps, const char* name, double lat, double lon, int
 City* findCity(NavigationSystem* gps, const char* name) {
     if (!gps || !name) return NULL;
     
+    pthread_rwlock_rdlock(&gps->cityLock);
     void* result = hashMapGet(gps->cityIndex, name);
+    int numCities = gps->network->numCities;
+    pthread_rwlock_unlock(&gps->cityLock);
     if (!result) return NULL;
     
     int cityId = (intptr_t)result;
-    if (cityId >= 0 && cityId < gps->network->numCities) {
+    if (cityId >= 0 && cityId < numCities) {
         return &gps->network->cities[cityId];
     }
     
     return NULL;
 }
 
+// =================================================================
+// Índice de carreteras por (ciudad, ciudad)
+// =================================================================
+
+// splitmix64 del par sin orden: (a, b) y (b, a) son la misma carretera
+static uint64_t roadPairHash(int a, int b) {
+    int low = a < b ? a : b, high = a < b ? b : a;
+    uint64_t key = ((uint64_t)(uint32_t)low << 32) | (uint32_t)high;
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+static RoadIndex* createRoadIndex(int size) {
+    RoadIndex* index = (RoadIndex*)malloc(sizeof(RoadIndex));
+    if (!index) return NULL;
+
+    index->slots = (atomic_int*)malloc(size * sizeof(atomic_int));
+    if (!index->slots) {
+        free(index);
+        return NULL;
+    }
+    index->size = size;
+    for (int i = 0; i < size; i++) atomic_init(&index->slots[i], -1);
+    return index;
+}
+
+static void destroyRoadIndex(void* object) {
+    RoadIndex* index = (RoadIndex*)object;
+    if (!index) return;
+    free(index->slots);
+    free(index);
+}
+
+// Insertar la carretera roadId si su par no estaba: como la búsqueda
+// lineal de antes, entre carreteras paralelas gana la primera. El lugar
+// se escribe después de la carretera, así quien lo lee la ve completa
+static void indexRoad(const RoadNetwork* net, RoadIndex* index, int roadId) {
+    int mask = index->size - 1;
+    const Road* road = &net->roads[roadId];
+    int i = (int)(roadPairHash(road->from, road->to) & mask);
+
+    int other;
+    while ((other = atomic_load(&index->slots[i])) != -1) {
+        const Road* existing = &net->roads[other];
+        if ((existing->from == road->from && existing->to == road->to) ||
+            (existing->from == road->to && existing->to == road->from)) return;
+        i = (i + 1) & mask;
+    }
+    atomic_store(&index->slots[i], roadId);
+}
+
+// Índice con lugar para una carretera más: si pasa de la mitad de carga
+// se arma uno del doble, se publica y el viejo se retira. Requiere writeLock
+static RoadIndex* growRoadIndex(NavigationSystem* gps) {
+    RoadNetwork* net = gps->network;
+    RoadIndex* index = atomic_load(&net->roadIndex);
+    if (index && 2 * (net->numRoads + 1) <= index->size) return index;
+
+    int size = index ? index->size : 64;
+    while (size < 2 * (net->numRoads + 1)) size *= 2;
+
+    RoadIndex* grown = createRoadIndex(size);
+    RetiredObject* node = grown ? epochReserveRetire() : NULL;
+    if (!node) {
+        destroyRoadIndex(grown);
+        return NULL;
+    }
+    for (int r = 0; r < net->numRoads; r++) indexRoad(net, grown, r);
+
+    atomic_store(&net->roadIndex, grown);
+    epochRetireReserved(gps->readers, node, index, destroyRoadIndex);
+    return grown;
+}
+
+// Búsqueda en el índice publicado. Quien llama tiene fijada una época o
+// tiene writeLock
+static int lookupRoadId(const RoadNetwork* net, int fromId, int toId) {
+    const RoadIndex* index = atomic_load(&net->roadIndex);
+    if (!index) return -1;
+
+    int mask = index->size - 1;
+    int i = (int)(roadPairHash(fromId, toId) & mask);
+
+    int roadId;
+    while ((roadId = atomic_load(&index->slots[i])) != -1) {
+        const Road* road = &net->roads[roadId];
+        if ((road->from == fromId && road->to == toId) ||
+            (road->from == toId && road->to == fromId)) return roadId;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// Id de la carretera entre dos ciudades (en cualquier sentido), -1 si no hay
+int findRoadId(NavigationSystem* gps, int fromId, int toId) {
+    if (!gps) return -1;
+
+    // addRoad puede reemplazar el índice mientras tanto
+    int slot = epochEnter(gps->readers);
+    int roadId = lookupRoadId(gps->network, fromId, toId);
+    epochExit(gps->readers, slot);
+    return roadId;
+}
+
 // Agregar carretera
 bool addRoad(NavigationSystem* gps, const char* fromCity, const char* toCity, 
              double distance, double travelTime, double toll, const char* roadType, int speedLimit) {
+    if (!gps) return false;
+
+    pthread_mutex_lock(&gps->writeLock);
     City* from = findCity(gps, fromCity);
     City* to = findCity(gps, toCity);
 
     if (!from || !to) {
+        pthread_mutex_unlock(&gps->writeLock);
         printf("❌ Error: Una o ambas ciudades no encontradas (%s, %s)\n", fromCity, toCity);
         return false;
     }
 
     if (from->id == to->id) {
+        pthread_mutex_unlock(&gps->writeLock);
         printf("❌ Error: No se pueden crear carreteras de una ciudad a sí misma\n");
         return false;
     }
 
+    RoadIndex* index = growRoadIndex(gps);
+    if (!index) {
+        pthread_mutex_unlock(&gps->writeLock);
+        printf("❌ Error: No se pudo ampliar el índice de carreteras\n");
+        return false;
+    }
+
     // Crear carretera
     Road* road = &gps->network->roads[gps->network->numRoads];
     road->from = from->id;
@@ -126,10 +291,13 @@ bool addRoad(NavigationSystem* gps, const char* fromCity, const char* toCity,
     gps->network->adjacencyMatrix[from->id][to->id] = (int)travelTime;
     gps->network->adjacencyMatrix[to->id][from->id] = (int)travelTime;
 
+    indexRoad(gps->network, index, gps->network->numRoads);
     gps->network->numRoads++;
+    invalidateRoadTopology(gps);
 
     // Invalidar caché afectado
     clearRouteCache(gps);
+    pthread_mutex_unlock(&gps->writeLock);
 
     if (gps->debugMode) {
         printf("🛣️  Carretera agregada: %s ↔ %s (%.1f km, %.0f min, $%.2f, %s)\n",
@@ -155,8 +323,31 @@ double calculateHaversineDistance(GeoCoordinate p1, GeoCoordinate p2) {
     return R * c;
 }
 
+// Sumar a la ruta la distancia y el peaje de sus carreteras (no cambian
+// después de addRoad) y, con timeGraph, el tiempo de esa vista: leerlo de
+// roads[] mezclaría lotes de tráfico. Requiere una época fijada
+static void accumulateRouteTotals(NavigationSystem* gps, Route* route, const CSRGraph* timeGraph) {
+    for (int i = 0; i < route->pathLength - 1; i++) {
+        int fromId = route->cityPath[i];
+        int toId = route->cityPath[i + 1];
+
+        // Buscar la carretera correspondiente
+        int r = lookupRoadId(gps->network, fromId, toId);
+        if (r >= 0) {
+            route->totalDistance += gps->network->roads[r].distance;
+            route->totalCost += gps->network->roads[r].toll;
+        }
+        if (timeGraph) route->totalTime += csrEdgeWeight(timeGraph, fromId, toId);
+    }
+}
+
 // Implementar algoritmos de búsqueda usando las funciones existentes
 Route* findShortestPath(NavigationSystem* gps, const char* from, const char* to) {
+    return findShortestPathWithStrategy(gps, from, to, gps->searchStrategy);
+}
+
+Route* findShortestPathWithStrategy(NavigationSystem* gps, const char* from, const char* to,
+                                    RouteSearchStrategy strategy) {
     City* fromCity = findCity(gps, from);
     City* toCity = findCity(gps, to);
 
@@ -165,16 +356,21 @@ Route* findShortestPath(NavigationSystem* gps, const char* from, const char* to)
         return NULL;
     }
 
-    // Verificar caché primero
-    Route* cached = getCachedRoute(gps, from, to, "shortest");
+    // Verificar caché primero (después de publicar el tráfico vencido)
+    flushStaleTrafficUpdates(gps);
+    Route* cached = getCachedRoute(gps, fromCity->id, toCity->id, ROUTE_METRIC_SHORTEST);
     if (cached) {
         if (gps->debugMode) printf("🔄 Ruta obtenida del caché\n");
         return cached;
     }
 
-    // Usar Dijkstra para encontrar la ruta más corta
-    PathResult* result = dijkstra(gps->network->adjacencyMatrix, gps->network->numCities,
-                                  fromCity->id, toCity->id);
+    // Buscar sobre la vista CSR de la red con la estrategia elegida; la
+    // versión se toma antes para no cachear una ruta de pesos ya reemplazados,
+    // ni una calculada sobre una jerarquía heredada de pesos anteriores
+    long version = atomic_load(&gps->network->weightsVersion);
+    bool cacheable = roadSearchIsCurrent(gps, ROUTE_METRIC_SHORTEST, strategy);
+    PathResult* result = searchRoadNetwork(gps, fromCity->id, toCity->id,
+                                           ROUTE_METRIC_SHORTEST, strategy);
 
     if (!result || !result->hasPath) {
         printf("❌ No existe ruta entre %s y %s\n", from, to);
@@ -196,24 +392,12 @@ Route* findShortestPath(NavigationSystem* gps, const char* from, const char* to)
     route->totalDistance = 0;
     route->totalCost = 0;
 
-    for (int i = 0; i < route->pathLength - 1; i++) {
-        int fromId = route->cityPath[i];
-        int toId = route->cityPath[i + 1];
-
-        // Buscar la carretera correspondiente
-        for (int r = 0; r < gps->network->numRoads; r++) {
-            Road* road = &gps->network->roads[r];
-            if ((road->from == fromId && road->to == toId) ||
-                (road->from == toId && road->to == fromId)) {
-                route->totalDistance += road->distance;
-                route->totalCost += road->toll;
-                break;
-            }
-        }
-    }
+    int slot = epochEnter(gps->readers);
+    accumulateRouteTotals(gps, route, NULL);
+    epochExit(gps->readers, slot);
 
-    // Cachear la ruta
-    cacheRoute(gps, from, to, route);
+    // Cachear una copia de la ruta
+    if (cacheable) cacheRouteAt(gps, fromCity->id, toCity->id, ROUTE_METRIC_SHORTEST, route, version);
 
     freePathResult(result);
     return route;
@@ -221,27 +405,30 @@ Route* findShortestPath(NavigationSystem* gps, const char* from, const char* to)
 
 // Ruta más rápida (considera tráfico actual)
 Route* findFastestPath(NavigationSystem* gps, const char* from, const char* to) {
+    return findFastestPathWithStrategy(gps, from, to, gps->searchStrategy);
+}
+
+Route* findFastestPathWithStrategy(NavigationSystem* gps, const char* from, const char* to,
+                                   RouteSearchStrategy strategy) {
     City* fromCity = findCity(gps, from);
     City* toCity = findCity(gps, to);
 
     if (!fromCity || !toCity) return NULL;
 
-    // Crear matriz temporal con tiempos actuales (incluyendo tráfico)
-    int** timeMatrix = (int**)malloc(gps->network->numCities * sizeof(int*));
-    for (int i = 0; i < gps->network->numCities; i++) {
-        timeMatrix[i] = (int*)calloc(gps->network->numCities, sizeof(int));
-    }
-
-    // Llenar matriz con tiempos actuales
-    for (int r = 0; r < gps->network->numRoads; r++) {
-        Road* road = &gps->network->roads[r];
-        if (!road->isClosed) {
-            timeMatrix[road->from][road->to] = (int)road->currentTime;
-            timeMatrix[road->to][road->from] = (int)road->currentTime;
-        }
+    // Verificar caché primero (después de publicar el tráfico vencido)
+    flushStaleTrafficUpdates(gps);
+    Route* cached = getCachedRoute(gps, fromCity->id, toCity->id, ROUTE_METRIC_FASTEST);
+    if (cached) {
+        if (gps->debugMode) printf("🔄 Ruta obtenida del caché\n");
+        return cached;
     }
 
-    PathResult* result = dijkstra(timeMatrix, gps->network->numCities, fromCity->id, toCity->id);
+    // La vista CSR de tiempos actuales (sin carreteras cerradas) se mantiene
+    // en la red y solo se reconstruye cuando cambia el tráfico
+    long version = atomic_load(&gps->network->weightsVersion);
+    bool cacheable = roadSearchIsCurrent(gps, ROUTE_METRIC_FASTEST, strategy);
+    PathResult* result = searchRoadNetwork(gps, fromCity->id, toCity->id,
+                                           ROUTE_METRIC_FASTEST, strategy);
 
     Route* route = NULL;
     if (result && result->hasPath) {
@@ -257,27 +444,43 @@ Route* findFastestPath(NavigationSystem* gps, const char* from, const char* to)
         // Calcular distancia y costo
         route->totalDistance = 0;
         route->totalCost = 0;
-        for (int i = 0; i < route->pathLength - 1; i++) {
-            int fromId = route->cityPath[i];
-            int toId = route->cityPath[i + 1];
-
-            for (int r = 0; r < gps->network->numRoads; r++) {
-                Road* road = &gps->network->roads[r];
-                if ((road->from == fromId && road->to == toId) ||
-                    (road->from == toId && road->to == fromId)) {
-                    route->totalDistance += road->distance;
-                    route->totalCost += road->toll;
-                    break;
-                }
-            }
-        }
+        int slot = epochEnter(gps->readers);
+        accumulateRouteTotals(gps, route, NULL);
+        epochExit(gps->readers, slot);
+        if (cacheable) cacheRouteAt(gps, fromCity->id, toCity->id, ROUTE_METRIC_FASTEST, route, version);
     }
 
-    // Limpiar matriz temporal
-    for (int i = 0; i < gps->network->numCities; i++) {
-        free(timeMatrix[i]);
+    if (result) freePathResult(result);
+    return route;
+}
+
+// Ruta más rápida saliendo en departure (tráfico previsto por los perfiles).
+// No se cachea: depende del momento de salida
+Route* findFastestPathAt(NavigationSystem* gps, const char* from, const char* to, time_t departure) {
+    City* fromCity = findCity(gps, from);
+    City* toCity = findCity(gps, to);
+
+    if (!fromCity || !toCity) return NULL;
+
+    PathResult* result = searchTimeDependent(gps, fromCity->id, toCity->id, departure, ROUTE_SEARCH_ASTAR);
+
+    Route* route = NULL;
+    if (result && result->hasPath) {
+        route = (Route*)malloc(sizeof(Route));
+        route->cityPath = (int*)malloc(result->pathLength * sizeof(int));
+        memcpy(route->cityPath, result->path, result->pathLength * sizeof(int));
+        route->pathLength = result->pathLength;
+        route->totalTime = result->totalWeight / 60.0; // Convertir de segundos
+        strcpy(route->routeType, "predicted");
+        route->calculatedTime = time(NULL);
+        route->isValid = true;
+
+        route->totalDistance = 0;
+        route->totalCost = 0;
+        int slot = epochEnter(gps->readers);
+        accumulateRouteTotals(gps, route, NULL);
+        epochExit(gps->readers, slot);
     }
-    free(timeMatrix);
 
     if (result) freePathResult(result);
     return route;
@@ -290,23 +493,12 @@ Route* findCheapestPath(NavigationSystem* gps, const char* from, const char* to)
 
     if (!fromCity || !toCity) return NULL;
 
-    // Crear matriz con costos (usar Bellman-Ford para manejar peajes negativos)
-    int** costMatrix = (int**)malloc(gps->network->numCities * sizeof(int*));
-    for (int i = 0; i < gps->network->numCities; i++) {
-        costMatrix[i] = (int*)calloc(gps->network->numCities, sizeof(int));
-    }
-
-    // Llenar matriz con costos (multiplicar por 100 para evitar decimales)
-    for (int r = 0; r < gps->network->numRoads; r++) {
-        Road* road = &gps->network->roads[r];
-        if (!road->isClosed) {
-            int cost = (int)(road->toll * 100); // Convertir a centavos
-            costMatrix[road->from][road->to] = cost;
-            costMatrix[road->to][road->from] = cost;
-        }
-    }
-
-    PathResult* result = bellmanFord(costMatrix, gps->network->numCities, fromCity->id, toCity->id);
+    // Vista CSR de peajes en centavos con los descuentos como pesos
+    // negativos, por eso Bellman-Ford. Las carreteras son de doble mano: un
+    // descuento alcanzable es un ciclo negativo, y entonces se avisa y no hay
+    // ruta. La época sigue fijada hasta sumar los tiempos de la ruta
+    int slot = epochEnter(gps->readers);
+    PathResult* result = bellmanFordQueueCSR(getRoadGraph(gps, ROUTE_METRIC_TOLL), fromCity->id, toCity->id);
 
     Route* route = NULL;
     if (result && result->hasPath) {
@@ -319,30 +511,16 @@ Route* findCheapestPath(NavigationSystem* gps, const char* from, const char* to)
         route->calculatedTime = time(NULL);
         route->isValid = true;
 
-        // Calcular distancia y tiempo
+        // Calcular distancia y tiempo (de una sola vista de tiempos); el
+        // costo ya viene de la búsqueda
         route->totalDistance = 0;
         route->totalTime = 0;
-        for (int i = 0; i < route->pathLength - 1; i++) {
-            int fromId = route->cityPath[i];
-            int toId = route->cityPath[i + 1];
-
-            for (int r = 0; r < gps->network->numRoads; r++) {
-                Road* road = &gps->network->roads[r];
-                if ((road->from == fromId && road->to == toId) ||
-                    (road->from == toId && road->to == fromId)) {
-                    route->totalDistance += road->distance;
-                    route->totalTime += road->currentTime;
-                    break;
-                }
-            }
-        }
+        double cost = route->totalCost;
+        const CSRGraph* timeGraph = getRoadGraph(gps, ROUTE_METRIC_FASTEST);
+        accumulateRouteTotals(gps, route, timeGraph);
+        route->totalCost = cost;
     }
-
-    // Limpiar matriz temporal
-    for (int i = 0; i < gps->network->numCities; i++) {
-        free(costMatrix[i]);
-    }
-    free(costMatrix);
+    epochExit(gps->readers, slot);
 
     if (result) freePathResult(result);
     return route;
@@ -356,8 +534,15 @@ bool isReachable(NavigationSystem* gps, const char* from, const char* to) {
     if (!fromCity || !toCity) return false;
     if (fromCity->id == toCity->id) return true;
 
-    return isConnected(gps->network->adjacencyMatrix, gps->network->numCities,
-                      fromCity->id, toCity->id);
+    // BFS sobre la vista de distancias (la matriz de adyacencia la reescribe
+    // el tráfico sin sincronización)
+    int slot = epochEnter(gps->readers);
+    SearchResult* result = bfsCSR(getRoadGraph(gps, ROUTE_METRIC_SHORTEST), fromCity->id);
+    bool reachable = result && result->visited[toCity->id];
+    epochExit(gps->readers, slot);
+
+    if (result) freeSearchResult(result);
+    return reachable;
 }
 
 // Actualizar condiciones de tráfico
@@ -370,27 +555,12 @@ void updateTrafficConditions(NavigationSystem* gps, const char* fromCity, const
         return;
     }
 
-    // Buscar y actualizar la carretera
-    bool roadFound = false;
-    for (int r = 0; r < gps->network->numRoads; r++) {
-        Road* road = &gps->network->roads[r];
-        if ((road->from == from->id && road->to == to->id) ||
-            (road->from == to->id && road->to == from->id)) {
-            road->currentTime = road->baseTime * trafficFactor;
-            road->lastUpdate = time(NULL);
-            roadFound = true;
-
-            // Actualizar matriz de adyacencia
-            gps->network->adjacencyMatrix[road->from][road->to] = (int)road->currentTime;
-            gps->network->adjacencyMatrix[road->to][road->from] = (int)road->currentTime;
-
-            break;
-        }
-    }
-
-    if (roadFound) {
-        // Invalidar caché de rutas afectadas
-        clearRouteCache(gps);
+    // Va al lote pendiente como cualquier otra actualización: se combina y
+    // se publica una vez por ventana, sin copiar las vistas en cada llamada
+    int roadId = findRoadId(gps, from->id, to->id);
+    if (roadId >= 0) {
+        TrafficUpdate update = {roadId, from->id, to->id, trafficFactor, time(NULL), 0};
+        ingestTrafficUpdates(gps, &update, 1);
 
         if (gps->debugMode) {
             printf("🚦 Tráfico actualizado: %s ↔ %s (factor: %.2f)\n",
@@ -401,6 +571,338 @@ void updateTrafficConditions(NavigationSystem* gps, const char* fromCity, const
     }
 }
 
+// Encolar una actualización por id de carretera (menor prioridad primero)
+bool queueTrafficUpdate(NavigationSystem* gps, int roadId, double trafficFactor, int priority) {
+    if (!gps || roadId < 0 || roadId >= gps->network->numRoads || trafficFactor <= 0) {
+        printf("❌ Error: Actualización de tráfico inválida (carretera %d)\n", roadId);
+        return false;
+    }
+
+    TrafficUpdate* update = (TrafficUpdate*)malloc(sizeof(TrafficUpdate));
+    if (!update) return false;
+
+    update->roadId = roadId;
+    update->fromCity = gps->network->roads[roadId].from;
+    update->toCity = gps->network->roads[roadId].to;
+    update->trafficFactor = trafficFactor;
+    update->timestamp = time(NULL);
+    update->priority = priority;
+
+    pthread_mutex_lock(&gps->writeLock);
+    bool queued = pqPush(gps->trafficQueue, update, priority);
+    pthread_mutex_unlock(&gps->writeLock);
+
+    if (!queued) free(update);
+    return queued;
+}
+
+// Aplicar todas las actualizaciones encoladas en un solo lote
+void processTrafficUpdates(NavigationSystem* gps) {
+    if (!gps || !gps->trafficQueue) return;
+
+    pthread_mutex_lock(&gps->writeLock);
+    while (!pqIsEmpty(gps->trafficQueue)) {
+        TrafficUpdate* update = (TrafficUpdate*)pqPop(gps->trafficQueue);
+        ingestTrafficUpdates(gps, update, 1);
+        free(update);
+    }
+
+    publishTrafficUpdates(gps);
+    pthread_mutex_unlock(&gps->writeLock);
+}
+
+// Asegurar lugar en el lote para la carretera roadId y una actualización más
+static bool reserveTrafficBatch(TrafficBatch* batch, int numRoads) {
+    if (batch->numRoadSlots < numRoads) {
+        int* slots = (int*)realloc(batch->slotOfRoad, numRoads * sizeof(int));
+        if (!slots) return false;
+        for (int r = batch->numRoadSlots; r < numRoads; r++) slots[r] = -1;
+        batch->slotOfRoad = slots;
+        batch->numRoadSlots = numRoads;
+    }
+
+    if (batch->count == batch->capacity) {
+        int capacity = batch->capacity > 0 ? batch->capacity * 2 : 256;
+        TrafficUpdate* updates = (TrafficUpdate*)realloc(batch->updates, capacity * sizeof(TrafficUpdate));
+        if (!updates) return false;
+        batch->updates = updates;
+        batch->capacity = capacity;
+    }
+    return true;
+}
+
+// Acumular un arreglo de actualizaciones. Por carretera queda solo la de
+// timestamp más reciente (a igual timestamp, la última del arreglo); las
+// anteriores a lo ya aplicado se descartan. Devuelve cuántas se aceptaron.
+int ingestTrafficUpdates(NavigationSystem* gps, const TrafficUpdate* updates, int count) {
+    if (!gps || !gps->trafficBatch || (!updates && count > 0)) return 0;
+
+    TrafficBatch* batch = gps->trafficBatch;
+    RoadNetwork* net = gps->network;
+    time_t now = time(NULL);
+    int accepted = 0;
+
+    pthread_mutex_lock(&gps->writeLock);
+    for (int i = 0; i < count; i++) {
+        TrafficUpdate update = updates[i];
+        batch->received++;
+
+        if (update.roadId < 0) update.roadId = findRoadId(gps, update.fromCity, update.toCity);
+        if (update.timestamp == 0) update.timestamp = now;
+
+        if (update.roadId < 0 || update.roadId >= net->numRoads || !(update.trafficFactor > 0) ||
+            update.timestamp < net->roads[update.roadId].lastUpdate ||
+            !reserveTrafficBatch(batch, net->numRoads)) {
+            batch->rejected++;
+            continue;
+        }
+
+        int slot = batch->slotOfRoad[update.roadId];
+        if (slot >= 0) {
+            batch->coalesced++;
+            if (update.timestamp >= batch->updates[slot].timestamp) batch->updates[slot] = update;
+        } else {
+            if (batch->count == 0) atomic_store(&batch->windowStart, now);
+            batch->slotOfRoad[update.roadId] = batch->count;
+            batch->updates[batch->count++] = update;
+        }
+        accepted++;
+    }
+
+    if (batch->count > 0 && now - atomic_load(&batch->windowStart) >= TRAFFIC_COALESCE_WINDOW) {
+        publishTrafficUpdates(gps);
+    }
+    pthread_mutex_unlock(&gps->writeLock);
+    return accepted;
+}
+
+// Aplicar el lote pendiente a las carreteras y publicar las vistas nuevas.
+// Devuelve cuántas carreteras se actualizaron.
+int publishTrafficUpdates(NavigationSystem* gps) {
+    if (!gps || !gps->trafficBatch) return 0;
+
+    TrafficBatch* batch = gps->trafficBatch;
+    RoadNetwork* net = gps->network;
+
+    pthread_mutex_lock(&gps->writeLock);
+    int count = batch->count;
+    int* roadIds = count > 0 ? (int*)malloc(count * sizeof(int)) : NULL;
+    Road* previous = count > 0 ? (Road*)malloc(count * sizeof(Road)) : NULL;
+    if (!roadIds || !previous) {
+        pthread_mutex_unlock(&gps->writeLock);
+        free(roadIds);
+        free(previous);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const TrafficUpdate* update = &batch->updates[i];
+        Road* road = &net->roads[update->roadId];
+
+        roadIds[i] = update->roadId;
+        previous[i] = *road;
+        batch->slotOfRoad[update->roadId] = -1;
+
+        road->currentTime = road->baseTime * update->trafficFactor;
+        road->lastUpdate = update->timestamp;
+        net->adjacencyMatrix[road->from][road->to] = (int)road->currentTime;
+        net->adjacencyMatrix[road->to][road->from] = (int)road->currentTime;
+    }
+
+    // Las vistas se reemplazan enteras: nadie ve el lote a medias
+    publishRoadGraphWeights(gps, roadIds, previous, count);
+
+    int dropped = 0;
+    for (int i = 0; i < count; i++) {
+        const Road* road = &net->roads[roadIds[i]];
+        dropped += invalidateCachedRoutes(gps, road->from, road->to, road->currentTime < previous[i].currentTime);
+    }
+
+    batch->count = 0;
+    atomic_store(&batch->windowStart, 0);
+    batch->published += count;
+    pthread_mutex_unlock(&gps->writeLock);
+
+    if (gps->debugMode) {
+        printf("🚦 Lote de tráfico publicado: %d carreteras (%ld combinadas, %ld rechazadas), "
+               "%d rutas del caché descartadas\n", count, batch->coalesced, batch->rejected, dropped);
+    }
+
+    free(roadIds);
+    free(previous);
+    return count;
+}
+
+int flushStaleTrafficUpdates(NavigationSystem* gps) {
+    if (!gps || !gps->trafficBatch) return 0;
+
+    // windowStart se lee sin lock (lo escriben los ingestores con writeLock),
+    // por eso es atómico
+    TrafficBatch* batch = gps->trafficBatch;
+    time_t since = atomic_load(&batch->windowStart);
+    if (since == 0 || time(NULL) - since < TRAFFIC_COALESCE_WINDOW) return 0;
+
+    // Si el lock está tomado, quien lo tiene está ingiriendo (y publica al
+    // ver la ventana vencida) o publicando: la consulta no espera
+    if (pthread_mutex_trylock(&gps->writeLock) != 0) return 0;
+
+    int published = 0;
+    since = atomic_load(&batch->windowStart);
+    if (since != 0 && time(NULL) - since >= TRAFFIC_COALESCE_WINDOW) {
+        published = publishTrafficUpdates(gps);
+    }
+    pthread_mutex_unlock(&gps->writeLock);
+    return published;
+}
+
+// =================================================================
+// Tráfico previsto (perfiles de velocidad)
+// =================================================================
+
+int defineSpeedProfile(NavigationSystem* gps, const ProfileBreakpoint* points, int numPoints, ProfilePeriod period) {
+    if (!gps || !gps->network->profiles) return -1;
+
+    pthread_mutex_lock(&gps->writeLock);
+    int id = internSpeedProfile(gps->network->profiles, points, numPoints, period);
+    pthread_mutex_unlock(&gps->writeLock);
+    return id;
+}
+
+// Asignar el perfil (-1 = ninguno) a la carretera, en su variante FIFO.
+// Requiere writeLock
+static bool assignRoadProfile(NavigationSystem* gps, int roadId, int profileId) {
+    RoadNetwork* net = gps->network;
+
+    if (roadId >= net->roadProfileSize) {
+        int size = net->roadProfileSize > 0 ? net->roadProfileSize : 16;
+        while (size <= roadId) size *= 2;
+        int* grown = (int*)realloc(net->roadProfile, size * sizeof(int));
+        if (!grown) return false;
+        for (int r = net->roadProfileSize; r < size; r++) grown[r] = -1;
+        net->roadProfile = grown;
+        net->roadProfileSize = size;
+    }
+
+    int id = profileId;
+    if (profileId >= 0) {
+        const Road* road = &net->roads[roadId];
+        id = fifoSpeedProfile(net->profiles, profileId, (int)lround(road->baseTime * 60));
+        if (id < 0) return false;
+        if (id != profileId && gps->debugMode) {
+            printf("⚠️  Perfil %d ajustado a FIFO para %s → %s (perfil %d)\n", profileId,
+                   net->cities[road->from].name, net->cities[road->to].name, id);
+        }
+    }
+
+    net->roadProfile[roadId] = id;
+    return true;
+}
+
+bool setRoadSpeedProfile(NavigationSystem* gps, const char* fromCity, const char* toCity, int profileId) {
+    City* from = findCity(gps, fromCity);
+    City* to = findCity(gps, toCity);
+    int roadId = from && to ? findRoadId(gps, from->id, to->id) : -1;
+
+    if (roadId < 0) {
+        printf("❌ Error: Carretera no encontrada (%s, %s)\n", fromCity, toCity);
+        return false;
+    }
+    if (profileId < -1 || profileId >= gps->network->profiles->numProfiles) {
+        printf("❌ Error: Perfil de velocidad %d inexistente\n", profileId);
+        return false;
+    }
+
+    pthread_mutex_lock(&gps->writeLock);
+    bool assigned = assignRoadProfile(gps, roadId, profileId);
+    if (assigned) invalidateRoadProfiles(gps);
+    pthread_mutex_unlock(&gps->writeLock);
+    return assigned;
+}
+
+// Perfiles típicos: horas pico de lunes a viernes en zona urbana, salida
+// del viernes y regreso del domingo en autopista, y uno suave para el resto
+static const ProfileBreakpoint urbanProfile[] = {
+    {0, 1.0}, {390, 1.0}, {480, 1.8}, {570, 1.1}, {990, 1.1}, {1080, 1.9}, {1200, 1.0}
+};
+static const ProfileBreakpoint highwayProfile[] = {
+    {1020, 1.0}, {1170, 1.7}, {1320, 1.0},                    // Domingo 17:00 a 22:00
+    {5 * 1440 + 960, 1.0}, {5 * 1440 + 1110, 1.6}, {5 * 1440 + 1260, 1.0}  // Viernes 16:00 a 21:00
+};
+static const ProfileBreakpoint ruralProfile[] = {
+    {0, 1.0}, {450, 1.0}, {540, 1.2}, {1080, 1.2}, {1200, 1.0}
+};
+
+void simulateTrafficCongestion(NavigationSystem* gps) {
+    if (!gps || !gps->network->profiles) return;
+    RoadNetwork* net = gps->network;
+
+    pthread_mutex_lock(&gps->writeLock);
+    int urban = internSpeedProfile(net->profiles, urbanProfile,
+                                   sizeof(urbanProfile) / sizeof(urbanProfile[0]), PROFILE_PERIOD_DAY);
+    int highway = internSpeedProfile(net->profiles, highwayProfile,
+                                     sizeof(highwayProfile) / sizeof(highwayProfile[0]), PROFILE_PERIOD_WEEK);
+    int rural = internSpeedProfile(net->profiles, ruralProfile,
+                                   sizeof(ruralProfile) / sizeof(ruralProfile[0]), PROFILE_PERIOD_DAY);
+
+    int assigned = 0;
+    for (int r = 0; r < net->numRoads; r++) {
+        if (r < net->roadProfileSize && net->roadProfile[r] >= 0) continue;
+
+        const char* type = net->roads[r].roadType;
+        int profile = strcmp(type, "urban") == 0 ? urban : strcmp(type, "highway") == 0 ? highway : rural;
+        if (assignRoadProfile(gps, r, profile)) assigned++;
+    }
+    if (assigned > 0) invalidateRoadProfiles(gps);
+
+    // El tráfico actual de cada carretera con perfil es el previsto para ahora
+    TrafficUpdate* updates = (TrafficUpdate*)malloc((net->numRoads > 0 ? net->numRoads : 1) * sizeof(TrafficUpdate));
+    int count = 0;
+    time_t now = time(NULL);
+    long second = secondOfWeek(now);
+
+    for (int r = 0; updates && r < net->numRoads && r < net->roadProfileSize; r++) {
+        if (net->roadProfile[r] < 0) continue;
+
+        double factor = profileTravelSeconds(net->profiles, net->roadProfile[r], PROFILE_FACTOR_SCALE, second) /
+                        (double)PROFILE_FACTOR_SCALE;
+        TrafficUpdate update = {r, net->roads[r].from, net->roads[r].to, factor, now, 0};
+        updates[count++] = update;
+    }
+
+    ingestTrafficUpdates(gps, updates, count);
+    publishTrafficUpdates(gps);
+    pthread_mutex_unlock(&gps->writeLock);
+    free(updates);
+
+    printf("🚦 Congestión simulada: %d carreteras con perfil nuevo, %d con tráfico previsto para ahora\n",
+           assigned, count);
+}
+
+void clearTrafficConditions(NavigationSystem* gps) {
+    if (!gps) return;
+    RoadNetwork* net = gps->network;
+
+    pthread_mutex_lock(&gps->writeLock);
+    TrafficUpdate* updates = (TrafficUpdate*)malloc((net->numRoads > 0 ? net->numRoads : 1) * sizeof(TrafficUpdate));
+    int count = 0;
+    time_t now = time(NULL);
+
+    for (int r = 0; updates && r < net->numRoads; r++) {
+        if (net->roads[r].currentTime == net->roads[r].baseTime) continue;
+        TrafficUpdate update = {r, net->roads[r].from, net->roads[r].to, 1.0, now, 0};
+        updates[count++] = update;
+    }
+
+    ingestTrafficUpdates(gps, updates, count);
+    publishTrafficUpdates(gps);
+    pthread_mutex_unlock(&gps->writeLock);
+    free(updates);
+
+    if (gps->debugMode) {
+        printf("🚦 Tráfico restablecido: %d carreteras vuelven a su tiempo base\n", count);
+    }
+}
+
 // Detectar ciclos en la red (loops de rutas)
 bool detectRouteLoops(NavigationSystem* gps) {
     if (!gps || gps->network->numCities == 0) return false;
@@ -415,100 +917,312 @@ bool detectRouteLoops(NavigationSystem* gps) {
     return hasCycles;
 }
 
-// Hash para caché de rutas
-unsigned int hashRouteKey(const char* from, const char* to, const char* type) {
-    unsigned int hash = 5381;
+// =================================================================
+// Caché de rutas (LRU de capacidad fija)
+// =================================================================
 
-    // Hash del string concatenado: from+to+type
-    char combined[200];
-    snprintf(combined, sizeof(combined), "%s->%s:%s", from, to, type);
+// Mezcla de splitmix64 de la clave (origen, destino, métrica)
+static uint64_t routeCacheHash(int fromId, int toId, RouteMetric metric) {
+    uint64_t key = ((uint64_t)(uint32_t)fromId << 32) | (uint32_t)toId;
+    key += (uint64_t)metric * 0x9e3779b97f4a7c15ULL;
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+// Bit de la firma para la carretera entre a y b (en cualquier sentido)
+static uint64_t roadSignatureBit(int a, int b) {
+    return 1ULL << (roadPairHash(a, b) & 63);
+}
 
-    for (int i = 0; combined[i]; i++) {
-        hash = ((hash << 5) + hash) + combined[i];
+static Route* copyRoute(const Route* route) {
+    Route* copy = (Route*)malloc(sizeof(Route));
+    if (!copy) return NULL;
+
+    *copy = *route;
+    copy->cityPath = (int*)malloc((route->pathLength > 0 ? route->pathLength : 1) * sizeof(int));
+    if (!copy->cityPath) {
+        free(copy);
+        return NULL;
     }
+    memcpy(copy->cityPath, route->cityPath, route->pathLength * sizeof(int));
+    return copy;
+}
+
+RouteCache* createRouteCache(int capacity, size_t memoryBudget) {
+    if (capacity < 1) capacity = 1;
 
-    return hash;
+    RouteCache* cache = (RouteCache*)malloc(sizeof(RouteCache));
+    if (!cache) return NULL;
+
+    cache->tableSize = 1;
+    while (cache->tableSize < 2 * capacity) cache->tableSize *= 2;
+
+    cache->entries = (RouteCacheEntry*)calloc(capacity, sizeof(RouteCacheEntry));
+    cache->slots = (int*)malloc(cache->tableSize * sizeof(int));
+    if (!cache->entries || !cache->slots) {
+        free(cache->entries);
+        free(cache->slots);
+        free(cache);
+        return NULL;
+    }
+
+    cache->capacity = capacity;
+    cache->memoryBudget = memoryBudget;
+    cache->validFromVersion = 0;
+    pthread_mutex_init(&cache->lock, NULL);
+    cache->hits = cache->misses = cache->evictions = cache->invalidations = 0;
+
+    // Deja la tabla vacía y todas las entradas en la lista libre
+    cache->size = 0;
+    cache->memoryUsed = 0;
+    cache->head = cache->tail = -1;
+    for (int i = 0; i < cache->tableSize; i++) cache->slots[i] = -1;
+    for (int e = 0; e < capacity; e++) cache->entries[e].next = e + 1 < capacity ? e + 1 : -1;
+    cache->freeEntry = 0;
+    return cache;
 }
 
-// Obtener ruta del caché
-Route* getCachedRoute(NavigationSystem* gps, const char* from, const char* to, const char* routeType) {
-    if (!gps || !gps->routeCache) return NULL;
+// Posición en la tabla de la clave, o -1 si no está
+static int routeCacheLookup(const RouteCache* cache, int fromId, int toId, RouteMetric metric) {
+    int mask = cache->tableSize - 1;
+    int i = (int)(routeCacheHash(fromId, toId, metric) & mask);
 
-    unsigned int index = hashRouteKey(from, to, routeType) % gps->routeCache->capacity;
-    CacheEntry* entry = gps->routeCache->buckets[index];
+    while (cache->slots[i] != -1) {
+        const RouteCacheEntry* entry = &cache->entries[cache->slots[i]];
+        if (entry->fromCity == fromId && entry->toCity == toId && entry->metric == metric) return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
 
-    time_t currentTime = time(NULL);
+// Borrado con corrimiento hacia atrás, como el índice de aristas de graph.c
+static void routeCacheErase(RouteCache* cache, int i) {
+    int mask = cache->tableSize - 1;
+    int j = i;
 
-    while (entry) {
-        City* fromCity = findCity(gps, from);
-        City* toCity = findCity(gps, to);
+    while (true) {
+        j = (j + 1) & mask;
+        if (cache->slots[j] == -1) break;
 
-        if (fromCity && toCity &&
-            entry->fromCity == fromCity->id &&
-            entry->toCity == toCity->id &&
-            strcmp(entry->route->routeType, routeType) == 0) {
+        const RouteCacheEntry* entry = &cache->entries[cache->slots[j]];
+        int home = (int)(routeCacheHash(entry->fromCity, entry->toCity, entry->metric) & mask);
+        bool reachable = (i <= j) ? (i < home && home <= j)
+                                  : (i < home || home <= j);
+        if (reachable) continue;
 
-            // Verificar si la ruta no ha expirado (5 minutos)
-            if (currentTime - entry->timestamp < 300) {
-                return entry->route;
-            } else {
-                // Marcar como inválida
-                entry->route->isValid = false;
-            }
-        }
-        entry = entry->next;
+        cache->slots[i] = cache->slots[j];
+        i = j;
     }
 
-    return NULL;
+    cache->slots[i] = -1;
 }
 
-// Cachear ruta
-void cacheRoute(NavigationSystem* gps, const char* from, const char* to, Route* route) {
-    if (!gps || !gps->routeCache || !route) return;
+static void unlinkRouteEntry(RouteCache* cache, int e) {
+    RouteCacheEntry* entry = &cache->entries[e];
+    if (entry->prev != -1) cache->entries[entry->prev].next = entry->next;
+    else cache->head = entry->next;
+    if (entry->next != -1) cache->entries[entry->next].prev = entry->prev;
+    else cache->tail = entry->prev;
+}
 
-    City* fromCity = findCity(gps, from);
-    City* toCity = findCity(gps, to);
-    if (!fromCity || !toCity) return;
+static void pushRouteEntry(RouteCache* cache, int e) {
+    RouteCacheEntry* entry = &cache->entries[e];
+    entry->prev = -1;
+    entry->next = cache->head;
+    if (cache->head != -1) cache->entries[cache->head].prev = e;
+    cache->head = e;
+    if (cache->tail == -1) cache->tail = e;
+}
+
+// Sacar la entrada e del caché y devolverla a la lista libre
+static void removeRouteEntry(RouteCache* cache, int e) {
+    RouteCacheEntry* entry = &cache->entries[e];
+    routeCacheErase(cache, routeCacheLookup(cache, entry->fromCity, entry->toCity, entry->metric));
+    unlinkRouteEntry(cache, e);
+
+    freeRoute(entry->route);
+    entry->route = NULL;
+    cache->memoryUsed -= entry->bytes;
+    cache->size--;
+
+    entry->next = cache->freeEntry;
+    cache->freeEntry = e;
+}
+
+void destroyRouteCache(RouteCache* cache) {
+    if (!cache) return;
+    while (cache->head != -1) removeRouteEntry(cache, cache->head);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->entries);
+    free(cache->slots);
+    free(cache);
+}
+
+// Obtener copia de una ruta del caché
+Route* getCachedRoute(NavigationSystem* gps, int fromId, int toId, RouteMetric metric) {
+    if (!gps || !gps->routeCache) return NULL;
+    RouteCache* cache = gps->routeCache;
+
+    pthread_mutex_lock(&cache->lock);
+    int i = routeCacheLookup(cache, fromId, toId, metric);
+    if (i == -1) {
+        cache->misses++;
+        pthread_mutex_unlock(&cache->lock);
+        return NULL;
+    }
+
+    int e = cache->slots[i];
+    unlinkRouteEntry(cache, e);
+    pushRouteEntry(cache, e);
+    cache->hits++;
+    Route* copy = copyRoute(cache->entries[e].route);
+    pthread_mutex_unlock(&cache->lock);
+    return copy;
+}
+
+// Cachear una copia de la ruta, desalojando las menos usadas si no entra
+void cacheRoute(NavigationSystem* gps, int fromId, int toId, RouteMetric metric, const Route* route) {
+    if (!gps) return;
+    cacheRouteAt(gps, fromId, toId, metric, route, atomic_load(&gps->network->weightsVersion));
+}
+
+// Cachear una ruta calculada sobre la versión de pesos dada. Si entre la
+// búsqueda y este punto se publicó un lote que invalidó el caché, la ruta
+// puede recorrer carreteras ya descartadas y no se guarda
+static void cacheRouteAt(NavigationSystem* gps, int fromId, int toId, RouteMetric metric,
+                         const Route* route, long version) {
+    if (!gps || !gps->routeCache || !route || !route->isValid) return;
+    RouteCache* cache = gps->routeCache;
+
+    size_t bytes = sizeof(Route) + route->pathLength * sizeof(int);
+    if (bytes > cache->memoryBudget) return;
+
+    pthread_mutex_lock(&cache->lock);
+    if (version < cache->validFromVersion) {
+        pthread_mutex_unlock(&cache->lock);
+        return;
+    }
 
-    unsigned int index = hashRouteKey(from, to, route->routeType) % gps->routeCache->capacity;
+    int existing = routeCacheLookup(cache, fromId, toId, metric);
+    if (existing != -1) removeRouteEntry(cache, cache->slots[existing]);
 
-    CacheEntry* newEntry = (CacheEntry*)malloc(sizeof(CacheEntry));
-    newEntry->fromCity = fromCity->id;
-    newEntry->toCity = toCity->id;
-    newEntry->route = route;
-    newEntry->timestamp = time(NULL);
-    newEntry->next = gps->routeCache->buckets[index];
+    while (cache->tail != -1 && (cache->size >= cache->capacity ||
+                                 cache->memoryUsed + bytes > cache->memoryBudget)) {
+        removeRouteEntry(cache, cache->tail);
+        cache->evictions++;
+    }
 
-    gps->routeCache->buckets[index] = newEntry;
-    gps->routeCache->size++;
+    Route* copy = copyRoute(route);
+    if (!copy) {
+        pthread_mutex_unlock(&cache->lock);
+        return;
+    }
+
+    int e = cache->freeEntry;
+    RouteCacheEntry* entry = &cache->entries[e];
+    cache->freeEntry = entry->next;
+
+    entry->fromCity = fromId;
+    entry->toCity = toId;
+    entry->metric = metric;
+    entry->route = copy;
+    entry->bytes = bytes;
+    entry->roadSignature = 0;
+    for (int k = 0; k + 1 < route->pathLength; k++) {
+        entry->roadSignature |= roadSignatureBit(route->cityPath[k], route->cityPath[k + 1]);
+    }
+
+    int mask = cache->tableSize - 1;
+    int i = (int)(routeCacheHash(fromId, toId, metric) & mask);
+    while (cache->slots[i] != -1) i = (i + 1) & mask;
+    cache->slots[i] = e;
+
+    pushRouteEntry(cache, e);
+    cache->size++;
+    cache->memoryUsed += bytes;
+    pthread_mutex_unlock(&cache->lock);
 
     if (gps->debugMode) {
-        printf("💾 Ruta cacheada: %s → %s (%s)\n", from, to, route->routeType);
+        printf("💾 Ruta cacheada: %s → %s (%s)\n", gps->network->cities[fromId].name,
+               gps->network->cities[toId].name, route->routeType);
     }
 }
 
-// Limpiar caché de rutas
-void clearRouteCache(NavigationSystem* gps) {
-    if (!gps || !gps->routeCache) return;
+// Descartar las rutas que recorren la carretera entre cityA y cityB
+int invalidateCachedRoutes(NavigationSystem* gps, int cityA, int cityB, bool improved) {
+    if (!gps || !gps->routeCache) return 0;
+    RouteCache* cache = gps->routeCache;
+
+    uint64_t bit = roadSignatureBit(cityA, cityB);
+    int dropped = 0;
+
+    pthread_mutex_lock(&cache->lock);
+    cache->validFromVersion = atomic_load(&gps->network->weightsVersion);
+    int e = cache->head;
+
+    while (e != -1) {
+        RouteCacheEntry* entry = &cache->entries[e];
+        int next = entry->next;
+
+        bool traverses = false;
+        if (improved) {
+            traverses = true;
+        } else if (entry->roadSignature & bit) {
+            const Route* route = entry->route;
+            for (int k = 0; k + 1 < route->pathLength && !traverses; k++) {
+                int u = route->cityPath[k], v = route->cityPath[k + 1];
+                traverses = (u == cityA && v == cityB) || (u == cityB && v == cityA);
+            }
+        }
 
-    for (int i = 0; i < gps->routeCache->capacity; i++) {
-        CacheEntry* entry = gps->routeCache->buckets[i];
-        while (entry) {
-            CacheEntry* next = entry->next;
-            freeRoute(entry->route);
-            free(entry);
-            entry = next;
+        if (traverses) {
+            removeRouteEntry(cache, e);
+            dropped++;
         }
-        gps->routeCache->buckets[i] = NULL;
+        e = next;
     }
 
-    gps->routeCache->size = 0;
+    cache->invalidations += dropped;
+    pthread_mutex_unlock(&cache->lock);
+    return dropped;
+}
+
+// Limpiar caché de rutas
+void clearRouteCache(NavigationSystem* gps) {
+    if (!gps || !gps->routeCache) return;
+
+    RouteCache* cache = gps->routeCache;
+    pthread_mutex_lock(&cache->lock);
+    cache->validFromVersion = atomic_load(&gps->network->weightsVersion);
+    while (cache->head != -1) removeRouteEntry(cache, cache->head);
+    pthread_mutex_unlock(&cache->lock);
 
     if (gps->debugMode) {
         printf("🗑️  Caché de rutas limpiado\n");
     }
 }
 
+// Estadísticas del caché
+void performCacheMaintenance(NavigationSystem* gps) {
+    if (!gps || !gps->routeCache) return;
+
+    RouteCache* cache = gps->routeCache;
+    pthread_mutex_lock(&cache->lock);
+    long lookups = cache->hits + cache->misses;
+    printf("💾 Caché de rutas: %d/%d rutas, %.1f/%.1f KB\n", cache->size, cache->capacity,
+           cache->memoryUsed / 1024.0, cache->memoryBudget / 1024.0);
+    printf("   Aciertos: %ld (%.1f%%), fallos: %ld, desalojos: %ld, invalidadas: %ld\n",
+           cache->hits, lookups > 0 ? 100.0 * cache->hits / lookups : 0.0,
+           cache->misses, cache->evictions, cache->invalidations);
+    pthread_mutex_unlock(&cache->lock);
+
+    gps->lastMaintenanceTime = time(NULL);
+}
+
 // Imprimir ruta
 void printRoute(NavigationSystem* gps, Route* route) {
     if (!gps || !route || !route->isValid) {
@@ -584,7 +1298,7 @@ void generateNetworkStatistics(NavigationSystem* gps) {
     printf("🌐 Componentes conexos: %d\n", numComponents);
 
     // Estadísticas del caché
-    printf("💾 Rutas en caché: %d/%d\n", gps->routeCache->size, gps->routeCache->capacity);
+    performCacheMaintenance(gps);
 
     // Detectar ciclos
     bool hasCycles = detectRouteLoops(gps);
@@ -622,7 +1336,16 @@ void listCities(NavigationSystem* gps) {
 void destroyNavigationSystem(NavigationSystem* gps) {
     if (!gps) return;
 
-    // Limpiar red de carreteras
+    stopRoadRebuilder(gps);
+
+    // Limpiar red de carreteras: retirar las vistas y vaciar el dominio de
+    // épocas (ya no quedan lectores) antes de liberar lo que comparten
+    if (gps->network) {
+        invalidateRoadGraphs(gps);
+        destroyCRPOverlay(gps->network->overlay);
+    }
+    destroyEpochDomain(gps->readers);
+
     if (gps->network) {
         if (gps->network->adjacencyMatrix) {
             for (int i = 0; i < gps->network->capacity; i++) {
@@ -633,22 +1356,37 @@ void destroyNavigationSystem(NavigationSystem* gps) {
 
         if (gps->network->cities) free(gps->network->cities);
         if (gps->network->roads) free(gps->network->roads);
+        destroyRoadIndex(atomic_load(&gps->network->roadIndex));
+        destroySpeedProfileStore(gps->network->profiles);
+        free(gps->network->roadProfile);
         free(gps->network);
     }
 
     // Limpiar HashMap
     if (gps->cityIndex) destroyHashMap(gps->cityIndex);
 
-    // Limpiar cola de prioridad
-    if (gps->trafficQueue) destroyPriorityQueue(gps->trafficQueue);
+    // Limpiar cola de prioridad (con las actualizaciones sin aplicar)
+    if (gps->trafficQueue) {
+        while (!pqIsEmpty(gps->trafficQueue)) free(pqPop(gps->trafficQueue));
+        destroyPriorityQueue(gps->trafficQueue);
+    }
 
-    // Limpiar caché
-    if (gps->routeCache) {
-        clearRouteCache(gps);
-        free(gps->routeCache->buckets);
-        free(gps->routeCache);
+    if (gps->trafficBatch) {
+        free(gps->trafficBatch->updates);
+        free(gps->trafficBatch->slotOfRoad);
+        free(gps->trafficBatch);
     }
 
+    // Limpiar caché
+    destroyRouteCache(gps->routeCache);
+
+    pthread_mutex_destroy(&gps->writeLock);
+    pthread_mutex_destroy(&gps->statsLock);
+    pthread_rwlock_destroy(&gps->cityLock);
+    pthread_mutex_destroy(&gps->derivedLock);
+    pthread_mutex_destroy(&gps->rebuildLock);
+    pthread_cond_destroy(&gps->rebuildSignal);
+    pthread_cond_destroy(&gps->rebuildIdle);
     free(gps);
     printf("🗑️  Sistema GPS destruido\n");
 }
@@ -738,12 +1476,37 @@ void runGPSDemo() {
     updateTrafficConditions(gps, "Buenos Aires", "Córdoba", 1.8); // 80% más tiempo
     updateTrafficConditions(gps, "Rosario", "Córdoba", 1.5); // 50% más tiempo
 
+    // Publicar ya las dos en un lote, sin esperar a que venza la ventana
+    publishTrafficUpdates(gps);
+
+    // Solo se recalculan las cliques de la partición, no la partición
+    customizeRoadOverlay(gps, 0);
+
     printf("\n🔄 Recalculando ruta más rápida con tráfico...\n");
     Route* fastestWithTraffic = findFastestPath(gps, "Buenos Aires", "Salta");
     if (fastestWithTraffic) {
         printRoute(gps, fastestWithTraffic);
     }
 
+    // Tráfico previsto: perfiles por tipo de carretera y salida en hora pico
+    simulateTrafficCongestion(gps);
+    time_t rushHour = time(NULL);
+    struct tm departure;
+    localtime_r(&rushHour, &departure);
+    departure.tm_mday += 1;
+    departure.tm_hour = 8;
+    departure.tm_min = departure.tm_sec = 0;
+    rushHour = mktime(&departure);
+
+    printf("\n🕒 Ruta más rápida saliendo mañana a las 8:00...\n");
+    Route* predicted = findFastestPathAt(gps, "Buenos Aires", "Salta", rushHour);
+    if (predicted) {
+        printRoute(gps, predicted);
+    }
+
+    // Comparar las estrategias de búsqueda sobre la misma consulta
+    compareSearchStrategies(gps, "Buenos Aires", "Salta");
+
     // Verificar conectividad
     printf("\n🔗 === ANÁLISIS DE CONECTIVIDAD ===\n");
     printf("¿Buenos Aires → Salta? %s\n", isReachable(gps, "Buenos Aires", "Salta") ? "✅ SÍ" : "❌ NO");
@@ -757,6 +1520,7 @@ void runGPSDemo() {
     if (fastest) freeRoute(fastest);
     if (cheapest) freeRoute(cheapest);
     if (fastestWithTraffic) freeRoute(fastestWithTraffic);
+    if (predicted) freeRoute(predicted);
 
     destroyNavigationSystem(gps);
 }
@@ -12,23 +12,32 @@
 #include <time.h>
 #include <math.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 // Incluir todas las estructuras y algoritmos
 #include "../algoritmos/dijkstra.h"
 #include "../algoritmos/bellman_ford.h"
 #include "../algoritmos/dfs_bfs.h"
+#include "../algoritmos/distance_table.h"
 #include "../estructura_datos/hash_map.h"
 #include "../estructura_datos/priority_queue.h"
 #include "../utils/file_io.h"
 #include "../utils/visualization.h"
+#include "../utils/epoch_reclaim.h"
 #include "../algoritmos/cycle_detection.h"
 #include "../graph/graph.h"
+#include "contraction_hierarchy.h"
+#include "crp_overlay.h"
+#include "speed_profile.h"
 
 
 #define MAX_CITIES 1000
 #define MAX_NAME_LENGTH 50
 #define MAX_ROUTES 10
-#define CACHE_SIZE 100
+#define CACHE_SIZE 100                      // Rutas como máximo en el caché
+#define CACHE_MEMORY_BUDGET (256 * 1024)    // Bytes como máximo entre las rutas cacheadas
+#define TRAFFIC_COALESCE_WINDOW 1           // Segundos que se acumula tráfico antes de publicarlo
 #define INF INT_MAX
 
 // =================================================================
@@ -77,22 +86,108 @@ typedef struct {
     bool isValid;          // Si la ruta es válida
 } Route;
 
-// Entrada del caché de rutas
-typedef struct CacheEntry {
+// Métrica con la que se pesan las carreteras en una búsqueda
+typedef enum {
+    ROUTE_METRIC_SHORTEST,  // Mismos pesos que adjacencyMatrix (findShortestPath)
+    ROUTE_METRIC_FASTEST,   // currentTime de carreteras abiertas (findFastestPath)
+    ROUTE_METRIC_DISTANCE,  // Metros de carreteras abiertas
+    ROUTE_METRIC_TOLL,      // Peaje en centavos de carreteras abiertas (negativo = descuento)
+    ROUTE_METRIC_COUNT
+} RouteMetric;
+
+// Entrada del caché de rutas. Las entradas ocupadas forman una lista
+// doblemente enlazada por índices, de la más a la menos usada
+typedef struct {
     int fromCity;
     int toCity;
-    Route* route;
-    time_t timestamp;
-    struct CacheEntry* next;
-} CacheEntry;
+    RouteMetric metric;
+    Route* route;            // Copia propia del caché
+    size_t bytes;            // Memoria de la copia
+    uint64_t roadSignature;  // Un bit por carretera recorrida: filtro antes de mirar el camino
+    int prev;                // Más reciente (-1 = es la cabeza)
+    int next;                // Menos reciente (-1 = es la cola); encadena las libres
+} RouteCacheEntry;
 
-// Caché de rutas
+// Caché LRU de capacidad fija indexado por (origen, destino, métrica)
 typedef struct {
-    CacheEntry** buckets;
-    int size;
+    RouteCacheEntry* entries;   // capacity entradas reservadas de una vez
+    int* slots;                 // Tabla abierta: índice de entrada o -1
+    int tableSize;              // Potencia de 2 >= 2 * capacity
     int capacity;
+    int size;
+    int head;                   // Más recientemente usada
+    int tail;                   // Próxima en ser desalojada
+    int freeEntry;              // Primera entrada libre
+    size_t memoryBudget;
+    size_t memoryUsed;
+    long hits;
+    long misses;
+    long evictions;
+    long invalidations;
+    long validFromVersion;      // Rutas calculadas con pesos anteriores no se aceptan
+    pthread_mutex_t lock;       // Las consultas concurrentes comparten el caché
 } RouteCache;
 
+// Estrategia de búsqueda punto a punto
+typedef enum {
+    ROUTE_SEARCH_DIJKSTRA,       // Dijkstra unidireccional
+    ROUTE_SEARCH_BIDIRECTIONAL,  // Dijkstra desde origen y destino a la vez
+    ROUTE_SEARCH_ASTAR,          // A* con heurística Haversine
+    ROUTE_SEARCH_CONTRACTION_HIERARCHY, // Consulta ascendente sobre la jerarquía
+    ROUTE_SEARCH_OVERLAY                // Grafo multinivel CRP (tolera tráfico en vivo)
+} RouteSearchStrategy;
+
+// Estadísticas de la última búsqueda
+typedef struct {
+    RouteSearchStrategy strategy;
+    int settledNodes;      // Vértices fijados (extraídos de la cola)
+    int relaxedEdges;      // Arcos examinados
+} SearchStats;
+
+// Arco de la vista de tiempos para búsquedas dependientes del tiempo
+typedef struct {
+    int baseSeconds;       // Tiempo base (con perfil) o tiempo actual (sin perfil)
+    int profile;           // Perfil de velocidad o -1 = tiempo fijo
+} TimeDependentArc;
+
+// Perfiles de la vista de tiempos, alineados con sus arcos. Lleva su
+// propia copia de los perfiles: agregar perfiles no la toca
+typedef struct {
+    TimeDependentArc* arcs;
+    SpeedProfileStore* profiles;
+    double heuristicScale;   // Segundos por km admisibles con el factor mínimo de cada perfil
+} TimeDependentArcs;
+
+// Pesos publicados de una métrica: la vista CSR, su cota para A* y lo
+// que se deriva de ellos. Una versión publicada no cambia: el tráfico arma
+// otra y la reemplaza, y la vieja se libera cuando ningún lector la tiene
+// fijada. Si el lote no cambia los arcos, la versión nueva hereda la
+// jerarquía y las cliques CRP de la anterior (con los pesos viejos) y las
+// consultas las siguen usando hasta que el hilo de reconstrucción publica
+// las suyas; la vista de tiempos se rearma al publicar.
+typedef struct {
+    CSRGraph* graph;
+    double heuristicScale;                      // Minutos por km admisibles para A*
+    long version;                               // weightsVersion al publicarla
+    _Atomic(ContractionHierarchy*) hierarchy;   // NULL = sin construir
+    _Atomic(CRPMetric*) overlayMetric;          // NULL = sin personalizar
+    _Atomic(TimeDependentArcs*) timeDependent;  // Solo ROUTE_METRIC_FASTEST; NULL = sin armar
+    long arcsVersion;                           // Igual = mismos arcos (solo cambian pesos)
+    atomic_int staleDerived;                    // Heredadas sin rearmar (ROAD_DERIVED_*)
+} RoadWeights;
+
+// Estructuras derivadas que se heredan entre versiones de pesos
+#define ROAD_DERIVED_HIERARCHY 1
+#define ROAD_DERIVED_OVERLAY 2
+
+// Índice de carreteras por par de ciudades. Una carretera nueva se agrega
+// en un lugar libre; al crecer se arma otra tabla, se publica y la vieja
+// se retira por épocas, así las consultas la leen sin locks
+typedef struct {
+    atomic_int* slots;     // Tabla abierta (ciudad menor, ciudad mayor) -> carretera, -1 = libre
+    int size;              // Potencia de 2 >= 2 * carreteras indexadas
+} RoadIndex;
+
 // Red de carreteras (grafo)
 typedef struct {
     int** adjacencyMatrix;  // Matriz de adyacencia con pesos
@@ -101,24 +196,76 @@ typedef struct {
     int numCities;         // Número de ciudades
     int numRoads;          // Número de carreteras
     int capacity;          // Capacidad máxima
+    _Atomic(RoadWeights*) weights[ROUTE_METRIC_COUNT];  // Versión vigente por métrica (NULL = construir)
+    int* roadArcs[ROUTE_METRIC_COUNT];  // Por carretera r: arcos 2r (from→to) y 2r+1 (to→from), -1 = fuera
+    atomic_long weightsVersion;         // Lotes de tráfico publicados
+    long arcsBuilt;                     // Vistas armadas desde cero (da arcsVersion)
+    _Atomic(RoadIndex*) roadIndex;      // NULL = sin carreteras
+    CRPOverlay* overlay;                // Partición multinivel (solo topología)
+    bool overlayTopologyDirty;          // Se agregaron carreteras: rehacer la partición
+    SpeedProfileStore* profiles;        // Perfiles de velocidad compartidos
+    int* roadProfile;                   // Por carretera: perfil o -1 (las posteriores no tienen)
+    int roadProfileSize;
 } RoadNetwork;
 
 // Actualización de tráfico
 typedef struct {
-    int roadId;
+    int roadId;            // -1 = buscar la carretera por (fromCity, toCity)
+    int fromCity;
+    int toCity;
     double trafficFactor;  // Multiplicador de tiempo (1.0 = normal, 2.0 = doble tiempo)
-    time_t timestamp;
+    time_t timestamp;      // 0 = ahora
     int priority;          // Prioridad de la actualización
 } TrafficUpdate;
 
+// Lote de tráfico pendiente: una sola actualización por carretera (la de
+// timestamp más reciente), acumulada durante TRAFFIC_COALESCE_WINDOW
+typedef struct {
+    TrafficUpdate* updates;
+    int count;
+    int capacity;
+    int* slotOfRoad;       // Por carretera: posición en updates o -1
+    int numRoadSlots;
+    _Atomic time_t windowStart; // Llegada de la primera actualización pendiente (0 = vacío)
+    long received;         // Actualizaciones recibidas
+    long coalesced;        // Reemplazadas por otra más nueva de la misma carretera
+    long rejected;         // Carretera inexistente, factor inválido o anteriores a lo aplicado
+    long published;        // Carreteras actualizadas al publicar
+} TrafficBatch;
+
 // Sistema de navegación principal
 typedef struct {
     RoadNetwork* network;
     HashMap* cityIndex;          // Búsqueda rápida de ciudades por nombre
     PriorityQueue* trafficQueue; // Cola de actualizaciones de tráfico
+    TrafficBatch* trafficBatch;  // Tráfico acumulado sin publicar
     RouteCache* routeCache;      // Caché de rutas calculadas
     time_t lastMaintenanceTime;  // Última limpieza del caché
     bool debugMode;              // Modo debug para logging
+    RouteSearchStrategy searchStrategy; // Estrategia de findShortestPath/findFastestPath
+    SearchStats lastSearchStats;        // Estadísticas de la última búsqueda
+    // Concurrencia: las consultas (findShortestPath, findFastestPath,
+    // isReachable, searchRoadNetwork...) fijan una época y leen los pesos
+    // publicados y el índice de carreteras sin locks; el tráfico y
+    // addCity/addRoad se serializan con writeLock. Las jerarquías y las
+    // cliques CRP se preprocesan con derivedLock, no con writeLock, así el
+    // tráfico no espera a una construcción. Una ciudad o carretera nueva se
+    // ve recién en las vistas que se arman después de agregarla.
+    EpochDomain* readers;
+    pthread_mutex_t writeLock;          // Recursivo
+    pthread_mutex_t statsLock;          // Solo para lastSearchStats
+    pthread_rwlock_t cityLock;          // cityIndex: findCity lee, addCity escribe
+    pthread_mutex_t derivedLock;        // Una construcción de jerarquía o cliques a la vez (antes que writeLock)
+
+    // Hilo que rearma lo heredado tras cada lote de tráfico
+    pthread_t rebuildThread;
+    pthread_mutex_t rebuildLock;        // Protege los campos rebuild*
+    pthread_cond_t rebuildSignal;       // Hay trabajo o hay que terminar
+    pthread_cond_t rebuildIdle;         // Terminó una pasada y no queda trabajo
+    bool rebuildPending;
+    bool rebuildBusy;
+    bool rebuildStop;
+    bool rebuildRunning;                // Sin hilo no se hereda nada: se construye en la consulta
 } NavigationSystem;
 
 // =================================================================
@@ -141,6 +288,7 @@ void listCities(NavigationSystem* gps);
 bool addRoad(NavigationSystem* gps, const char* fromCity, const char* toCity,
              double distance, double time, double toll, const char* roadType, int speedLimit);
 bool removeRoad(NavigationSystem* gps, const char* fromCity, const char* toCity);
+int findRoadId(NavigationSystem* gps, int fromId, int toId);
 void listRoads(NavigationSystem* gps, const char* cityName);
 
 // Algoritmos de búsqueda de rutas
@@ -149,20 +297,107 @@ Route* findFastestPath(NavigationSystem* gps, const char* from, const char* to);
 Route* findCheapestPath(NavigationSystem* gps, const char* from, const char* to);
 Route** findAlternativeRoutes(NavigationSystem* gps, const char* from, const char* to, int maxRoutes, int* routeCount);
 
+// Estrategias de búsqueda punto a punto
+void setRouteSearchStrategy(NavigationSystem* gps, RouteSearchStrategy strategy);
+Route* findShortestPathWithStrategy(NavigationSystem* gps, const char* from, const char* to, RouteSearchStrategy strategy);
+Route* findFastestPathWithStrategy(NavigationSystem* gps, const char* from, const char* to, RouteSearchStrategy strategy);
+PathResult* searchRoadNetwork(NavigationSystem* gps, int fromId, int toId, RouteMetric metric, RouteSearchStrategy strategy);
+RoadWeights* getRoadWeights(NavigationSystem* gps, RouteMetric metric);
+CSRGraph* getRoadGraph(NavigationSystem* gps, RouteMetric metric);
+void invalidateRoadGraphs(NavigationSystem* gps);
+void publishRoadGraphWeights(NavigationSystem* gps, const int* roadIds, const Road* previous, int count);
+void invalidateRoadTopology(NavigationSystem* gps);
+void invalidateRoadProfiles(NavigationSystem* gps);
+bool roadMetricUsable(const Road* road, RouteMetric metric);
+int roadMetricWeight(const Road* road, RouteMetric metric);
+const char* routeSearchStrategyName(RouteSearchStrategy strategy);
+void compareSearchStrategies(NavigationSystem* gps, const char* from, const char* to);
+
+// Lo que devuelven getRoadWeights, getRoadGraph, buildRoadHierarchy y
+// getRoadOverlayMetric sigue vivo mientras quien llama tenga fijada una
+// época (epochEnter sobre gps->readers) o tenga writeLock
+
+// Hilo de reconstrucción (lo arrancan y detienen create/destroyNavigationSystem).
+// waitRoadRebuild espera a que no quede nada heredado por rearmar.
+// roadSearchIsCurrent dice si la estrategia usaría estructuras armadas con
+// los pesos vigentes (solo esas rutas se cachean)
+bool startRoadRebuilder(NavigationSystem* gps);
+void stopRoadRebuilder(NavigationSystem* gps);
+void waitRoadRebuild(NavigationSystem* gps);
+bool roadSearchIsCurrent(NavigationSystem* gps, RouteMetric metric, RouteSearchStrategy strategy);
+
+// Jerarquías de contracción (se descartan al cambiar carreteras; con
+// tráfico se sigue usando la anterior hasta rearmarla)
+ContractionHierarchy* buildRoadHierarchy(NavigationSystem* gps, RouteMetric metric);
+bool saveRoadHierarchy(NavigationSystem* gps, RouteMetric metric, const char* filename);
+bool loadRoadHierarchy(NavigationSystem* gps, RouteMetric metric, const char* filename);
+
+// Partición multinivel CRP: la topología se preprocesa una vez y cada
+// métrica se repersonaliza en paralelo cuando llega tráfico
+bool buildRoadOverlay(NavigationSystem* gps, int cellSize);
+void customizeRoadOverlay(NavigationSystem* gps, int numThreads);
+CRPMetric* getRoadOverlayMetric(NavigationSystem* gps, RouteMetric metric);
+
+// Matriz de distancias entre ciudades (ids), por filas. Con la estrategia
+// de jerarquía de contracción usa baldes; si no, un Dijkstra por origen.
+int* computeRoadDistanceTable(NavigationSystem* gps, const int* fromIds, int numFrom,
+                              const int* toIds, int numTo, RouteMetric metric, int numThreads);
+
 // Verificación de conectividad
 bool isReachable(NavigationSystem* gps, const char* from, const char* to);
 bool hasAlternativePath(NavigationSystem* gps, const char* from, const char* to, const char* avoidCity);
 bool detectRouteLoops(NavigationSystem* gps);
 
-// Gestión de tráfico
+// Gestión de tráfico. updateTrafficConditions agrega una carretera al lote
+// pendiente: las consultas la ven al vencer TRAFFIC_COALESCE_WINDOW (o un
+// poco después si la que la publicaría encuentra writeLock tomado); para
+// verla ya, publishTrafficUpdates. queueTrafficUpdate encola por id de
+// carretera y processTrafficUpdates aplica la cola como un lote
 void updateTrafficConditions(NavigationSystem* gps, const char* fromCity, const char* toCity, double trafficFactor);
+bool queueTrafficUpdate(NavigationSystem* gps, int roadId, double trafficFactor, int priority);
 void processTrafficUpdates(NavigationSystem* gps);
+
+// Ingesta por lotes: las actualizaciones se combinan por carretera y se
+// publican juntas (al vencer la ventana o con publishTrafficUpdates). Cada
+// vista CSR afectada se copia, se corrige y se reemplaza de una vez, así
+// una búsqueda ve el lote entero o nada de él.
+int ingestTrafficUpdates(NavigationSystem* gps, const TrafficUpdate* updates, int count);
+int publishTrafficUpdates(NavigationSystem* gps);
+
+// Publicar el lote pendiente si ya venció la ventana. Lo llaman las
+// consultas, así que la ventana acota cuánto tarda en verse el tráfico
+// aunque no lleguen más actualizaciones. Sin lote vencido no toma locks
+int flushStaleTrafficUpdates(NavigationSystem* gps);
+
+// Tráfico previsto: perfiles de velocidad por carretera (ver speed_profile.h).
+// Una carretera con perfil tarda baseTime * factor(momento de entrada); sin
+// perfil usa currentTime. setRoadSpeedProfile ajusta el perfil a FIFO para
+// esa carretera si hace falta. simulateTrafficCongestion asigna perfiles
+// típicos por tipo de carretera a las que no tienen y publica como tráfico
+// actual el factor de este momento; clearTrafficConditions vuelve todas al
+// tiempo base (los perfiles quedan).
+int defineSpeedProfile(NavigationSystem* gps, const ProfileBreakpoint* points, int numPoints, ProfilePeriod period);
+bool setRoadSpeedProfile(NavigationSystem* gps, const char* fromCity, const char* toCity, int profileId);
 void simulateTrafficCongestion(NavigationSystem* gps);
 void clearTrafficConditions(NavigationSystem* gps);
 
-// Caché de rutas
-Route* getCachedRoute(NavigationSystem* gps, const char* from, const char* to, const char* routeType);
-void cacheRoute(NavigationSystem* gps, const char* from, const char* to, Route* route);
+// Ruta más rápida saliendo en departure. Dijkstra dependiente del tiempo
+// (A* si la estrategia es ROUTE_SEARCH_ASTAR; las demás no aplican y usan
+// Dijkstra). totalWeight del resultado está en segundos
+PathResult* searchTimeDependent(NavigationSystem* gps, int fromId, int toId, time_t departure,
+                                RouteSearchStrategy strategy);
+Route* findFastestPathAt(NavigationSystem* gps, const char* from, const char* to, time_t departure);
+
+// Caché de rutas. getCachedRoute devuelve una copia (la libera quien la
+// pide) y cacheRoute guarda otra, así el caché puede desalojar sin dejar
+// punteros colgados. Al cambiar una carretera solo se descartan las rutas
+// que la recorren; si la carretera mejoró (improved), cualquier ruta puede
+// haber quedado peor que la nueva, así que se descartan todas.
+RouteCache* createRouteCache(int capacity, size_t memoryBudget);
+void destroyRouteCache(RouteCache* cache);
+Route* getCachedRoute(NavigationSystem* gps, int fromId, int toId, RouteMetric metric);
+void cacheRoute(NavigationSystem* gps, int fromId, int toId, RouteMetric metric, const Route* route);
+int invalidateCachedRoutes(NavigationSystem* gps, int cityA, int cityB, bool improved);
 void clearRouteCache(NavigationSystem* gps);
 void performCacheMaintenance(NavigationSystem* gps);
 
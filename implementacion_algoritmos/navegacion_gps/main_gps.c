@@ -119,7 +119,12 @@ int main() {
                     scanf("%s", to);
                     printf("Factor de tráfico (1.0 = normal, 2.0 = doble tiempo): ");
                     scanf("%lf", &factor);
+                    // Se publica ya: sin esto la actualización espera en el
+                    // lote hasta que venza la ventana de tráfico
                     updateTrafficConditions(gps, from, to, factor);
+                    if (publishTrafficUpdates(gps) > 0) {
+                        printf("🚦 Tráfico publicado: las próximas rutas ya lo usan\n");
+                    }
                     break;
                 }
                 case 9: {
@@ -0,0 +1,216 @@
+//
+// Created by administrador on 7/4/25.
+//
+
+#include "speed_profile.h"
+#include <string.h>
+#include <math.h>
+
+SpeedProfileStore* createSpeedProfileStore(void) {
+    SpeedProfileStore* store = (SpeedProfileStore*)calloc(1, sizeof(SpeedProfileStore));
+    if (!store) return NULL;
+
+    store->tableSize = 16;
+    store->table = (int*)malloc(store->tableSize * sizeof(int));
+    if (!store->table) {
+        free(store);
+        return NULL;
+    }
+    for (int i = 0; i < store->tableSize; i++) store->table[i] = -1;
+    return store;
+}
+
+void destroySpeedProfileStore(SpeedProfileStore* store) {
+    if (!store) return;
+    free(store->profiles);
+    free(store->values);
+    free(store->table);
+    free(store);
+}
+
+SpeedProfileStore* cloneSpeedProfileStore(const SpeedProfileStore* store) {
+    SpeedProfileStore* copy = (SpeedProfileStore*)calloc(1, sizeof(SpeedProfileStore));
+    if (!copy) return NULL;
+
+    copy->numProfiles = copy->profileCapacity = store->numProfiles;
+    copy->numValues = copy->valueCapacity = store->numValues;
+    copy->profiles = (SpeedProfile*)malloc((store->numProfiles > 0 ? store->numProfiles : 1) * sizeof(SpeedProfile));
+    copy->values = (uint16_t*)malloc((store->numValues > 0 ? store->numValues : 1) * sizeof(uint16_t));
+    if (!copy->profiles || !copy->values) {
+        destroySpeedProfileStore(copy);
+        return NULL;
+    }
+
+    memcpy(copy->profiles, store->profiles, store->numProfiles * sizeof(SpeedProfile));
+    memcpy(copy->values, store->values, store->numValues * sizeof(uint16_t));
+    return copy;
+}
+
+// FNV-1a de los factores cuantizados
+static uint64_t profileHash(const uint16_t* values, int numBuckets) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < numBuckets; i++) {
+        hash ^= values[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash ^ (uint64_t)numBuckets;
+}
+
+static bool sameProfile(const SpeedProfileStore* store, int id, const uint16_t* values, int numBuckets) {
+    const SpeedProfile* profile = &store->profiles[id];
+    return profile->numBuckets == numBuckets &&
+           memcmp(store->values + profile->offset, values, numBuckets * sizeof(uint16_t)) == 0;
+}
+
+static bool growProfileTable(SpeedProfileStore* store) {
+    if (2 * (store->numProfiles + 1) <= store->tableSize) return true;
+
+    int size = store->tableSize * 2;
+    int* table = (int*)malloc(size * sizeof(int));
+    if (!table) return false;
+    for (int i = 0; i < size; i++) table[i] = -1;
+
+    for (int id = 0; id < store->numProfiles; id++) {
+        const SpeedProfile* profile = &store->profiles[id];
+        int i = (int)(profileHash(store->values + profile->offset, profile->numBuckets) & (size - 1));
+        while (table[i] != -1) i = (i + 1) & (size - 1);
+        table[i] = id;
+    }
+
+    free(store->table);
+    store->table = table;
+    store->tableSize = size;
+    return true;
+}
+
+// Id del perfil con esos factores, agregándolo si no existe
+static int internProfileValues(SpeedProfileStore* store, const uint16_t* values, int numBuckets) {
+    if (!store->table || !growProfileTable(store)) return -1;
+
+    int mask = store->tableSize - 1;
+    int i = (int)(profileHash(values, numBuckets) & mask);
+    while (store->table[i] != -1) {
+        if (sameProfile(store, store->table[i], values, numBuckets)) return store->table[i];
+        i = (i + 1) & mask;
+    }
+
+    if (store->numProfiles == store->profileCapacity) {
+        int capacity = store->profileCapacity > 0 ? store->profileCapacity * 2 : 8;
+        SpeedProfile* profiles = (SpeedProfile*)realloc(store->profiles, capacity * sizeof(SpeedProfile));
+        if (!profiles) return -1;
+        store->profiles = profiles;
+        store->profileCapacity = capacity;
+    }
+    if (store->numValues + numBuckets > store->valueCapacity) {
+        int capacity = store->valueCapacity > 0 ? store->valueCapacity : 1024;
+        while (capacity < store->numValues + numBuckets) capacity *= 2;
+        uint16_t* grown = (uint16_t*)realloc(store->values, capacity * sizeof(uint16_t));
+        if (!grown) return -1;
+        store->values = grown;
+        store->valueCapacity = capacity;
+    }
+
+    int id = store->numProfiles++;
+    SpeedProfile* profile = &store->profiles[id];
+    profile->offset = store->numValues;
+    profile->numBuckets = numBuckets;
+    profile->maxDrop = 0;
+    profile->minFactor = values[0];
+
+    for (int b = 0; b < numBuckets; b++) {
+        int next = values[b + 1 < numBuckets ? b + 1 : 0];
+        if (values[b] - next > profile->maxDrop) profile->maxDrop = values[b] - next;
+        if (values[b] < profile->minFactor) profile->minFactor = values[b];
+    }
+
+    memcpy(store->values + store->numValues, values, numBuckets * sizeof(uint16_t));
+    store->numValues += numBuckets;
+    store->table[i] = id;
+    return id;
+}
+
+int internSpeedProfile(SpeedProfileStore* store, const ProfileBreakpoint* points, int numPoints,
+                       ProfilePeriod period) {
+    if (!store || !points || numPoints < 1) return -1;
+
+    int periodMinutes = (period == PROFILE_PERIOD_WEEK ? PROFILE_WEEK_SECONDS : PROFILE_DAY_SECONDS) / 60;
+    for (int i = 0; i < numPoints; i++) {
+        if (points[i].minute < 0 || points[i].minute >= periodMinutes ||
+            (i > 0 && points[i].minute <= points[i - 1].minute) ||
+            !(points[i].factor > 0) || points[i].factor > PROFILE_MAX_FACTOR) {
+            printf("❌ Error: Punto de quiebre %d inválido (minuto %d, factor %.3f)\n",
+                   i, points[i].minute, points[i].factor);
+            return -1;
+        }
+    }
+
+    int bucketMinutes = PROFILE_BUCKET_SECONDS / 60;
+    int numBuckets = periodMinutes / bucketMinutes;
+    uint16_t* values = (uint16_t*)malloc(numBuckets * sizeof(uint16_t));
+    if (!values) return -1;
+
+    // Muestrear la función lineal por tramos en la grilla. next es el
+    // primer punto después del minuto; el tramo anterior puede dar la vuelta
+    int next = 0;
+    for (int b = 0; b < numBuckets; b++) {
+        int minute = b * bucketMinutes;
+        while (next < numPoints && points[next].minute <= minute) next++;
+
+        const ProfileBreakpoint* left = &points[(next + numPoints - 1) % numPoints];
+        const ProfileBreakpoint* right = &points[next % numPoints];
+        int leftMinute = left->minute > minute ? left->minute - periodMinutes : left->minute;
+        int rightMinute = right->minute <= minute ? right->minute + periodMinutes : right->minute;
+
+        double factor = left->factor;
+        if (rightMinute > leftMinute) {
+            factor += (right->factor - left->factor) * (minute - leftMinute) / (rightMinute - leftMinute);
+        }
+
+        long quantized = lround(factor * PROFILE_FACTOR_SCALE);
+        values[b] = (uint16_t)(quantized < 1 ? 1 : quantized);
+    }
+
+    int id = internProfileValues(store, values, numBuckets);
+    free(values);
+    return id;
+}
+
+bool isFifoSpeedProfile(const SpeedProfileStore* store, int profileId, int baseSeconds) {
+    if (!store || profileId < 0 || profileId >= store->numProfiles) return false;
+    return (int64_t)baseSeconds * store->profiles[profileId].maxDrop <=
+           (int64_t)PROFILE_FACTOR_SCALE * PROFILE_BUCKET_SECONDS;
+}
+
+int fifoSpeedProfile(SpeedProfileStore* store, int profileId, int baseSeconds) {
+    if (!store || profileId < 0 || profileId >= store->numProfiles) return -1;
+    if (isFifoSpeedProfile(store, profileId, baseSeconds)) return profileId;
+
+    // Caída máxima por balde que la carretera tolera sin dejar de ser FIFO
+    int allowed = (int)((int64_t)PROFILE_FACTOR_SCALE * PROFILE_BUCKET_SECONDS / (baseSeconds > 0 ? baseSeconds : 1));
+
+    SpeedProfile profile = store->profiles[profileId];
+    uint16_t* values = (uint16_t*)malloc(profile.numBuckets * sizeof(uint16_t));
+    if (!values) return -1;
+    memcpy(values, store->values + profile.offset, profile.numBuckets * sizeof(uint16_t));
+
+    // Una vuelta desde el máximo alcanza: ese valor nunca se levanta
+    int peak = 0;
+    for (int b = 1; b < profile.numBuckets; b++) {
+        if (values[b] > values[peak]) peak = b;
+    }
+    for (int k = 0; k < profile.numBuckets; k++) {
+        int b = (peak + k) % profile.numBuckets;
+        int next = (b + 1) % profile.numBuckets;
+        if (values[b] - values[next] > allowed) values[next] = (uint16_t)(values[b] - allowed);
+    }
+
+    int id = internProfileValues(store, values, profile.numBuckets);
+    free(values);
+    return id;
+}
+
+long secondOfWeek(time_t when) {
+    struct tm local;
+    localtime_r(&when, &local);
+    return local.tm_wday * (long)PROFILE_DAY_SECONDS + local.tm_hour * 3600L + local.tm_min * 60L + local.tm_sec;
+}
@@ -0,0 +1,97 @@
+//
+// Created by administrador on 7/4/25.
+//
+
+#ifndef SPEED_PROFILE_H
+#define SPEED_PROFILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#define PROFILE_BUCKET_SECONDS 900                  // Puntos de quiebre cada 15 minutos
+#define PROFILE_DAY_SECONDS 86400
+#define PROFILE_WEEK_SECONDS (7 * PROFILE_DAY_SECONDS)
+#define PROFILE_FACTOR_SCALE 1000                   // Factores en milésimos (1000 = tiempo base)
+#define PROFILE_MAX_FACTOR 60.0
+
+// Perfiles de tiempo de viaje: factor sobre el tiempo base de la carretera
+// en función del momento en que se entra a ella, lineal por tramos y
+// periódico (un día o una semana). Los puntos de quiebre se cuantizan a
+// una grilla de PROFILE_BUCKET_SECONDS y los factores a milésimos (uint16),
+// así que un perfil diario ocupa 192 bytes. Los perfiles iguales se
+// guardan una sola vez: las carreteras solo guardan el id.
+typedef enum {
+    PROFILE_PERIOD_DAY,     // Se repite todos los días
+    PROFILE_PERIOD_WEEK     // Un valor distinto por día de la semana
+} ProfilePeriod;
+
+// Punto de quiebre de entrada. minute cuenta desde las 00:00 (diario) o
+// desde el domingo 00:00 (semanal, como tm_wday); entre el último y el
+// primero se interpola dando la vuelta al período
+typedef struct {
+    int minute;
+    double factor;
+} ProfileBreakpoint;
+
+typedef struct {
+    int offset;           // Primer valor en values
+    int numBuckets;       // 96 (día) o 672 (semana)
+    int maxDrop;          // Mayor caída entre baldes consecutivos (en milésimos)
+    int minFactor;        // Cota inferior para A*
+} SpeedProfile;
+
+typedef struct {
+    SpeedProfile* profiles;
+    int numProfiles;
+    int profileCapacity;
+    uint16_t* values;     // Factores de todos los perfiles, uno detrás de otro
+    int numValues;
+    int valueCapacity;
+    int* table;           // Tabla abierta por contenido: id de perfil o -1 (NULL en copias)
+    int tableSize;
+} SpeedProfileStore;
+
+SpeedProfileStore* createSpeedProfileStore(void);
+void destroySpeedProfileStore(SpeedProfileStore* store);
+
+// Copia solo para evaluar (sin tabla de deduplicación): los lectores la
+// usan mientras el original sigue creciendo
+SpeedProfileStore* cloneSpeedProfileStore(const SpeedProfileStore* store);
+
+// Cuantizar los puntos (ordenados por minuto, sin repetir) y devolver el id
+// del perfil, reutilizando uno igual si ya existe. -1 si son inválidos
+int internSpeedProfile(SpeedProfileStore* store, const ProfileBreakpoint* points, int numPoints,
+                       ProfilePeriod period);
+
+// FIFO: entrar más tarde nunca hace salir antes. Para una carretera de
+// baseSeconds se cumple si el tiempo de viaje no baja más rápido que el
+// reloj. Si no, devuelve una variante con las caídas suavizadas (solo sube
+// factores, así que sobreestima) y la comparten las carreteras parecidas
+int fifoSpeedProfile(SpeedProfileStore* store, int profileId, int baseSeconds);
+bool isFifoSpeedProfile(const SpeedProfileStore* store, int profileId, int baseSeconds);
+
+// Segundos para recorrer una carretera de baseSeconds entrando en el
+// segundo secondOfWeek (cualquier valor >= 0; se reduce al período)
+static inline int profileTravelSeconds(const SpeedProfileStore* store, int profileId,
+                                       int baseSeconds, long secondOfWeek) {
+    const SpeedProfile* profile = &store->profiles[profileId];
+    const uint16_t* values = store->values + profile->offset;
+
+    long t = secondOfWeek % ((long)profile->numBuckets * PROFILE_BUCKET_SECONDS);
+    int bucket = (int)(t / PROFILE_BUCKET_SECONDS);
+    int elapsed = (int)(t - (long)bucket * PROFILE_BUCKET_SECONDS);
+    int from = values[bucket];
+    int to = values[bucket + 1 < profile->numBuckets ? bucket + 1 : 0];
+
+    // Un solo redondeo de la recta exacta: conserva FIFO al truncar
+    int64_t scaled = (int64_t)from * PROFILE_BUCKET_SECONDS + (int64_t)(to - from) * elapsed;
+    return (int)((int64_t)baseSeconds * scaled / ((int64_t)PROFILE_FACTOR_SCALE * PROFILE_BUCKET_SECONDS));
+}
+
+// Segundo de la semana (domingo 00:00 = 0) de un instante, en hora local
+long secondOfWeek(time_t when);
+
+#endif //SPEED_PROFILE_H
@@ -84,6 +84,11 @@ SocialNetwork* createSocialNetwork(int maxUsers) {
         net->userNetwork[i] = (int*)calloc(maxUsers, sizeof(int));
     }
     
+    // Vista CSR y memoria del BFS: se crean en la primera consulta
+    net->networkGraph = NULL;
+    net->bfsWorkspace = NULL;
+    net->bfsDistances = NULL;
+    
     // Crear índices hash
     net->userIndex = createHashMap(maxUsers);
     net->userIdIndex = createHashMap(maxUsers);
@@ -101,6 +106,10 @@ void destroySocialNetwork(SocialNetwork* network) {
     }
     free(network->userNetwork);
     
+    destroyCSRGraph(network->networkGraph);
+    destroyBFSWorkspace(network->bfsWorkspace);
+    free(network->bfsDistances);
+    
     // Liberar usuarios
     int numKeys;
     char** keys = hashMapGetKeys(network->userIndex, &numKeys);
@@ -227,6 +236,10 @@ bool addConnection(SocialNetwork* net, int userId1, int userId2,
     net->userNetwork[userId1 - 1][userId2 - 1] = weight;
     net->userNetwork[userId2 - 1][userId1 - 1] = weight;
     
+    // La vista CSR quedó vieja
+    destroyCSRGraph(net->networkGraph);
+    net->networkGraph = NULL;
+    
     // Agregar a listas de conexiones
     int* id1 = (int*)malloc(sizeof(int));
     int* id2 = (int*)malloc(sizeof(int));
@@ -264,18 +277,26 @@ int calculateSeparationDegree(SocialNetwork* net, int userId1, int userId2) {
     if (!net || userId1 <= 0 || userId2 <= 0) return -1;
     if (userId1 == userId2) return 0;
     
-    // Usar BFS para encontrar el camino más corto
-    SearchResult* result = bfs(net->userNetwork, net->maxUsers, userId1 - 1);
+    if (userId1 > net->maxUsers || userId2 > net->maxUsers) return -1;
     
-    if (!result) return -1;
+    // La matriz se pasa a CSR una vez por cambio de conexiones y la memoria
+    // del BFS se reutiliza entre consultas (calculateAverageSeparation hace
+    // una por par)
+    if (!net->networkGraph) {
+        net->networkGraph = csrFromMatrix(net->userNetwork, net->maxUsers, false);
+    }
+    if (!net->bfsWorkspace) {
+        net->bfsWorkspace = createBFSWorkspace(net->maxUsers, 0);
+        net->bfsDistances = (int*)malloc(net->maxUsers * sizeof(int));
+    }
     
-    int separation = -1;
-    if (result->visited[userId2 - 1]) {
-        separation = result->distances[userId2 - 1];
+    // BFS que termina al alcanzar el nivel de userId2
+    if (bfsDirectionOptimizing(net->networkGraph, userId1 - 1, userId2 - 1,
+                               net->bfsWorkspace, net->bfsDistances, NULL) < 0) {
+        return -1;
     }
     
-    freeSearchResult(result);
-    return separation;
+    return net->bfsDistances[userId2 - 1];
 }
 
 double calculateAverageSeparation(SocialNetwork* net) {
@@ -15,6 +15,7 @@
 #include "../algoritmos/dfs_bfs.h"
 #include "../algoritmos/dijkstra.h"
 #include "../algoritmos/cycle_detection.h"
+#include "../algoritmos/parallel_bfs.h"
 #include "../estructura_datos/hash_map.h"
 #include "../graph/graph.h"
 
@@ -82,6 +83,9 @@ typedef struct {
 // Red social completa
 typedef struct {
     int** userNetwork;         // Matriz de adyacencia (grafo)
+    CSRGraph* networkGraph;    // Vista CSR de userNetwork para BFS (NULL = reconstruir)
+    BFSWorkspace* bfsWorkspace;
+    int* bfsDistances;
     HashMap* userIndex;        // Índice rápido username -> User*
     HashMap* userIdIndex;      // Índice rápido userId -> User*
     List* communities;         // Comunidades detectadas
@@ -0,0 +1,436 @@
+//
+// Created by administrador on 6/30/25.
+//
+
+#include "benchmark_harness.h"
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ===============================
+// CONFIGURACIÓN
+// ===============================
+
+BenchmarkConfig defaultBenchmarkConfig(void) {
+    BenchmarkConfig config;
+    config.warmupRuns = HARNESS_DEFAULT_WARMUP;
+    config.repetitions = HARNESS_DEFAULT_REPETITIONS;
+    config.regressionThreshold = HARNESS_DEFAULT_THRESHOLD;
+    config.seed = HARNESS_DEFAULT_SEED;
+    config.collectCounters = false;
+    return config;
+}
+
+BenchmarkHarness* createBenchmarkHarness(BenchmarkConfig config) {
+    if (config.warmupRuns < 0) config.warmupRuns = 0;
+    if (config.repetitions < 1) config.repetitions = 1;
+    if (config.regressionThreshold < 0) config.regressionThreshold = 0;
+
+    BenchmarkHarness* harness = (BenchmarkHarness*)malloc(sizeof(BenchmarkHarness));
+    if (!harness) return NULL;
+
+    harness->config = config;
+    harness->stats = NULL;
+    harness->numStats = 0;
+    harness->capacity = 0;
+    harness->counters = config.collectCounters ? createPerfCounters() : NULL;
+    return harness;
+}
+
+void destroyBenchmarkHarness(BenchmarkHarness* harness) {
+    if (!harness) return;
+    destroyPerfCounters(harness->counters);
+    free(harness->stats);
+    free(harness);
+}
+
+// ===============================
+// MEDICIÓN
+// ===============================
+
+// Reloj monotónico en ms: no salta si se ajusta la hora del sistema
+static double monotonicMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void computeBenchmarkStats(const double* samples, int count, BenchmarkStats* stats) {
+    stats->repetitions = count;
+    stats->minMs = stats->medianMs = stats->p95Ms = 0;
+    stats->meanMs = stats->stddevMs = 0;
+    if (count <= 0) return;
+
+    double* sorted = (double*)malloc(count * sizeof(double));
+    if (!sorted) return;
+    memcpy(sorted, samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compareDoubles);
+
+    double sum = 0;
+    for (int i = 0; i < count; i++) sum += sorted[i];
+    double mean = sum / count;
+
+    double squares = 0;
+    for (int i = 0; i < count; i++) squares += (sorted[i] - mean) * (sorted[i] - mean);
+
+    // Percentil por rango más cercano: el menor valor que cubre el 95%
+    int p95Index = (int)ceil(0.95 * count) - 1;
+    if (p95Index < 0) p95Index = 0;
+
+    stats->minMs = sorted[0];
+    stats->medianMs = count % 2 ? sorted[count / 2]
+                                : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    stats->p95Ms = sorted[p95Index];
+    stats->meanMs = mean;
+    stats->stddevMs = count > 1 ? sqrt(squares / (count - 1)) : 0;
+
+    free(sorted);
+}
+
+static BenchmarkStats* appendStats(BenchmarkHarness* harness) {
+    if (harness->numStats == harness->capacity) {
+        int newCapacity = harness->capacity ? harness->capacity * 2 : 16;
+        BenchmarkStats* grown = (BenchmarkStats*)realloc(harness->stats, newCapacity * sizeof(BenchmarkStats));
+        if (!grown) return NULL;
+        harness->stats = grown;
+        harness->capacity = newCapacity;
+    }
+    BenchmarkStats* stats = &harness->stats[harness->numStats++];
+    memset(stats, 0, sizeof(BenchmarkStats));
+    return stats;
+}
+
+const BenchmarkStats* runBenchmarkCase(BenchmarkHarness* harness, const char* name, const char* generator,
+                                       int graphSize, int numEdges, BenchmarkCase run, void* context) {
+    if (!harness || !name || !run) return NULL;
+
+    int repetitions = harness->config.repetitions;
+    double* samples = (double*)malloc(repetitions * sizeof(double));
+    if (!samples) return NULL;
+
+    BenchmarkStats* stats = appendStats(harness);
+    if (!stats) {
+        free(samples);
+        return NULL;
+    }
+
+    snprintf(stats->name, HARNESS_NAME_LENGTH, "%s", name);
+    snprintf(stats->generator, HARNESS_NAME_LENGTH, "%s", generator ? generator : "-");
+    stats->graphSize = graphSize;
+    stats->numEdges = numEdges;
+
+    // Calentamiento: cachés, páginas y predictores quedan como en una corrida larga
+    bool success = true;
+    int settled = 0;
+    for (int i = 0; i < harness->config.warmupRuns; i++) {
+        settled = 0;
+        success = run(context, &settled) && success;
+    }
+
+    // Los contadores envuelven al reloj para que la lectura no entre en el tiempo
+    double counterSums[PERF_NUM_COUNTERS] = {0};
+    int counterRuns[PERF_NUM_COUNTERS] = {0};
+    bool useCounters = perfCountersAvailable(harness->counters);
+
+    for (int i = 0; i < repetitions; i++) {
+        settled = 0;
+        if (useCounters) startPerfCounters(harness->counters);
+
+        double start = monotonicMs();
+        success = run(context, &settled) && success;
+        samples[i] = monotonicMs() - start;
+
+        if (useCounters) {
+            PerfSample sample = stopPerfCounters(harness->counters);
+            for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+                if (!sample.valid[k]) continue;
+                counterSums[k] += (double)sample.values[k];
+                counterRuns[k]++;
+            }
+        }
+    }
+
+    computeBenchmarkStats(samples, repetitions, stats);
+    stats->success = success;
+    stats->settledVertices = settled;
+    for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+        stats->counterValid[k] = counterRuns[k] == repetitions;
+        stats->counters[k] = stats->counterValid[k] ? counterSums[k] / repetitions : 0;
+    }
+
+    free(samples);
+    return stats;
+}
+
+double benchmarkIPC(const BenchmarkStats* stats) {
+    if (!stats->counterValid[PERF_CYCLES] || !stats->counterValid[PERF_INSTRUCTIONS]) return -1;
+    if (stats->counters[PERF_CYCLES] <= 0) return -1;
+    return stats->counters[PERF_INSTRUCTIONS] / stats->counters[PERF_CYCLES];
+}
+
+double benchmarkMissesPerVertex(const BenchmarkStats* stats, PerfCounterKind kind) {
+    if (!stats->counterValid[kind] || stats->settledVertices <= 0) return -1;
+    return stats->counters[kind] / stats->settledVertices;
+}
+
+// ===============================
+// SALIDA
+// ===============================
+
+// Valor derivado o "-" si no está disponible
+static void formatMetric(char* buffer, size_t size, double value, int decimals) {
+    if (value < 0) snprintf(buffer, size, "-");
+    else snprintf(buffer, size, "%.*f", decimals, value);
+}
+
+// Columna del CSV: vacía si el contador no se pudo leer
+static void writeCounterCSV(FILE* file, bool valid, double value) {
+    if (valid) fprintf(file, ",%.0f", value);
+    else fprintf(file, ",");
+}
+
+static void printCounterStats(const BenchmarkHarness* harness) {
+    printf("\n🔬 CONTADORES DE HARDWARE (promedio por repetición)\n");
+    printf("%-22s %-10s %8s %8s %6s %14s %15s\n",
+           "Algoritmo", "Generador", "Vértices", "Fijados", "IPC", "Cache-miss/v", "Branch-miss/v");
+    printf("---------------------------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < harness->numStats; i++) {
+        const BenchmarkStats* s = &harness->stats[i];
+        char ipc[16], cacheMisses[16], branchMisses[16];
+        formatMetric(ipc, sizeof(ipc), benchmarkIPC(s), 2);
+        formatMetric(cacheMisses, sizeof(cacheMisses), benchmarkMissesPerVertex(s, PERF_CACHE_MISSES), 2);
+        formatMetric(branchMisses, sizeof(branchMisses), benchmarkMissesPerVertex(s, PERF_BRANCH_MISSES), 2);
+
+        printf("%-22s %-10s %8d %8d %6s %14s %15s\n",
+               s->name, s->generator, s->graphSize, s->settledVertices, ipc, cacheMisses, branchMisses);
+    }
+}
+
+void printBenchmarkStats(const BenchmarkHarness* harness) {
+    if (!harness) return;
+
+    printf("\n📊 RESULTADOS (%d calentamiento, %d repeticiones)\n",
+           harness->config.warmupRuns, harness->config.repetitions);
+    printf("%-22s %-10s %8s %9s %10s %10s %10s %10s %4s\n",
+           "Algoritmo", "Generador", "Vértices", "Aristas", "Min(ms)", "Mediana", "P95", "Desvío", "OK");
+    printf("---------------------------------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < harness->numStats; i++) {
+        const BenchmarkStats* s = &harness->stats[i];
+        printf("%-22s %-10s %8d %9d %10.3f %10.3f %10.3f %10.3f %4s\n",
+               s->name, s->generator, s->graphSize, s->numEdges,
+               s->minMs, s->medianMs, s->p95Ms, s->stddevMs, s->success ? "✅" : "❌");
+    }
+
+    if (perfCountersAvailable(harness->counters)) {
+        printCounterStats(harness);
+    }
+}
+
+bool saveBenchmarkStatsCSV(const BenchmarkHarness* harness, const char* filename) {
+    if (!harness || !filename) return false;
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        printf("❌ Error: No se pudo crear archivo %s\n", filename);
+        return false;
+    }
+
+    fprintf(file, "Algoritmo,Generador,Vertices,Aristas,Repeticiones,Min_ms,Mediana_ms,P95_ms,Media_ms,Desvio_ms,Estado,"
+                  "Fijados,Ciclos,Instrucciones,Cache_misses,Branch_misses\n");
+    for (int i = 0; i < harness->numStats; i++) {
+        const BenchmarkStats* s = &harness->stats[i];
+        fprintf(file, "%s,%s,%d,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%s,",
+                s->name, s->generator, s->graphSize, s->numEdges, s->repetitions,
+                s->minMs, s->medianMs, s->p95Ms, s->meanMs, s->stddevMs,
+                s->success ? "OK" : "ERROR");
+        fprintf(file, "%d", s->settledVertices);
+        for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+            writeCounterCSV(file, s->counterValid[k], s->counters[k]);
+        }
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    printf("💾 Resultados guardados en %s\n", filename);
+    return true;
+}
+
+// Los nombres son identificadores cortos, pero se escapan por las dudas
+static void writeJSONString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') fputc('\\', file);
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+bool saveBenchmarkStatsJSON(const BenchmarkHarness* harness, const char* filename) {
+    if (!harness || !filename) return false;
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        printf("❌ Error: No se pudo crear archivo %s\n", filename);
+        return false;
+    }
+
+    fprintf(file, "{\n  \"warmupRuns\": %d,\n  \"repetitions\": %d,\n  \"seed\": %u,\n  \"results\": [\n",
+            harness->config.warmupRuns, harness->config.repetitions, harness->config.seed);
+
+    for (int i = 0; i < harness->numStats; i++) {
+        const BenchmarkStats* s = &harness->stats[i];
+        fprintf(file, "    {\"algorithm\": ");
+        writeJSONString(file, s->name);
+        fprintf(file, ", \"generator\": ");
+        writeJSONString(file, s->generator);
+        fprintf(file, ", \"vertices\": %d, \"edges\": %d, \"repetitions\": %d, "
+                      "\"minMs\": %.6f, \"medianMs\": %.6f, \"p95Ms\": %.6f, \"meanMs\": %.6f, "
+                      "\"stddevMs\": %.6f, \"success\": %s, \"settledVertices\": %d",
+                s->graphSize, s->numEdges, s->repetitions,
+                s->minMs, s->medianMs, s->p95Ms, s->meanMs, s->stddevMs,
+                s->success ? "true" : "false", s->settledVertices);
+
+        // Contadores ausentes como null para distinguirlos de un cero real
+        for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+            fprintf(file, ", ");
+            writeJSONString(file, perfCounterName((PerfCounterKind)k));
+            if (s->counterValid[k]) fprintf(file, ": %.0f", s->counters[k]);
+            else fprintf(file, ": null");
+        }
+        double ipc = benchmarkIPC(s);
+        if (ipc >= 0) fprintf(file, ", \"ipc\": %.4f", ipc);
+        else fprintf(file, ", \"ipc\": null");
+
+        fprintf(file, "}%s\n", i + 1 < harness->numStats ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    printf("💾 Resultados guardados en %s\n", filename);
+    return true;
+}
+
+// ===============================
+// COMPARACIÓN CONTRA LA BASE
+// ===============================
+
+// Una fila del CSV base: solo hacen falta la clave y la mediana (las
+// columnas de contadores que vienen después se ignoran)
+typedef struct {
+    char name[HARNESS_NAME_LENGTH];
+    char generator[HARNESS_NAME_LENGTH];
+    int graphSize;
+    double medianMs;
+} BaselineRow;
+
+static bool parseBaselineRow(const char* line, BaselineRow* row) {
+    char fields[11][HARNESS_NAME_LENGTH];
+    int count = 0;
+    int length = 0;
+
+    for (const char* c = line; ; c++) {
+        if (*c == ',' || *c == '\n' || *c == '\r' || *c == '\0') {
+            if (count < 11) fields[count][length] = '\0';
+            count++;
+            length = 0;
+            if (*c != ',') break;
+        } else if (count < 11 && length < HARNESS_NAME_LENGTH - 1) {
+            fields[count][length++] = *c;
+        }
+    }
+    if (count < 11) return false;
+
+    snprintf(row->name, HARNESS_NAME_LENGTH, "%s", fields[0]);
+    snprintf(row->generator, HARNESS_NAME_LENGTH, "%s", fields[1]);
+    row->graphSize = atoi(fields[2]);
+    row->medianMs = atof(fields[6]);
+    return true;
+}
+
+int compareWithBaseline(const BenchmarkHarness* harness, const char* baselineFile) {
+    if (!harness || !baselineFile) return -1;
+
+    FILE* file = fopen(baselineFile, "r");
+    if (!file) {
+        printf("❌ Error: No se pudo abrir la base %s\n", baselineFile);
+        return -1;
+    }
+
+    BaselineRow* rows = NULL;
+    int numRows = 0;
+    int capacity = 0;
+    char line[512];
+
+    // La primera línea es la cabecera
+    bool header = true;
+    while (fgets(line, sizeof(line), file)) {
+        if (header) {
+            header = false;
+            continue;
+        }
+        if (numRows == capacity) {
+            int newCapacity = capacity ? capacity * 2 : 16;
+            BaselineRow* grown = (BaselineRow*)realloc(rows, newCapacity * sizeof(BaselineRow));
+            if (!grown) {
+                free(rows);
+                fclose(file);
+                return -1;
+            }
+            rows = grown;
+            capacity = newCapacity;
+        }
+        if (parseBaselineRow(line, &rows[numRows])) numRows++;
+    }
+    fclose(file);
+
+    double threshold = harness->config.regressionThreshold;
+    int regressions = 0;
+
+    printf("\n🔍 COMPARACIÓN CONTRA %s (umbral %.0f%%)\n", baselineFile, threshold * 100);
+    printf("%-22s %-10s %8s %12s %12s %9s\n", "Algoritmo", "Generador", "Vértices", "Base(ms)", "Actual(ms)", "Cambio");
+    printf("---------------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < harness->numStats; i++) {
+        const BenchmarkStats* s = &harness->stats[i];
+
+        const BaselineRow* base = NULL;
+        for (int r = 0; r < numRows && !base; r++) {
+            if (rows[r].graphSize == s->graphSize &&
+                strcmp(rows[r].name, s->name) == 0 &&
+                strcmp(rows[r].generator, s->generator) == 0) {
+                base = &rows[r];
+            }
+        }
+
+        if (!base) {
+            printf("%-22s %-10s %8d %12s %12.3f %9s 🆕\n",
+                   s->name, s->generator, s->graphSize, "-", s->medianMs, "-");
+            continue;
+        }
+
+        double change = base->medianMs > 0 ? (s->medianMs - base->medianMs) / base->medianMs : 0;
+        bool regression = s->medianMs > base->medianMs * (1.0 + threshold);
+        if (regression) regressions++;
+
+        printf("%-22s %-10s %8d %12.3f %12.3f %+8.1f%% %s\n",
+               s->name, s->generator, s->graphSize, base->medianMs, s->medianMs,
+               change * 100, regression ? "⚠️  REGRESIÓN" : "✅");
+    }
+
+    free(rows);
+
+    if (regressions > 0) {
+        printf("⚠️  %d caso(s) más lentos que la base\n", regressions);
+    } else {
+        printf("✅ Sin regresiones\n");
+    }
+    return regressions;
+}
@@ -0,0 +1,84 @@
+//
+// Created by administrador on 6/30/25.
+//
+
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "perf_counters.h"
+
+#define HARNESS_DEFAULT_WARMUP 2
+#define HARNESS_DEFAULT_REPETITIONS 10
+#define HARNESS_DEFAULT_THRESHOLD 0.10   // 10% más lento que la base = regresión
+#define HARNESS_DEFAULT_SEED 12345u
+#define HARNESS_NAME_LENGTH 64
+
+typedef struct {
+    int warmupRuns;                // Corridas descartadas antes de medir
+    int repetitions;               // Corridas medidas
+    double regressionThreshold;    // Fracción sobre la mediana de la base
+    unsigned int seed;             // Semilla de los generadores: misma entrada en cada ejecución
+    bool collectCounters;          // Leer contadores de hardware en cada repetición medida
+} BenchmarkConfig;
+
+// Estadísticas de un caso (tiempos en ms)
+typedef struct {
+    char name[HARNESS_NAME_LENGTH];
+    char generator[HARNESS_NAME_LENGTH];
+    int graphSize;
+    int numEdges;
+    int repetitions;
+    double minMs;
+    double medianMs;
+    double p95Ms;
+    double meanMs;
+    double stddevMs;
+    bool success;
+    int settledVertices;                        // Informado por el caso (0 = no aplica)
+    double counters[PERF_NUM_COUNTERS];         // Promedio por repetición
+    bool counterValid[PERF_NUM_COUNTERS];       // false si no se pudo leer en todas
+} BenchmarkStats;
+
+typedef struct {
+    BenchmarkConfig config;
+    BenchmarkStats* stats;
+    int numStats;
+    int capacity;
+    PerfCounters* counters;        // NULL si no se piden contadores
+} BenchmarkHarness;
+
+// Una repetición del caso; devuelve false si el resultado no es correcto.
+// settledVertices (arranca en 0) recibe los vértices fijados por la
+// corrida, para normalizar los misses por vértice
+typedef bool (*BenchmarkCase)(void* context, int* settledVertices);
+
+BenchmarkConfig defaultBenchmarkConfig(void);
+BenchmarkHarness* createBenchmarkHarness(BenchmarkConfig config);
+void destroyBenchmarkHarness(BenchmarkHarness* harness);
+
+// Correr warmupRuns + repetitions veces y guardar las estadísticas
+const BenchmarkStats* runBenchmarkCase(BenchmarkHarness* harness, const char* name, const char* generator,
+                                       int graphSize, int numEdges, BenchmarkCase run, void* context);
+
+// Mínimo, mediana, percentil 95 (rango más cercano), media y desvío muestral
+void computeBenchmarkStats(const double* samples, int count, BenchmarkStats* stats);
+
+// Métricas derivadas; devuelven -1 si faltan los contadores o los vértices
+double benchmarkIPC(const BenchmarkStats* stats);
+double benchmarkMissesPerVertex(const BenchmarkStats* stats, PerfCounterKind kind);
+
+// Salida
+void printBenchmarkStats(const BenchmarkHarness* harness);
+bool saveBenchmarkStatsCSV(const BenchmarkHarness* harness, const char* filename);
+bool saveBenchmarkStatsJSON(const BenchmarkHarness* harness, const char* filename);
+
+// Comparar contra un CSV guardado con saveBenchmarkStatsCSV. Un caso es
+// regresión si su mediana supera la de la base en más de
+// regressionThreshold. Devuelve la cantidad de regresiones o -1 si no se
+// pudo leer la base
+int compareWithBaseline(const BenchmarkHarness* harness, const char* baselineFile);
+
+#endif //BENCHMARK_HARNESS_H
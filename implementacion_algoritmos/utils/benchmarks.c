@@ -4,6 +4,23 @@
 #include <string.h>
 #include <stdbool.h>
 #include <sys/time.h>
+#include "../algoritmos/dijkstra.h"
+#include "../algoritmos/bellman_ford.h"
+#include "../algoritmos/kruskal.h"
+#include "../algoritmos/boruvka.h"
+#include "../algoritmos/connected_components.h"
+#include "../algoritmos/parallel_bfs.h"
+#include "../algoritmos/dfs_bfs.h"
+#include "../estructura_datos/priority_queue.h"
+#include "../algoritmos/delta_stepping.h"
+#include "../algoritmos/distance_table.h"
+#include "../utils/parallel_utils.h"
+#include "../graph/graph.h"
+#include "../utils/file_io.h"
+#include "../utils/binary_graph.h"
+#include "../utils/benchmark_harness.h"
+#include "../utils/graph_generators.h"
+#include <math.h>
 
 
 
@@ -33,6 +50,22 @@ void runCompleteBenchmark();
 void printBenchmarkResults(BenchmarkSuite* suite);
 void saveBenchmarkResults(BenchmarkSuite* suite, const char* filename);
 void freeBenchmarkSuite(BenchmarkSuite* suite);
+void benchmarkDijkstraQueues();
+void benchmarkPriorityQueues();
+CSRGraph* generateSparseCSR(int numVertices, int avgDegree, int maxWeight);
+void benchmarkDeltaStepping();
+void benchmarkDistanceTable();
+void benchmarkBellmanFordVariants();
+void benchmarkMST();
+void benchmarkConnectedComponents();
+void benchmarkParallelBFS();
+void benchmarkDynamicGraph();
+void benchmarkBinaryGraph();
+void benchmarkStreamingLoader();
+void benchmarkParallelIngestion();
+void setBenchmarkSeed(unsigned int seed);
+int runHarnessBenchmarks(BenchmarkConfig config, const char* baselineFile);
+void benchmarkGraphGenerators();
 
 // Obtener tiempo actual en microsegundos
 double getCurrentTime() {
@@ -68,6 +101,18 @@ void addBenchmarkResult(BenchmarkSuite* suite, const char* algName, double time,
     suite->numResults++;
 }
 
+// Semilla de los generadores: 0 = reloj (entradas distintas en cada
+// ejecución), otro valor = mismos grafos siempre para comparar corridas
+static unsigned int benchmarkSeed = 0;
+
+void setBenchmarkSeed(unsigned int seed) {
+    benchmarkSeed = seed;
+}
+
+static void seedBenchmarkGenerators() {
+    srand(benchmarkSeed ? benchmarkSeed : (unsigned int)time(NULL));
+}
+
 // Generar grafo aleatorio
 int** generateRandomGraph(int numVertices, double density, int maxWeight) {
     int** graph = (int**)malloc(numVertices * sizeof(int*));
@@ -75,7 +120,7 @@ int** generateRandomGraph(int numVertices, double density, int maxWeight) {
         graph[i] = (int*)calloc(numVertices, sizeof(int));
     }
     
-    srand(time(NULL));
+    seedBenchmarkGenerators();
     
     for (int i = 0; i < numVertices; i++) {
         for (int j = i + 1; j < numVertices; j++) {
@@ -96,7 +141,7 @@ int** generateCompleteGraph(int numVertices, int maxWeight) {
         graph[i] = (int*)calloc(numVertices, sizeof(int));
     }
     
-    srand(time(NULL));
+    seedBenchmarkGenerators();
     
     for (int i = 0; i < numVertices; i++) {
         for (int j = i + 1; j < numVertices; j++) {
@@ -115,7 +160,7 @@ int** generateSparseGraph(int numVertices, int avgDegree, int maxWeight) {
         graph[i] = (int*)calloc(numVertices, sizeof(int));
     }
     
-    srand(time(NULL));
+    seedBenchmarkGenerators();
     
     for (int i = 0; i < numVertices; i++) {
         int degree = avgDegree + (rand() % 3) - 1; // ±1 variación
@@ -326,6 +371,1072 @@ void freeBenchmarkSuite(BenchmarkSuite* suite) {
     }
 }
 
+// Comparar las colas de Dijkstra (escaneo lineal, heap binario, radix heap)
+// sobre matriz y CSR variando la densidad, para ver el punto de cruce.
+// El escaneo lineal solo conviene en grafos casi completos sobre matriz:
+// ahí los E relajamientos dominan y el heap agrega log V por arista.
+// Con densidades bajas el heap sobre CSR es órdenes de magnitud más rápido.
+void benchmarkDijkstraQueues() {
+    printf("🏁 DIJKSTRA: COMPARACIÓN DE COLAS DE PRIORIDAD\n");
+    printf("==============================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+
+    int sizes[] = {500, 2000};
+    double densities[] = {0.002, 0.01, 0.05, 0.2, 0.5, 0.9};
+    int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+    int numDensities = sizeof(densities) / sizeof(densities[0]);
+    const char* queueNames[] = {"Lineal", "Heap", "Radix"};
+    DijkstraQueueType queueTypes[] = {DIJKSTRA_LINEAR_SCAN, DIJKSTRA_DARY_HEAP, DIJKSTRA_RADIX_HEAP};
+    int sources = 10; // Promediar sobre varios orígenes
+
+    printf("%-8s %-9s %-10s | %-12s %-12s %-12s | %-12s %-12s %-12s\n",
+           "Vértices", "Densidad", "Aristas",
+           "Mat-Lineal", "Mat-Heap", "Mat-Radix", "CSR-Lineal", "CSR-Heap", "CSR-Radix");
+
+    for (int s = 0; s < numSizes; s++) {
+        int n = sizes[s];
+        for (int d = 0; d < numDensities; d++) {
+            int** graph = generateRandomGraph(n, densities[d], 100);
+            CSRGraph* csr = csrFromMatrix(graph, n, false);
+            int numEdges = csr->numEdges / 2;
+            double times[2][3];
+
+            for (int q = 0; q < 3; q++) {
+                double startTime = getCurrentTime();
+                for (int src = 0; src < sources; src++) {
+                    free(dijkstraAllPathsWithQueue(graph, n, src, queueTypes[q]));
+                }
+                times[0][q] = (getCurrentTime() - startTime) / 1000.0 / sources;
+
+                startTime = getCurrentTime();
+                for (int src = 0; src < sources; src++) {
+                    free(dijkstraAllPathsCSRWithQueue(csr, src, queueTypes[q]));
+                }
+                times[1][q] = (getCurrentTime() - startTime) / 1000.0 / sources;
+
+                char name[50];
+                snprintf(name, sizeof(name), "Dijkstra-Mat-%s", queueNames[q]);
+                addBenchmarkResult(suite, name, times[0][q], n, numEdges, true);
+                snprintf(name, sizeof(name), "Dijkstra-CSR-%s", queueNames[q]);
+                addBenchmarkResult(suite, name, times[1][q], n, numEdges, true);
+            }
+
+            printf("%-8d %-9.3f %-10d | %-12.3f %-12.3f %-12.3f | %-12.3f %-12.3f %-12.3f\n",
+                   n, densities[d], numEdges,
+                   times[0][0], times[0][1], times[0][2], times[1][0], times[1][1], times[1][2]);
+
+            destroyCSRGraph(csr);
+            for (int i = 0; i < n; i++) {
+                free(graph[i]);
+            }
+            free(graph);
+        }
+    }
+
+    printf("(tiempos en ms por consulta de todos los caminos)\n");
+    saveBenchmarkResults(suite, "benchmark_dijkstra_queues.csv");
+    freeBenchmarkSuite(suite);
+}
+
+// Carga tipo Dijkstra: insertar n ids, y luego alternar extracciones con
+// decrease-key sobre ids que siguen en la cola. Devuelve ms.
+static double runIndexedQueueWorkload(int n, int arity, int decreasesPerPop) {
+    IndexedPriorityQueue* ipq = createIndexedPriorityQueueDary(n, arity);
+    double startTime = getCurrentTime();
+
+    for (int id = 0; id < n; id++) {
+        ipqPush(ipq, id, 1000000 + rand() % 1000000);
+    }
+    while (!ipqIsEmpty(ipq)) {
+        int popped = ipqPop(ipq);
+        for (int k = 0; k < decreasesPerPop; k++) {
+            int id = (popped * 31 + k * 7919) % n;
+            int current = ipqGetPriority(ipq, id);
+            if (current > 0) ipqDecreaseKey(ipq, id, current - 1 - rand() % 1000);
+        }
+    }
+
+    double elapsed = (getCurrentTime() - startTime) / 1000.0;
+    destroyIndexedPriorityQueue(ipq);
+    return elapsed;
+}
+
+// Misma carga sobre PriorityQueue: contains/update buscan linealmente
+static double runPointerQueueWorkload(int n, int decreasesPerPop) {
+    PriorityQueue* pq = createPriorityQueue(n, true);
+    int* ids = (int*)malloc(n * sizeof(int));
+    int* keys = (int*)malloc(n * sizeof(int));
+    bool* inQueue = (bool*)malloc(n * sizeof(bool));
+    double startTime = getCurrentTime();
+
+    for (int id = 0; id < n; id++) {
+        ids[id] = id;
+        keys[id] = 1000000 + rand() % 1000000;
+        inQueue[id] = true;
+        pqPush(pq, &ids[id], keys[id]);
+    }
+    while (!pqIsEmpty(pq)) {
+        int popped = *(int*)pqPop(pq);
+        inQueue[popped] = false;
+        for (int k = 0; k < decreasesPerPop; k++) {
+            int id = (popped * 31 + k * 7919) % n;
+            if (inQueue[id] && pqContains(pq, &ids[id])) {
+                keys[id] -= 1 + rand() % 1000;
+                pqUpdatePriority(pq, &ids[id], keys[id]);
+            }
+        }
+    }
+
+    double elapsed = (getCurrentTime() - startTime) / 1000.0;
+    destroyPriorityQueue(pq);
+    free(ids);
+    free(keys);
+    free(inQueue);
+    return elapsed;
+}
+
+// Microbenchmark: PriorityQueue (búsqueda lineal) contra el heap indexado
+// binario, 4-ario y 8-ario
+void benchmarkPriorityQueues() {
+    printf("🏁 COLAS DE PRIORIDAD: PriorityQueue vs heap indexado\n");
+    printf("====================================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int sizes[] = {1000, 10000, 100000, 1000000};
+    int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+    int decreasesPerPop = 4;
+
+    printf("%-10s %-14s %-12s %-12s %-12s\n", "Elementos", "PriorityQueue", "Indexado-2", "Indexado-4", "Indexado-8");
+
+    for (int s = 0; s < numSizes; s++) {
+        int n = sizes[s];
+
+        // La versión lineal es O(n²): solo se mide en tamaños chicos
+        double pointerTime = -1;
+        if (n <= 10000) {
+            pointerTime = runPointerQueueWorkload(n, decreasesPerPop);
+            addBenchmarkResult(suite, "PQ-Puntero", pointerTime, n, 0, true);
+        }
+
+        double binaryTime = runIndexedQueueWorkload(n, 2, decreasesPerPop);
+        double quaternaryTime = runIndexedQueueWorkload(n, 4, decreasesPerPop);
+        double octaryTime = runIndexedQueueWorkload(n, 8, decreasesPerPop);
+        addBenchmarkResult(suite, "PQ-Indexado-2", binaryTime, n, 0, true);
+        addBenchmarkResult(suite, "PQ-Indexado-4", quaternaryTime, n, 0, true);
+        addBenchmarkResult(suite, "PQ-Indexado-8", octaryTime, n, 0, true);
+
+        if (pointerTime >= 0) {
+            printf("%-10d %-14.3f %-12.3f %-12.3f %-12.3f\n", n, pointerTime, binaryTime, quaternaryTime, octaryTime);
+        } else {
+            printf("%-10d %-14s %-12.3f %-12.3f %-12.3f\n", n, "-", binaryTime, quaternaryTime, octaryTime);
+        }
+    }
+
+    printf("(tiempos en ms)\n");
+    saveBenchmarkResults(suite, "benchmark_priority_queues.csv");
+    freeBenchmarkSuite(suite);
+}
+
+// Generar grafo disperso no dirigido directamente en CSR (sin matriz V²)
+CSRGraph* generateSparseCSR(int numVertices, int avgDegree, int maxWeight) {
+    int numEdges = numVertices * avgDegree / 2;
+    Edge* edges = (Edge*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(Edge));
+
+    seedBenchmarkGenerators();
+
+    for (int i = 0; i < numEdges; i++) {
+        edges[i].src = rand() % numVertices;
+        edges[i].dest = rand() % numVertices;
+        edges[i].weight = 1 + rand() % maxWeight;
+    }
+
+    CSRGraph* csr = csrFromEdges(numVertices, edges, numEdges, false);
+    free(edges);
+    return csr;
+}
+
+// Escalado de delta-stepping con la cantidad de hilos, contra Dijkstra
+// secuencial sobre el mismo CSR. También verifica que las distancias
+// sean idénticas.
+void benchmarkDeltaStepping() {
+    printf("🏁 DELTA-STEPPING: ESCALADO CON HILOS\n");
+    printf("====================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int sizes[] = {100000, 1000000};
+    int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+    int maxThreads = resolveThreadCount(0);
+    int sources = 3;
+
+    printf("Núcleos disponibles: %d\n", maxThreads);
+    printf("%-10s %-10s %-8s %-8s %-12s %-10s %-10s\n",
+           "Vértices", "Aristas", "Delta", "Hilos", "Tiempo(ms)", "Speedup", "Idéntico");
+
+    for (int s = 0; s < numSizes; s++) {
+        int n = sizes[s];
+        CSRGraph* csr = generateSparseCSR(n, 8, 1000);
+        int delta = deltaSteppingSuggestDelta(csr);
+
+        int** reference = (int**)malloc(sources * sizeof(int*));
+        double startTime = getCurrentTime();
+        for (int src = 0; src < sources; src++) {
+            reference[src] = dijkstraAllPathsCSR(csr, src);
+        }
+        double sequentialTime = (getCurrentTime() - startTime) / 1000.0 / sources;
+        addBenchmarkResult(suite, "Dijkstra-CSR", sequentialTime, n, csr->numEdges / 2, true);
+        printf("%-10d %-10d %-8s %-8s %-12.3f %-10s %-10s\n",
+               n, csr->numEdges / 2, "-", "1", sequentialTime, "1.00", "-");
+
+        // 1, 2, 4, ... hasta todos los núcleos
+        for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+            bool identical = true;
+            startTime = getCurrentTime();
+            for (int src = 0; src < sources; src++) {
+                int* dist = deltaSteppingCSR(csr, src, delta, threads);
+                identical = identical && memcmp(dist, reference[src], n * sizeof(int)) == 0;
+                free(dist);
+            }
+            double elapsed = (getCurrentTime() - startTime) / 1000.0 / sources;
+
+            char name[50];
+            snprintf(name, sizeof(name), "DeltaStepping-%dT", threads);
+            addBenchmarkResult(suite, name, elapsed, n, csr->numEdges / 2, identical);
+            printf("%-10d %-10d %-8d %-8d %-12.3f %-10.2f %-10s\n",
+                   n, csr->numEdges / 2, delta, threads, elapsed, sequentialTime / elapsed,
+                   identical ? "✅" : "❌");
+
+            if (threads == maxThreads) break;
+        }
+
+        for (int src = 0; src < sources; src++) {
+            free(reference[src]);
+        }
+        free(reference);
+        destroyCSRGraph(csr);
+    }
+
+    printf("(tiempos en ms por origen; speedup respecto de Dijkstra secuencial)\n");
+    saveBenchmarkResults(suite, "benchmark_delta_stepping.csv");
+    freeBenchmarkSuite(suite);
+}
+
+// Tabla N x M: una llamada a dijkstraCSR por par contra distanceTable
+void benchmarkDistanceTable() {
+    printf("🏁 TABLA DE DISTANCIAS N x M\n");
+    printf("===========================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int n = 20000;
+    int numSources = 10, numTargets = 50;
+    CSRGraph* csr = generateSparseCSR(n, 6, 100);
+
+    int* sources = (int*)malloc(numSources * sizeof(int));
+    int* targets = (int*)malloc(numTargets * sizeof(int));
+    for (int i = 0; i < numSources; i++) sources[i] = rand() % n;
+    for (int j = 0; j < numTargets; j++) targets[j] = rand() % n;
+
+    int* pairTable = (int*)malloc(numSources * numTargets * sizeof(int));
+    double startTime = getCurrentTime();
+    for (int i = 0; i < numSources; i++) {
+        for (int j = 0; j < numTargets; j++) {
+            PathResult* result = dijkstraCSR(csr, sources[i], targets[j]);
+            pairTable[i * numTargets + j] = result->totalWeight;
+            freePathResult(result);
+        }
+    }
+    double pairTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Tabla-PorPar", pairTime, n, csr->numEdges / 2, true);
+
+    startTime = getCurrentTime();
+    int* table = distanceTable(csr, sources, numSources, targets, numTargets, 1);
+    double singleTime = (getCurrentTime() - startTime) / 1000.0;
+    bool identical = memcmp(table, pairTable, numSources * numTargets * sizeof(int)) == 0;
+    addBenchmarkResult(suite, "Tabla-1Hilo", singleTime, n, csr->numEdges / 2, identical);
+    free(table);
+
+    int threads = resolveThreadCount(0);
+    startTime = getCurrentTime();
+    table = distanceTable(csr, sources, numSources, targets, numTargets, threads);
+    double parallelTime = (getCurrentTime() - startTime) / 1000.0;
+    identical = identical && memcmp(table, pairTable, numSources * numTargets * sizeof(int)) == 0;
+    addBenchmarkResult(suite, "Tabla-Paralela", parallelTime, n, csr->numEdges / 2, identical);
+    free(table);
+
+    printf("Grafo: %d vértices, %d aristas; tabla %d x %d\n", n, csr->numEdges / 2, numSources, numTargets);
+    printf("%-28s %-12s\n", "Método", "Tiempo(ms)");
+    printf("%-28s %-12.3f\n", "dijkstraCSR por par", pairTime);
+    printf("%-28s %-12.3f\n", "distanceTable (1 hilo)", singleTime);
+    printf("%-28s %-12.3f (%d hilos)\n", "distanceTable (paralela)", parallelTime, threads);
+    printf("Resultados idénticos: %s\n", identical ? "✅" : "❌");
+
+    saveBenchmarkResults(suite, "benchmark_distance_table.csv");
+    freeBenchmarkSuite(suite);
+    free(pairTable);
+    free(sources);
+    free(targets);
+    destroyCSRGraph(csr);
+}
+
+// Grafo de tarifas dirigido con pesos negativos pero sin ciclos negativos:
+// w(u,v) = base + p[u] - p[v] con base > 0, así todo ciclo suma positivo
+static CSRGraph* generateFareCSR(int numVertices, int avgDegree, int maxWeight) {
+    int numEdges = numVertices * avgDegree;
+    Edge* edges = (Edge*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(Edge));
+    int* potential = (int*)malloc(numVertices * sizeof(int));
+
+    seedBenchmarkGenerators();
+
+    for (int v = 0; v < numVertices; v++) {
+        potential[v] = rand() % maxWeight;
+    }
+    for (int i = 0; i < numEdges; i++) {
+        edges[i].src = rand() % numVertices;
+        edges[i].dest = rand() % numVertices;
+        edges[i].weight = 1 + rand() % maxWeight + potential[edges[i].src] - potential[edges[i].dest];
+    }
+
+    CSRGraph* csr = csrFromEdges(numVertices, edges, numEdges, true);
+    free(potential);
+    free(edges);
+    return csr;
+}
+
+// Bellman-Ford por pasadas completas contra la cola (SPFA) y el kernel
+// sobre arreglos de aristas, en grafos con pesos negativos
+void benchmarkBellmanFordVariants() {
+    printf("🏁 BELLMAN-FORD: PASADAS, COLA Y ARREGLOS DE ARISTAS\n");
+    printf("===================================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int sizes[] = {1000, 10000, 50000};
+    int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("Kernel de relajación: %s\n", bellmanFordUsesAVX2() ? "AVX2" : "escalar");
+    printf("%-10s %-10s %-14s %-14s %-14s %-10s\n",
+           "Vértices", "Aristas", "CSR(ms)", "Cola(ms)", "Arreglos(ms)", "Idéntico");
+
+    for (int s = 0; s < numSizes; s++) {
+        int n = sizes[s];
+        CSRGraph* csr = generateFareCSR(n, 8, 500);
+        int target = n - 1;
+
+        double startTime = getCurrentTime();
+        PathResult* reference = bellmanFordCSR(csr, 0, target);
+        double csrTime = (getCurrentTime() - startTime) / 1000.0;
+
+        startTime = getCurrentTime();
+        PathResult* queued = bellmanFordQueueCSR(csr, 0, target);
+        double queueTime = (getCurrentTime() - startTime) / 1000.0;
+
+        startTime = getCurrentTime();
+        PathResult* vectorized = bellmanFordVectorized(csr, 0, target);
+        double arraysTime = (getCurrentTime() - startTime) / 1000.0;
+
+        bool identical = queued->totalWeight == reference->totalWeight &&
+                         vectorized->totalWeight == reference->totalWeight;
+
+        addBenchmarkResult(suite, "BellmanFord-CSR", csrTime, n, csr->numEdges, true);
+        addBenchmarkResult(suite, "BellmanFord-Cola", queueTime, n, csr->numEdges, identical);
+        addBenchmarkResult(suite, "BellmanFord-Arreglos", arraysTime, n, csr->numEdges, identical);
+        printf("%-10d %-10d %-14.3f %-14.3f %-14.3f %-10s\n",
+               n, csr->numEdges, csrTime, queueTime, arraysTime, identical ? "✅" : "❌");
+
+        freePathResult(reference);
+        freePathResult(queued);
+        freePathResult(vectorized);
+        destroyCSRGraph(csr);
+    }
+
+    saveBenchmarkResults(suite, "benchmark_bellman_ford.csv");
+    freeBenchmarkSuite(suite);
+}
+
+// MST sobre grafos dispersos grandes: Kruskal con qsort completo contra
+// filter-Kruskal y Borůvka paralelo con 1, 2, 4, ... hilos
+void benchmarkMST() {
+    printf("🏁 ÁRBOL DE EXPANSIÓN MÍNIMA EN GRAFOS GRANDES\n");
+    printf("============================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int sizes[] = {100000, 1000000};
+    int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+    int maxThreads = resolveThreadCount(0);
+
+    printf("Núcleos disponibles: %d\n", maxThreads);
+    printf("%-10s %-10s %-22s %-12s %-10s\n", "Vértices", "Aristas", "Método", "Tiempo(ms)", "Idéntico");
+
+    for (int s = 0; s < numSizes; s++) {
+        int n = sizes[s];
+        CSRGraph* csr = generateSparseCSR(n, 8, 100000);
+        int m = csr->numEdges / 2;
+
+        double startTime = getCurrentTime();
+        MST* reference = kruskalMSTCSR(csr);
+        double elapsed = (getCurrentTime() - startTime) / 1000.0;
+        addBenchmarkResult(suite, "Kruskal-CSR", elapsed, n, m, true);
+        printf("%-10d %-10d %-22s %-12.3f %-10s\n", n, m, "Kruskal (qsort)", elapsed, "-");
+
+        startTime = getCurrentTime();
+        MST* mst = filterKruskalMSTCSR(csr);
+        elapsed = (getCurrentTime() - startTime) / 1000.0;
+        bool identical = mst->totalWeight == reference->totalWeight && mst->edgeCount == reference->edgeCount;
+        addBenchmarkResult(suite, "FilterKruskal", elapsed, n, m, identical);
+        printf("%-10d %-10d %-22s %-12.3f %-10s\n", n, m, "Filter-Kruskal", elapsed, identical ? "✅" : "❌");
+        freeMST(mst);
+
+        for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+            startTime = getCurrentTime();
+            mst = boruvkaMSTCSR(csr, threads);
+            elapsed = (getCurrentTime() - startTime) / 1000.0;
+            identical = mst->totalWeight == reference->totalWeight && mst->edgeCount == reference->edgeCount;
+
+            char name[50];
+            snprintf(name, sizeof(name), "Boruvka-%dT", threads);
+            addBenchmarkResult(suite, name, elapsed, n, m, identical);
+            printf("%-10d %-10d %-22s %-12.3f %-10s\n", n, m, name, elapsed, identical ? "✅" : "❌");
+            freeMST(mst);
+
+            if (threads == maxThreads) break;
+        }
+
+        freeMST(reference);
+        destroyCSRGraph(csr);
+    }
+
+    saveBenchmarkResults(suite, "benchmark_mst.csv");
+    freeBenchmarkSuite(suite);
+}
+
+// Componentes conexos con el UnionFind secuencial contra el concurrente
+// repartido entre 1, 2, 4, ... hilos
+void benchmarkConnectedComponents() {
+    printf("🏁 COMPONENTES CONEXOS EN PARALELO\n");
+    printf("=================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int n = 2000000;
+    int m = 4000000;
+    int maxThreads = resolveThreadCount(0);
+
+    Edge* edges = (Edge*)malloc(m * sizeof(Edge));
+    seedBenchmarkGenerators();
+    for (int i = 0; i < m; i++) {
+        edges[i].src = rand() % n;
+        edges[i].dest = rand() % n;
+        edges[i].weight = 1;
+    }
+
+    double startTime = getCurrentTime();
+    UnionFind* uf = createUnionFind(n);
+    for (int i = 0; i < m; i++) {
+        unionByRank(uf, edges[i].src, edges[i].dest);
+    }
+    int expected = getNumSets(uf);
+    double sequentialTime = (getCurrentTime() - startTime) / 1000.0;
+    destroyUnionFind(uf);
+    addBenchmarkResult(suite, "UnionFind-Secuencial", sequentialTime, n, m, true);
+
+    printf("Núcleos disponibles: %d\n", maxThreads);
+    printf("Grafo: %d vértices, %d aristas, %d componentes\n", n, m, expected);
+    printf("%-8s %-12s %-10s %-10s\n", "Hilos", "Tiempo(ms)", "Speedup", "Idéntico");
+    printf("%-8s %-12.3f %-10s %-10s\n", "sec", sequentialTime, "1.00", "-");
+
+    for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        int numComponents;
+        startTime = getCurrentTime();
+        int* components = connectedComponentsParallel(n, edges, m, threads, &numComponents);
+        double elapsed = (getCurrentTime() - startTime) / 1000.0;
+        bool identical = numComponents == expected;
+
+        char name[50];
+        snprintf(name, sizeof(name), "Componentes-%dT", threads);
+        addBenchmarkResult(suite, name, elapsed, n, m, identical);
+        printf("%-8d %-12.3f %-10.2f %-10s\n", threads, elapsed, sequentialTime / elapsed,
+               identical ? "✅" : "❌");
+        free(components);
+
+        if (threads == maxThreads) break;
+    }
+
+    saveBenchmarkResults(suite, "benchmark_components.csv");
+    freeBenchmarkSuite(suite);
+    free(edges);
+}
+
+// BFS con cola (bfsCSR) contra el BFS por niveles que alterna top-down y
+// bottom-up, reutilizando el mismo workspace en todas las corridas
+void benchmarkParallelBFS() {
+    printf("🏁 BFS DIRECTION-OPTIMIZING\n");
+    printf("==========================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int n = 2000000;
+    int maxThreads = resolveThreadCount(0);
+    int sources = 3;
+    CSRGraph* csr = generateSparseCSR(n, 16, 1);
+    int m = csr->numEdges / 2;
+
+    int* distances = (int*)malloc(n * sizeof(int));
+    int** reference = (int**)malloc(sources * sizeof(int*));
+
+    double startTime = getCurrentTime();
+    for (int src = 0; src < sources; src++) {
+        SearchResult* result = bfsCSR(csr, src);
+        reference[src] = result->distances;
+        result->distances = NULL;
+        freeSearchResult(result);
+    }
+    double queueTime = (getCurrentTime() - startTime) / 1000.0 / sources;
+    addBenchmarkResult(suite, "BFS-Cola", queueTime, n, m, true);
+
+    printf("Núcleos disponibles: %d\n", maxThreads);
+    printf("Grafo: %d vértices, %d aristas\n", n, m);
+    printf("%-8s %-12s %-10s %-10s\n", "Hilos", "Tiempo(ms)", "Speedup", "Idéntico");
+    printf("%-8s %-12.3f %-10s %-10s\n", "cola", queueTime, "1.00", "-");
+
+    for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        BFSWorkspace* workspace = createBFSWorkspace(n, threads);
+        bool identical = true;
+
+        startTime = getCurrentTime();
+        for (int src = 0; src < sources; src++) {
+            bfsDirectionOptimizing(csr, src, -1, workspace, distances, NULL);
+            identical = identical && memcmp(distances, reference[src], n * sizeof(int)) == 0;
+        }
+        double elapsed = (getCurrentTime() - startTime) / 1000.0 / sources;
+
+        char name[50];
+        snprintf(name, sizeof(name), "BFS-DirOpt-%dT", threads);
+        addBenchmarkResult(suite, name, elapsed, n, m, identical);
+        printf("%-8d %-12.3f %-10.2f %-10s\n", threads, elapsed, queueTime / elapsed,
+               identical ? "✅" : "❌");
+        destroyBFSWorkspace(workspace);
+
+        if (threads == maxThreads) break;
+    }
+
+    printf("(tiempos en ms por origen)\n");
+    saveBenchmarkResults(suite, "benchmark_bfs.csv");
+    freeBenchmarkSuite(suite);
+    for (int src = 0; src < sources; src++) {
+        free(reference[src]);
+    }
+    free(reference);
+    free(distances);
+    destroyCSRGraph(csr);
+}
+
+// Grafo dinámico: vértices que crecen de a uno y arcos agregados,
+// consultados y borrados al azar (tiempo por operación en ns)
+void benchmarkDynamicGraph() {
+    printf("🏁 GRAFO DINÁMICO\n");
+    printf("================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    int n = 1000000;
+    int m = 4000000;
+
+    int* src = (int*)malloc(m * sizeof(int));
+    int* dest = (int*)malloc(m * sizeof(int));
+    seedBenchmarkGenerators();
+    for (int i = 0; i < m; i++) {
+        src[i] = rand() % n;
+        dest[i] = rand() % n;
+    }
+
+    double startTime = getCurrentTime();
+    Graph* graph = crearGraph(0, true);
+    for (int v = 0; v < n; v++) {
+        addVertex(graph, v);
+    }
+    for (int i = 0; i < m; i++) {
+        addEdgeList(graph, src[i], dest[i], 1 + i % 100);
+    }
+    double addTime = (getCurrentTime() - startTime) / 1000.0;
+    int arcs = graph->numArcs;
+    addBenchmarkResult(suite, "Grafo-Agregar", addTime, n, arcs, true);
+
+    startTime = getCurrentTime();
+    int found = 0;
+    for (int i = 0; i < m; i++) {
+        found += hasEdge(graph, src[i], dest[(i + 1) % m]);
+        found += hasEdge(graph, src[i], dest[i]);
+    }
+    double queryTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Grafo-hasEdge", queryTime, n, arcs, found >= arcs);
+
+    startTime = getCurrentTime();
+    CSRGraph* csr = csrFromGraph(graph);
+    double csrTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Grafo-aCSR", csrTime, n, arcs, csr && csr->numEdges == arcs);
+
+    startTime = getCurrentTime();
+    int removed = 0;
+    for (int i = 0; i < m; i += 2) {
+        removed += removeArc(graph, src[i], dest[i]);
+    }
+    double removeTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Grafo-Borrar", removeTime, n, arcs, graph->numArcs == arcs - removed);
+
+    printf("Grafo: %d vértices, %d arcos\n", n, arcs);
+    printf("%-14s %-12s %-10s\n", "Operación", "Tiempo(ms)", "ns/op");
+    printf("%-14s %-12.3f %-10.1f\n", "agregar", addTime, addTime * 1e6 / m);
+    printf("%-14s %-12.3f %-10.1f\n", "hasEdge", queryTime, queryTime * 1e6 / (2.0 * m));
+    printf("%-14s %-12.3f %-10.1f\n", "a CSR", csrTime, csrTime * 1e6 / arcs);
+    printf("%-14s %-12.3f %-10.1f\n", "borrar", removeTime, removeTime * 1e6 / (m / 2));
+
+    saveBenchmarkResults(suite, "benchmark_dynamic_graph.csv");
+    freeBenchmarkSuite(suite);
+    destroyCSRGraph(csr);
+    destruirGraph(graph);
+    free(src);
+    free(dest);
+}
+
+// Lista de aristas al azar en el formato de loadEdgeList ("V E" y E líneas)
+static bool writeRandomEdgeList(const char* filename, int n, int m) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        printf("❌ Error: No se puede crear el archivo %s\n", filename);
+        return false;
+    }
+    seedBenchmarkGenerators();
+    fprintf(file, "%d %d\n", n, m);
+    for (int i = 0; i < m; i++) {
+        fprintf(file, "%d %d %d\n", rand() % n, rand() % n, 1 + rand() % 100);
+    }
+    fclose(file);
+    return true;
+}
+
+// Carga de una lista de aristas en texto (por bloques) contra abrir el mismo
+// grafo en formato binario con mmap; el recorrido de targets después de
+// abrirlo cuenta el costo real de traer las páginas
+void benchmarkBinaryGraph() {
+    printf("🏁 GRAFO BINARIO CON MMAP\n");
+    printf("========================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    const char* textFile = "benchmark_graph.txt";
+    const char* binaryFile = "benchmark_graph.bin";
+    int n = 1000000;
+    int m = 4000000;
+
+    if (!writeRandomEdgeList(textFile, n, m)) {
+        freeBenchmarkSuite(suite);
+        return;
+    }
+
+    double startTime = getCurrentTime();
+    CSRGraph* parsed = loadEdgeListCSR(textFile);
+    double textTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Texto-bloques", textTime, n, m, parsed != NULL);
+
+    startTime = getCurrentTime();
+    bool converted = convertTextGraphToBinary(textFile, binaryFile);
+    double convertTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Conversion", convertTime, n, m, converted);
+
+    startTime = getCurrentTime();
+    MappedGraph* mapped = openMappedGraph(binaryFile);
+    double openTime = (getCurrentTime() - startTime) / 1000.0;
+
+    long long checksum = 0;
+    if (mapped) {
+        for (int e = 0; e < mapped->graph.numEdges; e++) {
+            checksum += mapped->graph.targets[e];
+        }
+    }
+    double mappedTime = (getCurrentTime() - startTime) / 1000.0;
+
+    long long expected = 0;
+    for (int e = 0; parsed && e < parsed->numEdges; e++) {
+        expected += parsed->targets[e];
+    }
+    bool identical = mapped && parsed && mapped->graph.numEdges == parsed->numEdges &&
+                     memcmp(mapped->graph.offsets, parsed->offsets, (n + 1) * sizeof(int)) == 0 &&
+                     checksum == expected;
+    addBenchmarkResult(suite, "Binario-mmap", mappedTime, n, m, identical);
+
+    printf("Grafo: %d vértices, %d aristas\n", n, m);
+    printf("%-22s %-12s %-10s\n", "Carga", "Tiempo(ms)", "Speedup");
+    printf("%-22s %-12.3f %-10s\n", "texto (por bloques)", textTime, "1.00");
+    printf("%-22s %-12.3f %-10s\n", "convertir (una vez)", convertTime, "-");
+    printf("%-22s %-12.3f %-10.2f\n", "mmap (solo abrir)", openTime, textTime / openTime);
+    printf("%-22s %-12.3f %-10.2f %s\n", "mmap + recorrido", mappedTime, textTime / mappedTime,
+           identical ? "✅" : "❌");
+
+    saveBenchmarkResults(suite, "benchmark_binary_graph.csv");
+    freeBenchmarkSuite(suite);
+    closeMappedGraph(mapped);
+    destroyCSRGraph(parsed);
+    remove(textFile);
+    remove(binaryFile);
+}
+
+// Carga anterior: fscanf a un arreglo de Edge y después csrFromEdges
+static CSRGraph* loadEdgeListFscanf(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return NULL;
+
+    int numVertices, numEdges;
+    if (fscanf(file, "%d %d", &numVertices, &numEdges) != 2) {
+        fclose(file);
+        return NULL;
+    }
+
+    Edge* edges = (Edge*)malloc((numEdges > 0 ? numEdges : 1) * sizeof(Edge));
+    int read = 0;
+    while (read < numEdges &&
+           fscanf(file, "%d %d %d", &edges[read].src, &edges[read].dest, &edges[read].weight) == 3) {
+        read++;
+    }
+    fclose(file);
+
+    CSRGraph* csr = csrFromEdges(numVertices, edges, read, true);
+    free(edges);
+    return csr;
+}
+
+// Lista de aristas con fscanf contra la carga por bloques en dos pasadas
+void benchmarkStreamingLoader() {
+    printf("🏁 CARGA DE LISTAS DE ARISTAS POR BLOQUES\n");
+    printf("========================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    const char* textFile = "benchmark_edges.txt";
+    int n = 1000000;
+    int m = 8000000;
+
+    if (!writeRandomEdgeList(textFile, n, m)) {
+        freeBenchmarkSuite(suite);
+        return;
+    }
+    FILE* file = fopen(textFile, "rb");
+    fseek(file, 0, SEEK_END);
+    double megabytes = ftell(file) / (1024.0 * 1024.0);
+    fclose(file);
+
+    double startTime = getCurrentTime();
+    CSRGraph* reference = loadEdgeListFscanf(textFile);
+    double fscanfTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Aristas-fscanf", fscanfTime, n, m, reference != NULL);
+    if (reference) csrSortNeighbors(reference, 0, n);
+
+    startTime = getCurrentTime();
+    CSRGraph* streamed = loadEdgeListCSR(textFile);
+    double streamTime = (getCurrentTime() - startTime) / 1000.0;
+    bool identical = reference && streamed && streamed->numEdges == reference->numEdges &&
+                     memcmp(streamed->offsets, reference->offsets, (n + 1) * sizeof(int)) == 0 &&
+                     memcmp(streamed->targets, reference->targets, m * sizeof(int)) == 0 &&
+                     memcmp(streamed->weights, reference->weights, m * sizeof(int)) == 0;
+    addBenchmarkResult(suite, "Aristas-bloques", streamTime, n, m, identical);
+
+    // Memoria máxima reservada por cada carga, sin contar el CSR en sí
+    double edgeArrayMB = (double)m * sizeof(Edge) / (1024.0 * 1024.0);
+    double cursorMB = (double)(n + 1) * sizeof(int) / (1024.0 * 1024.0);
+
+    printf("Archivo: %.1f MB, %d vértices, %d aristas\n", megabytes, n, m);
+    printf("%-12s %-12s %-10s %-10s %-14s\n", "Carga", "Tiempo(ms)", "MB/s", "Speedup", "Extra(MB)");
+    printf("%-12s %-12.3f %-10.1f %-10s %-14.1f\n", "fscanf", fscanfTime,
+           megabytes / (fscanfTime / 1000.0), "1.00", edgeArrayMB + cursorMB);
+    printf("%-12s %-12.3f %-10.1f %-10.2f %-14.1f %s\n", "bloques", streamTime,
+           megabytes / (streamTime / 1000.0), fscanfTime / streamTime, cursorMB,
+           identical ? "✅" : "❌");
+
+    saveBenchmarkResults(suite, "benchmark_edge_loader.csv");
+    freeBenchmarkSuite(suite);
+    destroyCSRGraph(reference);
+    destroyCSRGraph(streamed);
+    remove(textFile);
+}
+
+static bool sameCSR(const CSRGraph* a, const CSRGraph* b) {
+    return a && b && a->numVertices == b->numVertices && a->numEdges == b->numEdges &&
+           memcmp(a->offsets, b->offsets, (a->numVertices + 1) * sizeof(int)) == 0 &&
+           memcmp(a->targets, b->targets, a->numEdges * sizeof(int)) == 0 &&
+           memcmp(a->weights, b->weights, a->numEdges * sizeof(int)) == 0;
+}
+
+// Carga secuencial contra la carga por rangos de bytes en 1, 2, 4, ... hilos,
+// para una lista de aristas y para una matriz de adyacencia
+void benchmarkParallelIngestion() {
+    printf("🏁 CARGA DE TEXTO EN PARALELO\n");
+    printf("============================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    const char* edgeFile = "benchmark_ingest_edges.txt";
+    const char* matrixFile = "benchmark_ingest_matrix.txt";
+    int n = 1000000;
+    int m = 8000000;
+    int matrixSize = 3000;
+    int maxThreads = resolveThreadCount(0);
+
+    if (!writeRandomEdgeList(edgeFile, n, m)) {
+        freeBenchmarkSuite(suite);
+        return;
+    }
+    int** matrix = generateRandomGraph(matrixSize, 0.05, 100);
+    saveAdjacencyMatrix(matrixFile, matrix, matrixSize);
+    CSRGraph* matrixReference = csrFromMatrix(matrix, matrixSize, true);
+    for (int i = 0; i < matrixSize; i++) {
+        free(matrix[i]);
+    }
+    free(matrix);
+
+    // Referencia: carga por bloques de un hilo (también en orden canónico)
+    double startTime = getCurrentTime();
+    CSRGraph* edgeReference = loadEdgeListCSR(edgeFile);
+    double sequentialTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Aristas-Secuencial", sequentialTime, n, m, edgeReference != NULL);
+
+    printf("Núcleos disponibles: %d\n", maxThreads);
+    printf("Lista de aristas: %d vértices, %d aristas\n", n, m);
+    printf("%-8s %-12s %-10s %-10s\n", "Hilos", "Tiempo(ms)", "Speedup", "Idéntico");
+    printf("%-8s %-12.3f %-10s %-10s\n", "sec", sequentialTime, "1.00", "-");
+
+    for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        startTime = getCurrentTime();
+        CSRGraph* loaded = loadEdgeListCSRParallel(edgeFile, threads);
+        double elapsed = (getCurrentTime() - startTime) / 1000.0;
+        bool identical = sameCSR(loaded, edgeReference);
+
+        char name[50];
+        snprintf(name, sizeof(name), "Aristas-%dT", threads);
+        addBenchmarkResult(suite, name, elapsed, n, m, identical);
+        printf("%-8d %-12.3f %-10.2f %-10s\n", threads, elapsed, sequentialTime / elapsed,
+               identical ? "✅" : "❌");
+        destroyCSRGraph(loaded);
+
+        if (threads == maxThreads) break;
+    }
+
+    // La matriz secuencial es la carga densa con fscanf de loadAdjacencyMatrix
+    int** dense = NULL;
+    int denseSize = 0;
+    startTime = getCurrentTime();
+    bool denseLoaded = loadAdjacencyMatrix(matrixFile, &dense, &denseSize);
+    sequentialTime = (getCurrentTime() - startTime) / 1000.0;
+    addBenchmarkResult(suite, "Matriz-fscanf", sequentialTime, matrixSize, matrixReference->numEdges, denseLoaded);
+    for (int i = 0; dense && i < denseSize; i++) {
+        free(dense[i]);
+    }
+    free(dense);
+
+    printf("Matriz: %d x %d, %d arcos\n", matrixSize, matrixSize, matrixReference->numEdges);
+    printf("%-8s %-12s %-10s %-10s\n", "Hilos", "Tiempo(ms)", "Speedup", "Idéntico");
+    printf("%-8s %-12.3f %-10s %-10s\n", "fscanf", sequentialTime, "1.00", "-");
+
+    for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+        startTime = getCurrentTime();
+        CSRGraph* loaded = loadAdjacencyMatrixCSRParallel(matrixFile, threads);
+        double elapsed = (getCurrentTime() - startTime) / 1000.0;
+        bool identical = sameCSR(loaded, matrixReference);
+
+        char name[50];
+        snprintf(name, sizeof(name), "Matriz-%dT", threads);
+        addBenchmarkResult(suite, name, elapsed, matrixSize, matrixReference->numEdges, identical);
+        printf("%-8d %-12.3f %-10.2f %-10s\n", threads, elapsed, sequentialTime / elapsed,
+               identical ? "✅" : "❌");
+        destroyCSRGraph(loaded);
+
+        if (threads == maxThreads) break;
+    }
+
+    saveBenchmarkResults(suite, "benchmark_ingestion.csv");
+    freeBenchmarkSuite(suite);
+    destroyCSRGraph(edgeReference);
+    destroyCSRGraph(matrixReference);
+    remove(edgeFile);
+    remove(matrixFile);
+}
+
+// Generadores CSR de graph_generators.c con ~10M aristas; el geométrico
+// solo se usa por su grafo
+static CSRGraph* runScalableGenerator(int kind, uint64_t seed, int threads) {
+    switch (kind) {
+        case 0: return generateRMATGraph(20, 10, 0.57, 0.19, 0.19, 100, false, seed, threads);
+        case 1: return generateBarabasiAlbertGraph(2500000, 4, 100, seed, threads);
+        case 2: return generateGridNetwork(2236, 2236, 100, seed, threads);
+        default: {
+            GeometricGraph* geometric = generateGeometricGraph(2500000, 8.0, -34.6, -58.4, 50.0, seed, threads);
+            if (!geometric) return NULL;
+            CSRGraph* csr = geometric->graph;
+            geometric->graph = NULL;
+            destroyGeometricGraph(geometric);
+            return csr;
+        }
+    }
+}
+
+// Tiempo de cada generador escalable en 1, 2, 4, ... hilos. Con la misma
+// semilla el grafo tiene que salir idéntico con cualquier cantidad de hilos
+void benchmarkGraphGenerators() {
+    printf("🏁 GENERADORES DE GRAFOS ESCALABLES\n");
+    printf("===================================\n");
+
+    BenchmarkSuite* suite = createBenchmarkSuite();
+    const char* names[] = {"R-MAT", "Barabasi-Albert", "Grilla", "Geometrico"};
+    const uint64_t seed = 42;
+    int maxThreads = resolveThreadCount(0);
+
+    printf("Núcleos disponibles: %d\n", maxThreads);
+    printf("%-18s %-8s %-10s %-10s %-12s %-10s %-10s\n",
+           "Generador", "Hilos", "Vértices", "Arcos", "Tiempo(ms)", "M arcos/s", "Idéntico");
+
+    for (int kind = 0; kind < 4; kind++) {
+        CSRGraph* reference = NULL;
+
+        for (int threads = 1; ; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+            double startTime = getCurrentTime();
+            CSRGraph* csr = runScalableGenerator(kind, seed, threads);
+            double elapsed = (getCurrentTime() - startTime) / 1000.0;
+            if (!csr) break;
+
+            bool identical = reference ? sameCSR(csr, reference) : true;
+            char name[50];
+            snprintf(name, sizeof(name), "%s-%dT", names[kind], threads);
+            addBenchmarkResult(suite, name, elapsed, csr->numVertices, csr->numEdges, identical);
+            printf("%-18s %-8d %-10d %-10d %-12.1f %-10.1f %-10s\n", names[kind], threads,
+                   csr->numVertices, csr->numEdges, elapsed, csr->numEdges / (elapsed * 1000.0),
+                   identical ? "✅" : "❌");
+
+            if (reference) {
+                destroyCSRGraph(csr);
+            } else {
+                reference = csr;
+            }
+            if (threads == maxThreads) break;
+        }
+
+        destroyCSRGraph(reference);
+    }
+
+    saveBenchmarkResults(suite, "benchmark_generators.csv");
+    freeBenchmarkSuite(suite);
+}
+
+// ===============================
+// SUITE CON REPETICIONES Y COMPARACIÓN
+// ===============================
+
+static bool harnessDijkstra(void* context, int* settledVertices) {
+    const CSRGraph* csr = (const CSRGraph*)context;
+    int* dist = dijkstraAllPathsCSR(csr, 0);
+    bool ok = dist && dist[0] == 0;
+    if (dist) {
+        for (int v = 0; v < csr->numVertices; v++) {
+            if (dist[v] != INF) (*settledVertices)++;
+        }
+    }
+    free(dist);
+    return ok;
+}
+
+// La variante con cola no informa cuántos vértices fijó
+static bool harnessBellmanFord(void* context, int* settledVertices) {
+    (void)settledVertices;
+    const CSRGraph* csr = (const CSRGraph*)context;
+    PathResult* result = bellmanFordQueueCSR(csr, 0, csr->numVertices - 1);
+    bool ok = result != NULL;
+    if (result) freePathResult(result);
+    return ok;
+}
+
+static bool harnessKruskal(void* context, int* settledVertices) {
+    (void)settledVertices;
+    const CSRGraph* csr = (const CSRGraph*)context;
+    MST* mst = kruskalMSTCSR(csr);
+    bool ok = mst && mst->edgeCount < csr->numVertices;
+    if (mst) freeMST(mst);
+    return ok;
+}
+
+static bool harnessBFS(void* context, int* settledVertices) {
+    const CSRGraph* csr = (const CSRGraph*)context;
+    SearchResult* result = bfsCSR(csr, 0);
+    bool ok = result && result->visitCount >= 1;
+    if (result) *settledVertices = result->visitCount;
+    if (result) freeSearchResult(result);
+    return ok;
+}
+
+// Generadores CSR con semilla de graph_generators.c: el mismo grafo en
+// cada corrida y con cualquier cantidad de hilos. numVertices se redondea
+// a la potencia de dos (R-MAT) o al cuadrado (grilla) más cercano por abajo
+static CSRGraph* runHarnessGenerator(int kind, int numVertices, uint64_t seed, int threads) {
+    int scale = 0;
+    while ((2 << scale) <= numVertices) scale++;
+    int side = (int)sqrt((double)numVertices);
+
+    switch (kind) {
+        case 0: return generateRMATGraph(scale, 4, 0.25, 0.25, 0.25, 100, false, seed, threads);
+        case 1: return generateRMATGraph(scale, 4, 0.57, 0.19, 0.19, 100, false, seed, threads);
+        case 2: return generateBarabasiAlbertGraph(numVertices, 4, 100, seed, threads);
+        default: return generateGridNetwork(side, side, 100, seed, threads);
+    }
+}
+
+// Corre cada algoritmo CSR sobre los cuatro generadores con calentamiento y
+// repeticiones, guarda benchmark_harness.csv / .json y, si se pasa una base
+// (un benchmark_harness.csv anterior), marca los casos más lentos que el
+// umbral. Con config.collectCounters agrega IPC y misses por vértice
+// fijado. Devuelve la cantidad de regresiones (0 sin base, -1 si falla)
+int runHarnessBenchmarks(BenchmarkConfig config, const char* baselineFile) {
+    printf("🏁 BENCHMARKS CON REPETICIONES\n");
+    printf("==============================\n");
+
+    BenchmarkHarness* harness = createBenchmarkHarness(config);
+    if (!harness) return -1;
+
+    const char* generators[] = {"Uniforme", "R-MAT", "Barabasi", "Grilla"};
+    const int numGenerators = 4;
+    const int sizes[] = {4096, 65536};
+    const int numSizes = 2;
+    int threads = resolveThreadCount(0);
+
+    struct {
+        const char* name;
+        BenchmarkCase run;
+    } cases[] = {
+        {"Dijkstra-CSR", harnessDijkstra},
+        {"BellmanFord-Cola", harnessBellmanFord},
+        {"Kruskal-CSR", harnessKruskal},
+        {"BFS-CSR", harnessBFS},
+    };
+    const int numCases = sizeof(cases) / sizeof(cases[0]);
+
+    for (int s = 0; s < numSizes; s++) {
+        for (int g = 0; g < numGenerators; g++) {
+            CSRGraph* csr = runHarnessGenerator(g, sizes[s], config.seed, threads);
+            if (!csr) continue;
+            int n = csr->numVertices;
+
+            printf("📈 %s con %d vértices (%d arcos)...\n", generators[g], n, csr->numEdges);
+            for (int c = 0; c < numCases; c++) {
+                runBenchmarkCase(harness, cases[c].name, generators[g], n, csr->numEdges / 2, cases[c].run, csr);
+            }
+
+            destroyCSRGraph(csr);
+        }
+    }
+
+    printBenchmarkStats(harness);
+
+    // Comparar antes de guardar: la base puede ser el mismo benchmark_harness.csv
+    int regressions = 0;
+    if (baselineFile) {
+        regressions = compareWithBaseline(harness, baselineFile);
+    }
+
+    saveBenchmarkStatsCSV(harness, "benchmark_harness.csv");
+    saveBenchmarkStatsJSON(harness, "benchmark_harness.json");
+
+    destroyBenchmarkHarness(harness);
+    return regressions;
+}
+
 // Función de prueba
 void testBenchmarks() {
     printf("⏱️  PRUEBA DE BENCHMARKS\n");
@@ -0,0 +1,333 @@
+//
+// Created by administrador on 6/28/25.
+//
+
+#include "binary_graph.h"
+#include "file_io.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ===============================
+// ESCRITURA
+// ===============================
+
+static uint64_t alignUp(uint64_t pos) {
+    return (pos + BINARY_GRAPH_ALIGN - 1) / BINARY_GRAPH_ALIGN * BINARY_GRAPH_ALIGN;
+}
+
+// Rellenar con ceros hasta la posición de la próxima sección
+static bool writePadding(FILE* file, uint64_t written, uint64_t target) {
+    static const char zeros[BINARY_GRAPH_ALIGN] = {0};
+    return fwrite(zeros, 1, target - written, file) == target - written;
+}
+
+bool saveBinaryGraph(const char* filename, const CSRGraph* graph, char** vertexNames) {
+    if (!filename || !graph) return false;
+
+    int n = graph->numVertices;
+    int m = graph->numEdges;
+
+    BinaryGraphHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic));
+    header.version = BINARY_GRAPH_VERSION;
+    header.endianMark = BINARY_GRAPH_ENDIAN;
+    header.flags = (graph->isDirected ? BINARY_GRAPH_FLAG_DIRECTED : 0) |
+                   (vertexNames ? BINARY_GRAPH_FLAG_NAMES : 0);
+    header.numVertices = n;
+    header.numEdges = m;
+
+    // Posiciones de los nombres dentro del blob
+    int64_t* nameOffsets = NULL;
+    if (vertexNames) {
+        nameOffsets = (int64_t*)malloc((n + 1) * sizeof(int64_t));
+        if (!nameOffsets) return false;
+
+        nameOffsets[0] = 0;
+        for (int i = 0; i < n; i++) {
+            const char* name = vertexNames[i] ? vertexNames[i] : "";
+            nameOffsets[i + 1] = nameOffsets[i] + (int64_t)strlen(name) + 1;
+        }
+        header.namesSize = (uint64_t)nameOffsets[n];
+    }
+
+    header.offsetsPos = alignUp(sizeof(BinaryGraphHeader));
+    header.targetsPos = alignUp(header.offsetsPos + (uint64_t)(n + 1) * sizeof(int));
+    header.weightsPos = alignUp(header.targetsPos + (uint64_t)m * sizeof(int));
+    uint64_t end = header.weightsPos + (uint64_t)m * sizeof(int);
+    if (vertexNames) {
+        header.nameOffsetsPos = alignUp(end);
+        header.namesPos = alignUp(header.nameOffsetsPos + (uint64_t)(n + 1) * sizeof(int64_t));
+        end = header.namesPos + header.namesSize;
+    }
+    header.fileSize = end;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("❌ Error: No se puede crear el archivo %s\n", filename);
+        free(nameOffsets);
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              writePadding(file, sizeof(header), header.offsetsPos) &&
+              fwrite(graph->offsets, sizeof(int), n + 1, file) == (size_t)(n + 1) &&
+              writePadding(file, header.offsetsPos + (uint64_t)(n + 1) * sizeof(int), header.targetsPos) &&
+              fwrite(graph->targets, sizeof(int), m, file) == (size_t)m &&
+              writePadding(file, header.targetsPos + (uint64_t)m * sizeof(int), header.weightsPos) &&
+              fwrite(graph->weights, sizeof(int), m, file) == (size_t)m;
+
+    if (ok && vertexNames) {
+        ok = writePadding(file, header.weightsPos + (uint64_t)m * sizeof(int), header.nameOffsetsPos) &&
+             fwrite(nameOffsets, sizeof(int64_t), n + 1, file) == (size_t)(n + 1) &&
+             writePadding(file, header.nameOffsetsPos + (uint64_t)(n + 1) * sizeof(int64_t), header.namesPos);
+
+        for (int i = 0; ok && i < n; i++) {
+            const char* name = vertexNames[i] ? vertexNames[i] : "";
+            size_t length = strlen(name) + 1;
+            ok = fwrite(name, 1, length, file) == length;
+        }
+    }
+
+    if (fclose(file) != 0) ok = false;
+    free(nameOffsets);
+
+    if (!ok) printf("❌ Error: Escritura incompleta de %s\n", filename);
+    return ok;
+}
+
+// ===============================
+// APERTURA CON MMAP
+// ===============================
+
+// La sección [pos, pos + bytes) cae dentro del archivo y respeta la alineación
+static bool sectionFits(uint64_t pos, uint64_t bytes, uint64_t fileSize, uint64_t alignment) {
+    return pos % alignment == 0 && pos <= fileSize && bytes <= fileSize - pos;
+}
+
+static bool validHeader(const BinaryGraphHeader* header, uint64_t fileSize) {
+    if (memcmp(header->magic, BINARY_GRAPH_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != BINARY_GRAPH_VERSION ||
+        header->endianMark != BINARY_GRAPH_ENDIAN ||
+        header->numVertices < 0 || header->numEdges < 0 ||
+        header->fileSize != fileSize) {
+        return false;
+    }
+
+    uint64_t n = (uint64_t)header->numVertices;
+    uint64_t m = (uint64_t)header->numEdges;
+    if (!sectionFits(header->offsetsPos, (n + 1) * sizeof(int), fileSize, sizeof(int)) ||
+        !sectionFits(header->targetsPos, m * sizeof(int), fileSize, sizeof(int)) ||
+        !sectionFits(header->weightsPos, m * sizeof(int), fileSize, sizeof(int))) {
+        return false;
+    }
+
+    if (header->flags & BINARY_GRAPH_FLAG_NAMES) {
+        return sectionFits(header->nameOffsetsPos, (n + 1) * sizeof(int64_t), fileSize, sizeof(int64_t)) &&
+               sectionFits(header->namesPos, header->namesSize, fileSize, 1);
+    }
+    return true;
+}
+
+MappedGraph* openMappedGraph(const char* filename) {
+    if (!filename) return NULL;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("❌ Error: No se puede abrir el archivo %s\n", filename);
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (uint64_t)info.st_size < sizeof(BinaryGraphHeader)) {
+        printf("❌ Error: %s no es un grafo binario válido\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    // Privado y con escritura: copy-on-write, el archivo nunca cambia
+    size_t size = (size_t)info.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        printf("❌ Error: No se pudo mapear %s\n", filename);
+        return NULL;
+    }
+
+    const BinaryGraphHeader* header = (const BinaryGraphHeader*)mapping;
+    char* base = (char*)mapping;
+    int n = validHeader(header, size) ? header->numVertices : -1;
+    int* offsets = n >= 0 ? (int*)(base + header->offsetsPos) : NULL;
+
+    // Con offsets no decreciente de 0 a numEdges ningún recorrido sale de
+    // targets; los destinos no se revisan para no leer todo el archivo
+    bool ok = offsets && offsets[0] == 0 && offsets[n] == header->numEdges;
+    for (int i = 0; ok && i < n; i++) {
+        ok = offsets[i] <= offsets[i + 1];
+    }
+    if (ok && (header->flags & BINARY_GRAPH_FLAG_NAMES)) {
+        const int64_t* nameOffsets = (const int64_t*)(base + header->nameOffsetsPos);
+        ok = nameOffsets[0] == 0 && (uint64_t)nameOffsets[n] == header->namesSize &&
+             (header->namesSize == 0 || base[header->namesPos + header->namesSize - 1] == '\0');
+        for (int i = 0; ok && i < n; i++) {
+            ok = nameOffsets[i] <= nameOffsets[i + 1];
+        }
+    }
+
+    MappedGraph* mapped = ok ? (MappedGraph*)malloc(sizeof(MappedGraph)) : NULL;
+    if (!mapped) {
+        if (!ok) printf("❌ Error: %s no es un grafo binario válido\n", filename);
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    mapped->graph.numVertices = n;
+    mapped->graph.numEdges = header->numEdges;
+    mapped->graph.isDirected = (header->flags & BINARY_GRAPH_FLAG_DIRECTED) != 0;
+    mapped->graph.offsets = offsets;
+    mapped->graph.targets = (int*)(base + header->targetsPos);
+    mapped->graph.weights = (int*)(base + header->weightsPos);
+    mapped->nameOffsets = NULL;
+    mapped->names = NULL;
+    if (header->flags & BINARY_GRAPH_FLAG_NAMES) {
+        mapped->nameOffsets = (const int64_t*)(base + header->nameOffsetsPos);
+        mapped->names = base + header->namesPos;
+    }
+    mapped->mapping = mapping;
+    mapped->mappingSize = size;
+
+    return mapped;
+}
+
+void closeMappedGraph(MappedGraph* mapped) {
+    if (!mapped) return;
+
+    munmap(mapped->mapping, mapped->mappingSize);
+    free(mapped);
+}
+
+const char* mappedGraphVertexName(const MappedGraph* mapped, int vertex) {
+    if (!mapped || !mapped->names || vertex < 0 || vertex >= mapped->graph.numVertices) {
+        return NULL;
+    }
+    return mapped->names + mapped->nameOffsets[vertex];
+}
+
+// ===============================
+// CONVERSIÓN DESDE TEXTO
+// ===============================
+
+// Leer una matriz n x n fila por fila y quedarse solo con los pesos no nulos
+static CSRGraph* readMatrixRows(FILE* file, int numVertices, bool isDirected) {
+    CSRGraph* csr = createCSRGraph(numVertices, 0, isDirected);
+    if (!csr) return NULL;
+
+    int capacity = 1;
+    int pos = 0;
+    for (int i = 0; i < numVertices; i++) {
+        csr->offsets[i] = pos;
+        for (int j = 0; j < numVertices; j++) {
+            int weight;
+            if (fscanf(file, "%d", &weight) != 1) {
+                destroyCSRGraph(csr);
+                return NULL;
+            }
+            if (weight == 0) continue;
+
+            if (pos == capacity) {
+                capacity *= 2;
+                int* targets = (int*)realloc(csr->targets, capacity * sizeof(int));
+                if (targets) csr->targets = targets;
+                int* weights = (int*)realloc(csr->weights, capacity * sizeof(int));
+                if (weights) csr->weights = weights;
+                if (!targets || !weights) {
+                    destroyCSRGraph(csr);
+                    return NULL;
+                }
+            }
+            csr->targets[pos] = j;
+            csr->weights[pos] = weight;
+            pos++;
+        }
+    }
+    csr->offsets[numVertices] = pos;
+    csr->numEdges = pos;
+    return csr;
+}
+
+// Formato con cabecera de saveGraphToFile: VERTICES, DIRECTED, NAMES y MATRIX
+static CSRGraph* readHeaderFormat(FILE* file, const char* firstLine, char*** vertexNames, int* numNames) {
+    int numVertices;
+    if (sscanf(firstLine, "VERTICES: %d", &numVertices) != 1 || numVertices < 0) return NULL;
+
+    bool isDirected = false;
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        char value[16];
+        if (sscanf(line, "DIRECTED: %15s", value) == 1) {
+            isDirected = strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
+        } else if (strncmp(line, "NAMES:", 6) == 0 && !*vertexNames) {
+            *vertexNames = (char**)calloc(numVertices > 0 ? numVertices : 1, sizeof(char*));
+            *numNames = numVertices;
+            char* token = strtok(line + 6, " \t\r\n");
+            for (int i = 0; i < numVertices && token; i++) {
+                (*vertexNames)[i] = strdup(token);
+                token = strtok(NULL, " \t\r\n");
+            }
+        } else if (strncmp(line, "MATRIX:", 7) == 0) {
+            break;
+        }
+    }
+
+    return readMatrixRows(file, numVertices, isDirected);
+}
+
+bool convertTextGraphToBinary(const char* textFilename, const char* binaryFilename) {
+    if (!textFilename || !binaryFilename) return false;
+
+    FILE* file = fopen(textFilename, "r");
+    if (!file) {
+        printf("❌ Error: No se puede abrir el archivo %s\n", textFilename);
+        return false;
+    }
+
+    char line[1024];
+    char** vertexNames = NULL;
+    int numNames = 0;
+    CSRGraph* csr = NULL;
+
+    // Detectar formato basado en primera línea
+    if (fgets(line, sizeof(line), file)) {
+        int first, second;
+        int numbers = sscanf(line, "%d %d", &first, &second);
+
+        if (strstr(line, "VERTICES")) {
+            csr = readHeaderFormat(file, line, &vertexNames, &numNames);
+        } else if (numbers == 2) {
+            // Lista de aristas: la carga por bloques de file_io.c (dirigida)
+            csr = loadEdgeListCSR(textFilename);
+        } else if (numbers == 1 && first >= 0) {
+            // Matriz simple: se conserva cada celda como arco
+            csr = readMatrixRows(file, first, true);
+        }
+    }
+    fclose(file);
+
+    bool ok = csr && saveBinaryGraph(binaryFilename, csr, vertexNames);
+    if (!csr) {
+        printf("❌ Error: Formato no reconocido o incompleto en %s\n", textFilename);
+    } else if (ok) {
+        printf("✅ Grafo convertido: %s -> %s (%d vértices, %d arcos)\n",
+               textFilename, binaryFilename, csr->numVertices, csr->numEdges);
+    }
+
+    for (int i = 0; i < numNames; i++) {
+        free(vertexNames[i]);
+    }
+    free(vertexNames);
+    destroyCSRGraph(csr);
+    return ok;
+}
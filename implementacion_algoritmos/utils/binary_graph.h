@@ -0,0 +1,70 @@
+//
+// Created by administrador on 6/28/25.
+//
+
+#ifndef BINARY_GRAPH_H
+#define BINARY_GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../graph/csr_graph.h"
+
+#define BINARY_GRAPH_MAGIC "GRAFOCSR"
+#define BINARY_GRAPH_VERSION 1
+#define BINARY_GRAPH_ENDIAN 0x01020304u   // Se lee distinto en una máquina big-endian
+#define BINARY_GRAPH_ALIGN 64             // Alineación de cada sección dentro del archivo
+
+#define BINARY_GRAPH_FLAG_DIRECTED 0x1
+#define BINARY_GRAPH_FLAG_NAMES    0x2
+
+// Cabecera del archivo binario. Después vienen, cada una alineada a
+// BINARY_GRAPH_ALIGN bytes: offsets (numVertices + 1 int), targets y
+// weights (numEdges int cada una) y, si hay nombres, numVertices + 1
+// posiciones int64 dentro del blob seguidas del blob de cadenas terminadas
+// en '\0'. Todas las posiciones se miden desde el inicio del archivo.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianMark;
+    uint32_t flags;
+    int32_t numVertices;
+    int32_t numEdges;
+    uint32_t reserved;
+    uint64_t offsetsPos;
+    uint64_t targetsPos;
+    uint64_t weightsPos;
+    uint64_t nameOffsetsPos;
+    uint64_t namesPos;
+    uint64_t namesSize;
+    uint64_t fileSize;
+} BinaryGraphHeader;
+
+// Grafo abierto con mmap: graph apunta directo dentro del archivo mapeado,
+// así que los algoritmos CSR lo usan sin copiar ni parsear nada.
+// El mapeo es privado: escribir en los arreglos no modifica el archivo.
+// Se libera con closeMappedGraph, nunca con destroyCSRGraph.
+typedef struct {
+    CSRGraph graph;
+    const int64_t* nameOffsets;   // NULL si el archivo no trae nombres
+    const char* names;
+    void* mapping;
+    size_t mappingSize;
+} MappedGraph;
+
+// Escritura del formato binario (vertexNames puede ser NULL)
+bool saveBinaryGraph(const char* filename, const CSRGraph* graph, char** vertexNames);
+
+// Apertura sin copia y cierre
+MappedGraph* openMappedGraph(const char* filename);
+void closeMappedGraph(MappedGraph* mapped);
+const char* mappedGraphVertexName(const MappedGraph* mapped, int vertex);
+
+// Conversión desde los formatos de texto de file_io.c: con cabecera
+// "VERTICES:", matriz simple ("n" y n x n pesos) o lista de aristas
+// ("V E" y E líneas "src dest peso"). La matriz se lee fila por fila, sin
+// reservar la matriz densa completa.
+bool convertTextGraphToBinary(const char* textFilename, const char* binaryFilename);
+
+#endif //BINARY_GRAPH_H
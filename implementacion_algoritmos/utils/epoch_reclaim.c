@@ -0,0 +1,147 @@
+//
+// Created by administrador on 7/3/25.
+//
+
+#include "epoch_reclaim.h"
+#include <sched.h>
+
+// Lugar preferido del hilo: cada hilo empieza a buscar en uno distinto,
+// así los lectores no compiten por la misma línea de caché
+static _Thread_local int preferredSlot = -1;
+static atomic_int nextPreferredSlot;
+
+EpochDomain* createEpochDomain(void) {
+    EpochDomain* domain = (EpochDomain*)aligned_alloc(EPOCH_SLOT_BYTES,
+        (sizeof(EpochDomain) + EPOCH_SLOT_BYTES - 1) / EPOCH_SLOT_BYTES * EPOCH_SLOT_BYTES);
+    if (!domain) return NULL;
+
+    for (int i = 0; i < EPOCH_MAX_READERS; i++) atomic_init(&domain->slots[i].epoch, 0);
+    atomic_init(&domain->globalEpoch, 1);
+    pthread_mutex_init(&domain->retireLock, NULL);
+    domain->retiredHead = domain->retiredTail = NULL;
+    domain->numRetired = 0;
+    return domain;
+}
+
+void destroyEpochDomain(EpochDomain* domain) {
+    if (!domain) return;
+
+    RetiredObject* node = domain->retiredHead;
+    while (node) {
+        RetiredObject* next = node->next;
+        node->destroy(node->object);
+        free(node);
+        node = next;
+    }
+
+    pthread_mutex_destroy(&domain->retireLock);
+    free(domain);
+}
+
+int epochEnter(EpochDomain* domain) {
+    if (preferredSlot < 0) {
+        preferredSlot = atomic_fetch_add(&nextPreferredSlot, 1) % EPOCH_MAX_READERS;
+    }
+
+    // La época se lee antes de publicarla: si el escritor avanza en el
+    // medio, el lector anuncia una época vieja y solo retrasa la
+    // reclamación, nunca la adelanta
+    while (true) {
+        for (int k = 0; k < EPOCH_MAX_READERS; k++) {
+            int slot = (preferredSlot + k) % EPOCH_MAX_READERS;
+            uint64_t expected = 0;
+            uint64_t epoch = atomic_load(&domain->globalEpoch);
+            if (atomic_compare_exchange_strong(&domain->slots[slot].epoch, &expected, epoch)) {
+                return slot;
+            }
+        }
+        sched_yield();
+    }
+}
+
+void epochExit(EpochDomain* domain, int slot) {
+    atomic_store(&domain->slots[slot].epoch, 0);
+}
+
+RetiredObject* epochReserveRetire(void) {
+    return (RetiredObject*)malloc(sizeof(RetiredObject));
+}
+
+void epochRetireReserved(EpochDomain* domain, RetiredObject* node, void* object, EpochDestructor destroy) {
+    if (!object) {
+        free(node);
+        return;
+    }
+
+    pthread_mutex_lock(&domain->retireLock);
+
+    // Quien fijó una época <= a la de retiro pudo haber visto el objeto;
+    // los que entren después ven la época nueva
+    node->object = object;
+    node->destroy = destroy;
+    node->epoch = atomic_fetch_add(&domain->globalEpoch, 1);
+    node->next = NULL;
+
+    if (domain->retiredTail) domain->retiredTail->next = node;
+    else domain->retiredHead = node;
+    domain->retiredTail = node;
+    domain->numRetired++;
+
+    pthread_mutex_unlock(&domain->retireLock);
+    epochReclaim(domain);
+}
+
+bool epochRetire(EpochDomain* domain, void* object, EpochDestructor destroy) {
+    if (!object) return true;
+
+    RetiredObject* node = epochReserveRetire();
+    if (!node) {
+        printf("❌ Error: Sin memoria para retirar un objeto; queda sin liberar\n");
+        return false;
+    }
+
+    epochRetireReserved(domain, node, object, destroy);
+    return true;
+}
+
+int epochReclaim(EpochDomain* domain) {
+    // Época más vieja que todavía tiene algún lector
+    uint64_t oldest = UINT64_MAX;
+    for (int i = 0; i < EPOCH_MAX_READERS; i++) {
+        uint64_t epoch = atomic_load(&domain->slots[i].epoch);
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+
+    pthread_mutex_lock(&domain->retireLock);
+
+    RetiredObject* freed = NULL;
+    int numFreed = 0;
+    while (domain->retiredHead && domain->retiredHead->epoch < oldest) {
+        RetiredObject* node = domain->retiredHead;
+        domain->retiredHead = node->next;
+        node->next = freed;
+        freed = node;
+        numFreed++;
+    }
+    if (!domain->retiredHead) domain->retiredTail = NULL;
+    domain->numRetired -= numFreed;
+
+    pthread_mutex_unlock(&domain->retireLock);
+
+    // Destruir fuera del lock y en orden de retiro
+    RetiredObject* ordered = NULL;
+    while (freed) {
+        RetiredObject* next = freed->next;
+        freed->next = ordered;
+        ordered = freed;
+        freed = next;
+    }
+    while (ordered) {
+        RetiredObject* next = ordered->next;
+        ordered->destroy(ordered->object);
+        free(ordered);
+        ordered = next;
+    }
+
+    return numFreed;
+}
@@ -0,0 +1,68 @@
+//
+// Created by administrador on 7/3/25.
+//
+
+#ifndef EPOCH_RECLAIM_H
+#define EPOCH_RECLAIM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define EPOCH_MAX_READERS 128   // Lectores simultáneos; el resto espera un lugar libre
+#define EPOCH_SLOT_BYTES 64     // Un lector por línea de caché
+
+// Reclamación por épocas (estilo RCU) para estructuras que se publican
+// con un puntero atómico. El lector fija la época antes de leer el puntero
+// y la suelta al terminar, sin locks. El escritor reemplaza el puntero y
+// retira la versión vieja: se libera cuando ya no queda ningún lector que
+// haya entrado antes del reemplazo.
+typedef void (*EpochDestructor)(void* object);
+
+typedef struct {
+    _Atomic uint64_t epoch;     // 0 = libre, si no la época fijada por el lector
+    char padding[EPOCH_SLOT_BYTES - sizeof(uint64_t)];
+} EpochSlot;
+
+typedef struct RetiredObject {
+    void* object;
+    EpochDestructor destroy;
+    uint64_t epoch;             // Época en que se retiró
+    struct RetiredObject* next;
+} RetiredObject;
+
+typedef struct {
+    EpochSlot slots[EPOCH_MAX_READERS];
+    _Atomic uint64_t globalEpoch;
+    pthread_mutex_t retireLock;
+    RetiredObject* retiredHead;  // En orden de retiro: se liberan en ese orden
+    RetiredObject* retiredTail;
+    int numRetired;
+} EpochDomain;
+
+EpochDomain* createEpochDomain(void);
+// Libera todo lo retirado: no debe quedar ningún lector
+void destroyEpochDomain(EpochDomain* domain);
+
+// Sección de lectura: lo que se cargó entre enter y exit sigue vivo
+// hasta el exit. Devuelve el lugar a pasar a epochExit
+int epochEnter(EpochDomain* domain);
+void epochExit(EpochDomain* domain, int slot);
+
+// El objeto ya no es alcanzable para lectores nuevos; se destruye cuando
+// terminen los que podían verlo. Intenta reclamar en el mismo llamado.
+// Nunca espera a los lectores (quien retira puede ser uno de ellos): sin
+// memoria para anotarlo avisa, deja el objeto sin liberar y devuelve false
+bool epochRetire(EpochDomain* domain, void* object, EpochDestructor destroy);
+int epochReclaim(EpochDomain* domain);
+
+// Retiro en dos pasos para el escritor que puede desistir: reserva el
+// nodo antes de publicar el reemplazo y, si no hay memoria, no publica.
+// epochRetireReserved consume el nodo (con object NULL solo lo libera)
+RetiredObject* epochReserveRetire(void);
+void epochRetireReserved(EpochDomain* domain, RetiredObject* node, void* object, EpochDestructor destroy);
+
+#endif //EPOCH_RECLAIM_H
@@ -1,4 +1,12 @@
 #include "../utils/file_io.h"
+#include "../utils/parallel_utils.h"
+#include <limits.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Cargar grafo desde archivo (formato automático)
 GraphData* loadGraphFromFile(const char* filename) {
@@ -167,6 +175,679 @@ bool loadEdgeList(const char* filename, int*** graph, int* numVertices) {
     return true;
 }
 
+// ===============================
+// LECTURA POR BLOQUES
+// ===============================
+
+// Lector de enteros sobre un buffer que se recarga de a bloques; un número
+// cortado al final de un bloque se sigue leyendo en el próximo
+typedef struct {
+    FILE* file;
+    char* buffer;
+    size_t size;
+    size_t pos;
+} IntStreamReader;
+
+static bool refillReader(IntStreamReader* reader) {
+    reader->size = fread(reader->buffer, 1, FILE_IO_CHUNK_SIZE, reader->file);
+    reader->pos = 0;
+    return reader->size > 0;
+}
+
+static inline int readerByte(IntStreamReader* reader) {
+    if (reader->pos == reader->size && !refillReader(reader)) return -1;
+    return (unsigned char)reader->buffer[reader->pos++];
+}
+
+// Próximo entero del texto byte a byte, recargando el bloque cuando hace
+// falta. Las líneas que empiezan con '#' o '%' son comentarios (volcados de
+// SNAP y Matrix Market). Devuelve false al final del archivo o si el número
+// no entra en un int
+static bool readNextIntSlow(IntStreamReader* reader, int* value) {
+    int c = readerByte(reader);
+    while (c != -1 && c != '-' && (c < '0' || c > '9')) {
+        if (c == '#' || c == '%') {
+            while (c != -1 && c != '\n') c = readerByte(reader);
+        }
+        c = readerByte(reader);
+    }
+    if (c == -1) return false;
+
+    bool negative = c == '-';
+    if (negative) c = readerByte(reader);
+    if (c < '0' || c > '9') return false;
+
+    long long number = 0;
+    while (c >= '0' && c <= '9') {
+        number = number * 10 + (c - '0');
+        if (number > (long long)INT_MAX + 1) return false;
+        c = readerByte(reader);
+    }
+    if (!negative && number > INT_MAX) return false;
+
+    *value = (int)(negative ? -number : number);
+    return true;
+}
+
+// Camino rápido para el caso común: un número no negativo de hasta 9
+// dígitos que termina dentro del bloque actual. Todo lo demás (signo,
+// comentarios, número cortado por el fin del bloque) va por readNextIntSlow
+static inline bool readNextInt(IntStreamReader* reader, int* value) {
+    const char* p = reader->buffer + reader->pos;
+    const char* end = reader->buffer + reader->size;
+
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r')) p++;
+
+    const char* digits = p;
+    int number = 0;
+    while (p < end && *p >= '0' && *p <= '9' && p - digits < 9) {
+        number = number * 10 + (*p - '0');
+        p++;
+    }
+
+    if (p > digits && p < end && (*p < '0' || *p > '9')) {
+        reader->pos = (size_t)(p - reader->buffer);
+        *value = number;
+        return true;
+    }
+
+    reader->pos = (size_t)(digits - reader->buffer);
+    return readNextIntSlow(reader, value);
+}
+
+// Volver al principio y saltar la cabecera "V E"
+static bool rewindEdgeList(IntStreamReader* reader, int* numVertices, int* numEdges) {
+    if (fseek(reader->file, 0, SEEK_SET) != 0) return false;
+    reader->size = 0;
+    reader->pos = 0;
+    return readNextInt(reader, numVertices) && readNextInt(reader, numEdges) &&
+           *numVertices >= 0 && *numEdges >= 0;
+}
+
+// Cargar lista de aristas directamente a CSR (sin matriz densa intermedia).
+// Mismo formato que loadEdgeList: "V E" seguido de E líneas "src dest peso";
+// lo que sigue a las primeras E se ignora. Dos pasadas por bloques: la
+// primera cuenta el grado de cada vértice y la segunda escribe cada arco en
+// su lugar, así que solo se reserva el CSR final (8 bytes por arco más los
+// offsets), nunca un arreglo de aristas. Las filas quedan ordenadas por
+// (destino, peso), igual que en loadEdgeListCSRParallel.
+CSRGraph* loadEdgeListCSR(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+
+    IntStreamReader reader = {file, (char*)malloc(FILE_IO_CHUNK_SIZE), 0, 0};
+    int numVertices, numEdges;
+    if (!reader.buffer || !rewindEdgeList(&reader, &numVertices, &numEdges)) {
+        free(reader.buffer);
+        fclose(file);
+        return NULL;
+    }
+
+    // Primera pasada: grados (los arcos con vértices fuera de rango se saltan)
+    int* cursor = (int*)calloc(numVertices + 1, sizeof(int));
+    long long numArcs = 0;
+    int src, dest, weight;
+    for (int i = 0; cursor && i < numEdges; i++) {
+        if (!readNextInt(&reader, &src) || !readNextInt(&reader, &dest) ||
+            !readNextInt(&reader, &weight)) break;
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) continue;
+        cursor[src]++;
+        numArcs++;
+    }
+
+    // loadEdgeList trata el archivo como dirigido: se mantiene el criterio
+    CSRGraph* csr = cursor && numArcs <= INT_MAX ? createCSRGraph(numVertices, (int)numArcs, true) : NULL;
+    if (!csr || !rewindEdgeList(&reader, &numVertices, &numEdges)) {
+        if (numArcs > INT_MAX) printf("❌ Error: %s tiene más arcos de los que admite CSRGraph\n", filename);
+        destroyCSRGraph(csr);
+        free(cursor);
+        free(reader.buffer);
+        fclose(file);
+        return NULL;
+    }
+
+    // Suma prefija y cursores de escritura
+    for (int u = 0; u < numVertices; u++) {
+        csr->offsets[u + 1] = csr->offsets[u] + cursor[u];
+    }
+    for (int u = 0; u < numVertices; u++) {
+        cursor[u] = csr->offsets[u];
+    }
+
+    // Segunda pasada: mismas líneas, mismo orden
+    for (int i = 0; i < numEdges; i++) {
+        if (!readNextInt(&reader, &src) || !readNextInt(&reader, &dest) ||
+            !readNextInt(&reader, &weight)) break;
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) continue;
+        int pos = cursor[src]++;
+        csr->targets[pos] = dest;
+        csr->weights[pos] = weight;
+    }
+    csrSortNeighbors(csr, 0, numVertices);
+
+    free(cursor);
+    free(reader.buffer);
+    fclose(file);
+    return csr;
+}
+
+// ===============================
+// CARGA EN PARALELO
+// ===============================
+
+// Archivo mapeado y partido en bloques de bytes. Cada bloque empieza justo
+// después de un '\n' (o en dataStart) y se queda con las líneas que
+// empiezan dentro de él, así que una línea cortada por el límite crudo
+// entre bloques la procesa entera el bloque donde empieza
+typedef struct {
+    const char* data;
+    size_t size;
+    int numChunks;
+    size_t* chunkStart;   // numChunks + 1 posiciones
+} TextChunks;
+
+static double elapsedMs(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static const char* skipLine(const char* p, const char* end) {
+    const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+    return newline ? newline + 1 : end;
+}
+
+// Próximo entero de la línea: 1 si lo leyó, 0 si la línea terminó (el
+// cursor queda al principio de la siguiente) y -1 si hay algo que no es un
+// número o no entra en un int
+static int scanLineInt(const char** cursor, const char* end, int* value) {
+    const char* p = *cursor;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    if (p == end || *p == '\n') {
+        *cursor = p < end ? p + 1 : p;
+        return 0;
+    }
+
+    bool negative = *p == '-';
+    if (negative) p++;
+    if (p == end || *p < '0' || *p > '9') {
+        *cursor = p;
+        return -1;
+    }
+
+    long long number = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        number = number * 10 + (*p - '0');
+        if (number > (long long)INT_MAX + 1) {
+            *cursor = p;
+            return -1;
+        }
+        p++;
+    }
+    *cursor = p;
+    if (!negative && number > INT_MAX) return -1;
+
+    *value = (int)(negative ? -number : number);
+    return 1;
+}
+
+// Leer hasta maxValues enteros de la línea y dejar el cursor en la siguiente.
+// Los comentarios ('#' o '%') y las líneas con basura cuentan 0 valores
+static int scanLine(const char** cursor, const char* end, int* values, int maxValues) {
+    const char* p = *cursor;
+    if (p < end && (*p == '#' || *p == '%')) {
+        *cursor = skipLine(p, end);
+        return 0;
+    }
+
+    int count = 0;
+    while (count < maxValues) {
+        int result = scanLineInt(&p, end, &values[count]);
+        if (result == 0) {
+            *cursor = p;
+            return count;
+        }
+        if (result < 0) {
+            *cursor = skipLine(p, end);
+            return 0;
+        }
+        count++;
+    }
+    *cursor = skipLine(p, end);
+    return count;
+}
+
+// Línea "src dest peso" de una lista de aristas. El caso común (tres
+// números sin signo separados por espacios) se lee sin pasar por scanLine
+static inline bool scanEdgeLine(const char** cursor, const char* end, int* values) {
+    const char* p = *cursor;
+
+    for (int k = 0; k < 3; k++) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        const char* digits = p;
+        int number = 0;
+        while (p < end && *p >= '0' && *p <= '9' && p - digits < 9) {
+            number = number * 10 + (*p - '0');
+            p++;
+        }
+        if (p == digits || (p < end && *p >= '0' && *p <= '9')) {
+            return scanLine(cursor, end, values, 3) == 3;
+        }
+        values[k] = number;
+    }
+
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    if (p < end && *p != '\n') {
+        return scanLine(cursor, end, values, 3) == 3;
+    }
+    *cursor = p < end ? p + 1 : p;
+    return true;
+}
+
+// Mapear el archivo, leer la cabecera (primera línea con números) y
+// partir el resto en bloques de FILE_IO_PARALLEL_CHUNK bytes
+static bool openTextChunks(const char* filename, TextChunks* chunks, int* header, int headerValues) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    chunks->size = (size_t)info.st_size;
+    chunks->data = (const char*)mmap(NULL, chunks->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (chunks->data == MAP_FAILED) return false;
+
+    const char* p = chunks->data;
+    const char* end = chunks->data + chunks->size;
+    int found = 0;
+    while (p < end && found == 0) {
+        found = scanLine(&p, end, header, headerValues);
+    }
+    if (found != headerValues) {
+        munmap((void*)chunks->data, chunks->size);
+        return false;
+    }
+
+    size_t dataStart = (size_t)(p - chunks->data);
+    size_t dataSize = chunks->size - dataStart;
+    chunks->numChunks = (int)((dataSize + FILE_IO_PARALLEL_CHUNK - 1) / FILE_IO_PARALLEL_CHUNK);
+    if (chunks->numChunks == 0) chunks->numChunks = 1;
+
+    chunks->chunkStart = (size_t*)malloc((chunks->numChunks + 1) * sizeof(size_t));
+    for (int k = 0; k < chunks->numChunks; k++) {
+        size_t pos = dataStart + (size_t)k * FILE_IO_PARALLEL_CHUNK;
+        if (k > 0) {
+            pos = (size_t)(skipLine(chunks->data + pos - 1, end) - chunks->data);
+        }
+        chunks->chunkStart[k] = pos;
+    }
+    chunks->chunkStart[chunks->numChunks] = chunks->size;
+    return true;
+}
+
+static void closeTextChunks(TextChunks* chunks) {
+    munmap((void*)chunks->data, chunks->size);
+    free(chunks->chunkStart);
+}
+
+static void reportLoadSpeed(const char* filename, size_t bytes, double ms, int numThreads) {
+    double megabytes = bytes / (1024.0 * 1024.0);
+    printf("📥 %s: %.1f MB en %.1f ms (%.1f MB/s, %d hilos)\n",
+           filename, megabytes, ms, megabytes / (ms > 0 ? ms / 1000.0 : 1e-9), numThreads);
+}
+
+typedef struct {
+    const TextChunks* chunks;
+    CSRGraph* csr;
+    _Atomic int* cursor;         // Grado en la primera pasada, posición de escritura en la segunda
+    long long* chunkArcs;
+    long long* chunkLines;       // Líneas "src dest peso" de cada bloque, válidas o no
+    int vertexBlock;
+} EdgeListLoadJob;
+
+// Leer hasta FILE_IO_EDGE_BATCH aristas válidas del bloque (tríos en batch)
+// y pedir de antemano la línea de caché del cursor de cada origen: el
+// fetch_add atómico no deja solapar fallos de caché, así que se los adelanta.
+// lines cuenta también las aristas con vértices fuera de rango
+static int scanEdgeBatch(EdgeListLoadJob* job, const char** cursor, const char* end, int* batch,
+                         long long* lines) {
+    const char* fileEnd = job->chunks->data + job->chunks->size;
+    int n = job->csr->numVertices;
+    int count = 0;
+
+    while (*cursor < end && count < FILE_IO_EDGE_BATCH) {
+        int* values = &batch[count * 3];
+        if (!scanEdgeLine(cursor, fileEnd, values)) continue;
+        (*lines)++;
+        if (values[0] < 0 || values[0] >= n || values[1] < 0 || values[1] >= n) continue;
+        __builtin_prefetch((const void*)&job->cursor[values[0]], 1);
+        count++;
+    }
+    return count;
+}
+
+static void countEdgeListChunk(int chunk, int threadIndex, void* context) {
+    (void)threadIndex;
+    EdgeListLoadJob* job = (EdgeListLoadJob*)context;
+    const char* p = job->chunks->data + job->chunks->chunkStart[chunk];
+    const char* end = job->chunks->data + job->chunks->chunkStart[chunk + 1];
+    int batch[FILE_IO_EDGE_BATCH * 3];
+    long long arcs = 0, lines = 0;
+
+    int count;
+    while ((count = scanEdgeBatch(job, &p, end, batch, &lines)) > 0) {
+        for (int i = 0; i < count; i++) {
+            atomic_fetch_add_explicit(&job->cursor[batch[i * 3]], 1, memory_order_relaxed);
+        }
+        arcs += count;
+    }
+    job->chunkArcs[chunk] = arcs;
+    job->chunkLines[chunk] = lines;
+}
+
+// Como loadEdgeListCSR, solo cuentan las primeras numEdges líneas. Si el
+// archivo trae más, se corta el bloque donde cae la línea numEdges + 1 y se
+// descuentan los grados de lo que sigue (trabajo proporcional al sobrante).
+// Devuelve los arcos descontados
+static long long truncateEdgeListChunks(EdgeListLoadJob* job, TextChunks* chunks, long long numEdges) {
+    const char* fileEnd = chunks->data + chunks->size;
+    int n = job->csr->numVertices;
+    int values[3];
+
+    long long before = 0;
+    int k = 0;
+    while (k < chunks->numChunks && before + job->chunkLines[k] <= numEdges) {
+        before += job->chunkLines[k++];
+    }
+    if (k == chunks->numChunks) return 0;
+
+    // Fin de la última línea que se conserva
+    const char* cut = chunks->data + chunks->chunkStart[k];
+    while (before < numEdges) {
+        if (scanEdgeLine(&cut, fileEnd, values)) before++;
+    }
+
+    long long dropped = 0;
+    const char* p = cut;
+    while (p < fileEnd) {
+        if (!scanEdgeLine(&p, fileEnd, values)) continue;
+        if (values[0] < 0 || values[0] >= n || values[1] < 0 || values[1] >= n) continue;
+        atomic_fetch_sub_explicit(&job->cursor[values[0]], 1, memory_order_relaxed);
+        dropped++;
+    }
+
+    for (int j = k + 1; j <= chunks->numChunks; j++) {
+        chunks->chunkStart[j] = (size_t)(cut - chunks->data);
+    }
+    return dropped;
+}
+
+static void fillEdgeListChunk(int chunk, int threadIndex, void* context) {
+    (void)threadIndex;
+    EdgeListLoadJob* job = (EdgeListLoadJob*)context;
+    const char* p = job->chunks->data + job->chunks->chunkStart[chunk];
+    const char* end = job->chunks->data + job->chunks->chunkStart[chunk + 1];
+    int batch[FILE_IO_EDGE_BATCH * 3];
+
+    int positions[FILE_IO_EDGE_BATCH];
+    long long lines = 0;
+
+    // Mismo adelanto para las posiciones de destino antes de escribir
+    int count;
+    while ((count = scanEdgeBatch(job, &p, end, batch, &lines)) > 0) {
+        for (int i = 0; i < count; i++) {
+            positions[i] = atomic_fetch_add_explicit(&job->cursor[batch[i * 3]], 1, memory_order_relaxed);
+            __builtin_prefetch(&job->csr->targets[positions[i]], 1);
+            __builtin_prefetch(&job->csr->weights[positions[i]], 1);
+        }
+        for (int i = 0; i < count; i++) {
+            job->csr->targets[positions[i]] = batch[i * 3 + 1];
+            job->csr->weights[positions[i]] = batch[i * 3 + 2];
+        }
+    }
+}
+
+static void sortEdgeListBlock(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    EdgeListLoadJob* job = (EdgeListLoadJob*)context;
+    csrSortNeighbors(job->csr, block * job->vertexBlock, (block + 1) * job->vertexBlock);
+}
+
+// Lista de aristas en paralelo con el mismo resultado que loadEdgeListCSR:
+// solo las primeras E líneas "src dest peso" de la cabecera y, como los
+// hilos escriben cada fila en cualquier orden, vecinos ordenados por
+// (destino, peso)
+CSRGraph* loadEdgeListCSRParallel(const char* filename, int numThreads) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    numThreads = resolveThreadCount(numThreads);
+
+    TextChunks chunks;
+    int header[2];
+    if (!filename || !openTextChunks(filename, &chunks, header, 2)) return NULL;
+    int numVertices = header[0], numEdges = header[1];
+    if (numVertices < 0 || numEdges < 0) {
+        closeTextChunks(&chunks);
+        return NULL;
+    }
+
+    EdgeListLoadJob job;
+    job.chunks = &chunks;
+    job.csr = createCSRGraph(numVertices, 0, true);
+    job.cursor = (_Atomic int*)calloc(numVertices + 1, sizeof(_Atomic int));
+    job.chunkArcs = (long long*)calloc(chunks.numChunks, sizeof(long long));
+    job.chunkLines = (long long*)calloc(chunks.numChunks, sizeof(long long));
+    job.vertexBlock = FILE_IO_SORT_BLOCK;
+    if (!job.csr || !job.cursor || !job.chunkArcs || !job.chunkLines) {
+        destroyCSRGraph(job.csr);
+        free((void*)job.cursor);
+        free(job.chunkArcs);
+        free(job.chunkLines);
+        closeTextChunks(&chunks);
+        return NULL;
+    }
+
+    // Primera pasada: grados
+    parallelFor(chunks.numChunks, numThreads, countEdgeListChunk, &job);
+
+    long long numArcs = 0, numLines = 0;
+    for (int k = 0; k < chunks.numChunks; k++) {
+        numArcs += job.chunkArcs[k];
+        numLines += job.chunkLines[k];
+    }
+    if (numLines > numEdges) {
+        numArcs -= truncateEdgeListChunks(&job, &chunks, numEdges);
+    }
+    int* targets = numArcs <= INT_MAX ? (int*)malloc((numArcs > 0 ? numArcs : 1) * sizeof(int)) : NULL;
+    int* weights = numArcs <= INT_MAX ? (int*)malloc((numArcs > 0 ? numArcs : 1) * sizeof(int)) : NULL;
+    if (!targets || !weights) {
+        if (numArcs > INT_MAX) printf("❌ Error: %s tiene más arcos de los que admite CSRGraph\n", filename);
+        free(targets);
+        free(weights);
+        destroyCSRGraph(job.csr);
+        free((void*)job.cursor);
+        free(job.chunkArcs);
+        free(job.chunkLines);
+        closeTextChunks(&chunks);
+        return NULL;
+    }
+    free(job.csr->targets);
+    free(job.csr->weights);
+    job.csr->targets = targets;
+    job.csr->weights = weights;
+    job.csr->numEdges = (int)numArcs;
+
+    // Suma prefija y cursores de escritura
+    for (int u = 0; u < numVertices; u++) {
+        job.csr->offsets[u + 1] = job.csr->offsets[u] + atomic_load_explicit(&job.cursor[u], memory_order_relaxed);
+    }
+    for (int u = 0; u < numVertices; u++) {
+        atomic_store_explicit(&job.cursor[u], job.csr->offsets[u], memory_order_relaxed);
+    }
+
+    // Segunda pasada: escribir y dejar cada fila en orden canónico
+    parallelFor(chunks.numChunks, numThreads, fillEdgeListChunk, &job);
+    parallelFor((numVertices + job.vertexBlock - 1) / job.vertexBlock, numThreads, sortEdgeListBlock, &job);
+
+    if (numLines != numEdges || numArcs != numEdges) {
+        printf("⚠️  %s: la cabecera declara %d aristas; hay %lld líneas y se cargaron %lld arcos\n",
+               filename, numEdges, numLines, numArcs);
+    }
+    reportLoadSpeed(filename, chunks.size, elapsedMs(&start), numThreads);
+
+    CSRGraph* csr = job.csr;
+    free((void*)job.cursor);
+    free(job.chunkArcs);
+    free(job.chunkLines);
+    closeTextChunks(&chunks);
+    return csr;
+}
+
+// Ceros por fila que cuenta cada bloque en la primera pasada de la matriz
+typedef struct {
+    int* nonZeros;
+    int numRows;
+    int capacity;
+    bool malformed;     // Alguna fila sin exactamente numVertices valores
+} MatrixChunkRows;
+
+typedef struct {
+    const TextChunks* chunks;
+    CSRGraph* csr;
+    MatrixChunkRows* rows;
+    int* firstRow;      // Primera fila de cada bloque
+} MatrixLoadJob;
+
+static void countMatrixChunk(int chunk, int threadIndex, void* context) {
+    (void)threadIndex;
+    MatrixLoadJob* job = (MatrixLoadJob*)context;
+    MatrixChunkRows* rows = &job->rows[chunk];
+    const char* p = job->chunks->data + job->chunks->chunkStart[chunk];
+    const char* end = job->chunks->data + job->chunks->chunkStart[chunk + 1];
+    const char* fileEnd = job->chunks->data + job->chunks->size;
+    int n = job->csr->numVertices;
+
+    while (p < end) {
+        if (*p == '#' || *p == '%') {
+            p = skipLine(p, fileEnd);
+            continue;
+        }
+
+        int columns = 0, nonZeros = 0, value, result;
+        while ((result = scanLineInt(&p, fileEnd, &value)) == 1) {
+            columns++;
+            if (value != 0) nonZeros++;
+        }
+        if (result < 0) {
+            rows->malformed = true;
+            p = skipLine(p, fileEnd);
+        }
+        if (columns == 0 && result == 0) continue;   // Línea en blanco
+        if (columns != n) rows->malformed = true;
+
+        if (rows->numRows == rows->capacity) {
+            rows->capacity = rows->capacity ? rows->capacity * 2 : 64;
+            rows->nonZeros = (int*)realloc(rows->nonZeros, rows->capacity * sizeof(int));
+        }
+        rows->nonZeros[rows->numRows++] = nonZeros;
+    }
+}
+
+static void fillMatrixChunk(int chunk, int threadIndex, void* context) {
+    (void)threadIndex;
+    MatrixLoadJob* job = (MatrixLoadJob*)context;
+    const char* p = job->chunks->data + job->chunks->chunkStart[chunk];
+    const char* end = job->chunks->data + job->chunks->chunkStart[chunk + 1];
+    const char* fileEnd = job->chunks->data + job->chunks->size;
+    int row = job->firstRow[chunk];
+
+    while (p < end) {
+        if (*p == '#' || *p == '%') {
+            p = skipLine(p, fileEnd);
+            continue;
+        }
+
+        int pos = job->csr->offsets[row];
+        int column = 0, value;
+        while (scanLineInt(&p, fileEnd, &value) == 1) {
+            if (value != 0) {
+                job->csr->targets[pos] = column;
+                job->csr->weights[pos] = value;
+                pos++;
+            }
+            column++;
+        }
+        if (column > 0) row++;
+    }
+}
+
+// Matriz de adyacencia simple ("n" y una fila de n pesos por línea) a CSR
+// dirigido, sin reservar nunca la matriz densa
+CSRGraph* loadAdjacencyMatrixCSRParallel(const char* filename, int numThreads) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    numThreads = resolveThreadCount(numThreads);
+
+    TextChunks chunks;
+    int numVertices;
+    if (!filename || !openTextChunks(filename, &chunks, &numVertices, 1)) return NULL;
+
+    MatrixLoadJob job;
+    job.chunks = &chunks;
+    job.csr = numVertices >= 0 ? createCSRGraph(numVertices, 0, true) : NULL;
+    job.rows = (MatrixChunkRows*)calloc(chunks.numChunks, sizeof(MatrixChunkRows));
+    job.firstRow = (int*)malloc(chunks.numChunks * sizeof(int));
+
+    bool ok = job.csr && job.rows && job.firstRow;
+    if (ok) {
+        // Primera pasada: filas y valores no nulos de cada una
+        parallelFor(chunks.numChunks, numThreads, countMatrixChunk, &job);
+
+        int row = 0;
+        long long numArcs = 0;
+        for (int k = 0; ok && k < chunks.numChunks; k++) {
+            job.firstRow[k] = row;
+            ok = !job.rows[k].malformed && row + job.rows[k].numRows <= numVertices;
+            for (int r = 0; ok && r < job.rows[k].numRows; r++) {
+                job.csr->offsets[row + 1] = job.csr->offsets[row] + job.rows[k].nonZeros[r];
+                numArcs += job.rows[k].nonZeros[r];
+                row++;
+            }
+        }
+        ok = ok && row == numVertices && numArcs <= INT_MAX;
+        if (!ok) printf("❌ Error: %s no es una matriz de %d x %d válida\n", filename, numVertices, numVertices);
+
+        if (ok) {
+            int* targets = (int*)realloc(job.csr->targets, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+            if (targets) job.csr->targets = targets;
+            int* weights = (int*)realloc(job.csr->weights, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+            if (weights) job.csr->weights = weights;
+            ok = targets && weights;
+            job.csr->numEdges = (int)numArcs;
+        }
+    }
+
+    // Segunda pasada: cada bloque escribe sus filas en su propio rango
+    if (ok) {
+        parallelFor(chunks.numChunks, numThreads, fillMatrixChunk, &job);
+        reportLoadSpeed(filename, chunks.size, elapsedMs(&start), numThreads);
+    }
+
+    CSRGraph* csr = ok ? job.csr : NULL;
+    if (!ok) destroyCSRGraph(job.csr);
+    for (int k = 0; job.rows && k < chunks.numChunks; k++) {
+        free(job.rows[k].nonZeros);
+    }
+    free(job.rows);
+    free(job.firstRow);
+    closeTextChunks(&chunks);
+    return csr;
+}
+
 // Guardar como lista de aristas
 bool saveEdgeList(const char* filename, int** graph, int numVertices) {
     FILE* file = fopen(filename, "w");
@@ -9,6 +9,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include "../graph/csr_graph.h"
+
+#define FILE_IO_CHUNK_SIZE (1 << 20)       // Bytes por bloque en la carga de listas de aristas
+#define FILE_IO_PARALLEL_CHUNK (4 << 20)   // Bytes de texto que toma un hilo por vez
+#define FILE_IO_SORT_BLOCK 16384           // Vértices por tarea al ordenar vecinos
+#define FILE_IO_EDGE_BATCH 64              // Aristas leídas antes de tocar los cursores
 
 // Estructuras para manejo de archivos
 typedef struct {
@@ -25,6 +31,11 @@ bool loadAdjacencyMatrix(const char* filename, int*** graph, int* numVertices);
 bool saveAdjacencyMatrix(const char* filename, int** graph, int numVertices);
 bool loadEdgeList(const char* filename, int*** graph, int* numVertices);
 bool saveEdgeList(const char* filename, int** graph, int numVertices);
+CSRGraph* loadEdgeListCSR(const char* filename);
+// Cargas en paralelo por rangos de bytes del archivo mapeado (numThreads <= 0
+// usa todos los núcleos); informan los MB/s alcanzados
+CSRGraph* loadEdgeListCSRParallel(const char* filename, int numThreads);
+CSRGraph* loadAdjacencyMatrixCSRParallel(const char* filename, int numThreads);
 void freeGraphData(GraphData* data);
 
 #endif //FILE_IO_H
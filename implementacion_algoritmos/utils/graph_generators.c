@@ -0,0 +1,621 @@
+//
+// Created by administrador on 7/2/25.
+//
+
+#include "graph_generators.h"
+#include "parallel_utils.h"
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <stdatomic.h>
+
+#define GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
+#define KM_PER_DEGREE 111.32   // Kilómetros por grado de latitud
+
+// ===============================
+// NÚMEROS ALEATORIOS POR ÍNDICE
+// ===============================
+
+// Secuencia splitmix64 propia de cada arista o vértice: arranca en un hash
+// de (seed, índice), así cualquier hilo genera el mismo elemento
+typedef struct {
+    uint64_t state;
+} GeneratorRandom;
+
+static inline uint64_t mixBits(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static inline GeneratorRandom randomFor(uint64_t seed, uint64_t index) {
+    GeneratorRandom random;
+    random.state = mixBits(seed ^ mixBits(index + 1));
+    return random;
+}
+
+static inline uint64_t nextRandom(GeneratorRandom* random) {
+    random->state += GOLDEN_GAMMA;
+    return mixBits(random->state);
+}
+
+// Uniforme en [0, 1) con 53 bits
+static inline double nextUnit(GeneratorRandom* random) {
+    return (double)(nextRandom(random) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline int numBlocks(long long count, int blockSize) {
+    return (int)((count + blockSize - 1) / blockSize);
+}
+
+// ===============================
+// CSR DESDE UNA FUNCIÓN DE ARISTAS
+// ===============================
+
+typedef struct EdgeJob EdgeJob;
+
+// Genera la arista index; false si se descarta (lazo)
+typedef bool (*EdgeFunction)(const EdgeJob* job, long long index, int* src, int* dest, int* weight);
+
+// Las aristas no se guardan: se generan una vez para contar grados y otra
+// para escribirlas, que cuesta menos que un arreglo de Edge de 10M+ entradas
+struct EdgeJob {
+    EdgeFunction edge;
+    long long numEdges;
+    bool isDirected;
+    uint64_t seed;
+    int maxWeight;
+    int scale;              // R-MAT
+    uint32_t a, ab, abc;    // R-MAT: probabilidades acumuladas de los cuadrantes en 32 bits
+    int edgesPerVertex;     // Barabási-Albert
+    CSRGraph* csr;
+    _Atomic int* cursor;    // Grado en la primera pasada, posición de escritura en la segunda
+    long long* blockArcs;
+};
+
+// Generar hasta GENERATOR_BATCH aristas y adelantar la línea de caché de
+// los cursores, igual que el cargador paralelo de file_io.c
+static int generateEdgeBatch(const EdgeJob* job, long long* next, long long end, int* batch) {
+    int count = 0;
+    while (*next < end && count < GENERATOR_BATCH) {
+        int* values = &batch[count * 3];
+        if (!job->edge(job, (*next)++, &values[0], &values[1], &values[2])) continue;
+        __builtin_prefetch((const void*)&job->cursor[values[0]], 1);
+        if (!job->isDirected) __builtin_prefetch((const void*)&job->cursor[values[1]], 1);
+        count++;
+    }
+    return count;
+}
+
+static void countGeneratedEdges(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    EdgeJob* job = (EdgeJob*)context;
+    long long next = (long long)block * GENERATOR_EDGE_BLOCK;
+    long long end = next + GENERATOR_EDGE_BLOCK < job->numEdges ? next + GENERATOR_EDGE_BLOCK : job->numEdges;
+    int batch[GENERATOR_BATCH * 3];
+    long long arcs = 0;
+
+    int count;
+    while ((count = generateEdgeBatch(job, &next, end, batch)) > 0) {
+        for (int i = 0; i < count; i++) {
+            atomic_fetch_add_explicit(&job->cursor[batch[i * 3]], 1, memory_order_relaxed);
+            if (!job->isDirected) {
+                atomic_fetch_add_explicit(&job->cursor[batch[i * 3 + 1]], 1, memory_order_relaxed);
+            }
+        }
+        arcs += job->isDirected ? count : 2LL * count;
+    }
+    job->blockArcs[block] = arcs;
+}
+
+static void fillGeneratedEdges(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    EdgeJob* job = (EdgeJob*)context;
+    long long next = (long long)block * GENERATOR_EDGE_BLOCK;
+    long long end = next + GENERATOR_EDGE_BLOCK < job->numEdges ? next + GENERATOR_EDGE_BLOCK : job->numEdges;
+    int batch[GENERATOR_BATCH * 3];
+    int positions[GENERATOR_BATCH * 2];
+
+    int count;
+    while ((count = generateEdgeBatch(job, &next, end, batch)) > 0) {
+        for (int i = 0; i < count; i++) {
+            positions[i * 2] = atomic_fetch_add_explicit(&job->cursor[batch[i * 3]], 1, memory_order_relaxed);
+            __builtin_prefetch(&job->csr->targets[positions[i * 2]], 1);
+            __builtin_prefetch(&job->csr->weights[positions[i * 2]], 1);
+            if (!job->isDirected) {
+                positions[i * 2 + 1] = atomic_fetch_add_explicit(&job->cursor[batch[i * 3 + 1]], 1,
+                                                                 memory_order_relaxed);
+                __builtin_prefetch(&job->csr->targets[positions[i * 2 + 1]], 1);
+                __builtin_prefetch(&job->csr->weights[positions[i * 2 + 1]], 1);
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            int* values = &batch[i * 3];
+            job->csr->targets[positions[i * 2]] = values[1];
+            job->csr->weights[positions[i * 2]] = values[2];
+            if (!job->isDirected) {
+                job->csr->targets[positions[i * 2 + 1]] = values[0];
+                job->csr->weights[positions[i * 2 + 1]] = values[2];
+            }
+        }
+    }
+}
+
+static void sortGeneratedRows(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    EdgeJob* job = (EdgeJob*)context;
+    csrSortNeighbors(job->csr, block * GENERATOR_VERTEX_BLOCK, (block + 1) * GENERATOR_VERTEX_BLOCK);
+}
+
+static CSRGraph* buildGeneratedCSR(EdgeJob* job, int numVertices, int numThreads) {
+    numThreads = resolveThreadCount(numThreads);
+    int numEdgeBlocks = numBlocks(job->numEdges, GENERATOR_EDGE_BLOCK);
+
+    job->csr = createCSRGraph(numVertices, 0, job->isDirected);
+    job->cursor = (_Atomic int*)calloc(numVertices + 1, sizeof(_Atomic int));
+    job->blockArcs = (long long*)calloc(numEdgeBlocks > 0 ? numEdgeBlocks : 1, sizeof(long long));
+    if (!job->csr || !job->cursor || !job->blockArcs) {
+        destroyCSRGraph(job->csr);
+        free((void*)job->cursor);
+        free(job->blockArcs);
+        return NULL;
+    }
+
+    // Primera pasada: grados
+    parallelFor(numEdgeBlocks, numThreads, countGeneratedEdges, job);
+
+    long long numArcs = 0;
+    for (int k = 0; k < numEdgeBlocks; k++) {
+        numArcs += job->blockArcs[k];
+    }
+    int* targets = numArcs <= INT_MAX ? (int*)malloc((numArcs > 0 ? numArcs : 1) * sizeof(int)) : NULL;
+    int* weights = numArcs <= INT_MAX ? (int*)malloc((numArcs > 0 ? numArcs : 1) * sizeof(int)) : NULL;
+    if (!targets || !weights) {
+        if (numArcs > INT_MAX) printf("❌ Error: %lld arcos exceden lo que admite CSRGraph\n", numArcs);
+        free(targets);
+        free(weights);
+        destroyCSRGraph(job->csr);
+        free((void*)job->cursor);
+        free(job->blockArcs);
+        return NULL;
+    }
+    free(job->csr->targets);
+    free(job->csr->weights);
+    job->csr->targets = targets;
+    job->csr->weights = weights;
+    job->csr->numEdges = (int)numArcs;
+
+    // Suma prefija y cursores de escritura
+    for (int u = 0; u < numVertices; u++) {
+        job->csr->offsets[u + 1] = job->csr->offsets[u] + atomic_load_explicit(&job->cursor[u], memory_order_relaxed);
+    }
+    for (int u = 0; u < numVertices; u++) {
+        atomic_store_explicit(&job->cursor[u], job->csr->offsets[u], memory_order_relaxed);
+    }
+
+    // Segunda pasada: escribir y dejar cada fila en orden canónico, que no
+    // depende de cómo se intercalaron los hilos
+    parallelFor(numEdgeBlocks, numThreads, fillGeneratedEdges, job);
+    parallelFor(numBlocks(numVertices, GENERATOR_VERTEX_BLOCK), numThreads, sortGeneratedRows, job);
+
+    CSRGraph* csr = job->csr;
+    free((void*)job->cursor);
+    free(job->blockArcs);
+    return csr;
+}
+
+// ===============================
+// R-MAT
+// ===============================
+
+// Cuadrante de un nivel sin saltos: con p uniforme de 32 bits, el bit de
+// fila se enciende en los cuadrantes c y d (p >= a + b) y el de columna en
+// b y d, que son los tramos donde cambia la paridad de los tres umbrales.
+// Un if por cuadrante falla la predicción casi siempre y eso domina el costo.
+static inline void rmatLevel(const EdgeJob* job, uint32_t p, int* u, int* v) {
+    int pastA = p >= job->a, pastAB = p >= job->ab, pastABC = p >= job->abc;
+    *u = (*u << 1) | pastAB;
+    *v = (*v << 1) | (pastA ^ pastAB ^ pastABC);
+}
+
+static bool rmatEdge(const EdgeJob* job, long long index, int* src, int* dest, int* weight) {
+    GeneratorRandom random = randomFor(job->seed, (uint64_t)index);
+    int u = 0, v = 0;
+
+    // Dos niveles por número de 64 bits
+    int level = 0;
+    for (; level + 1 < job->scale; level += 2) {
+        uint64_t bits = nextRandom(&random);
+        rmatLevel(job, (uint32_t)bits, &u, &v);
+        rmatLevel(job, (uint32_t)(bits >> 32), &u, &v);
+    }
+    if (level < job->scale) {
+        rmatLevel(job, (uint32_t)nextRandom(&random), &u, &v);
+    }
+    if (u == v) return false;
+
+    *src = u;
+    *dest = v;
+    *weight = 1 + (int)(nextRandom(&random) % (uint64_t)job->maxWeight);
+    return true;
+}
+
+// p en [0, 1] a umbral de 32 bits: P(x < umbral) = p para x uniforme
+static uint32_t probabilityThreshold(double p) {
+    double scaled = p * 4294967296.0;
+    return scaled >= 4294967295.0 ? UINT32_MAX : (uint32_t)scaled;
+}
+
+CSRGraph* generateRMATGraph(int scale, int edgeFactor, double a, double b, double c,
+                            int maxWeight, bool isDirected, uint64_t seed, int numThreads) {
+    if (scale < 1 || scale > 30 || edgeFactor < 0 || maxWeight < 1) return NULL;
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1.0) return NULL;
+
+    EdgeJob job;
+    memset(&job, 0, sizeof(job));
+    job.edge = rmatEdge;
+    job.numEdges = (long long)edgeFactor << scale;
+    job.isDirected = isDirected;
+    job.seed = seed;
+    job.maxWeight = maxWeight;
+    job.scale = scale;
+    job.a = probabilityThreshold(a);
+    job.ab = probabilityThreshold(a + b);
+    job.abc = probabilityThreshold(a + b + c);
+
+    return buildGeneratedCSR(&job, 1 << scale, numThreads);
+}
+
+// ===============================
+// BARABÁSI-ALBERT
+// ===============================
+
+// Lista implícita de extremos: la posición 2e es el origen de la arista e
+// (el vértice e / edgesPerVertex) y la 2e + 1 su destino, que copia la
+// posición uniforme en [0, 2e] elegida por esa arista. Una posición impar
+// remite a otra arista anterior, así que la cadena siempre termina.
+static bool barabasiAlbertEdge(const EdgeJob* job, long long index, int* src, int* dest, int* weight) {
+    GeneratorRandom random = randomFor(job->seed, (uint64_t)index);
+    long long position = (long long)(nextRandom(&random) % (uint64_t)(2 * index + 1));
+
+    while (position & 1) {
+        long long previous = position >> 1;
+        GeneratorRandom chained = randomFor(job->seed, (uint64_t)previous);
+        position = (long long)(nextRandom(&chained) % (uint64_t)(2 * previous + 1));
+    }
+
+    int source = (int)(index / job->edgesPerVertex);
+    int target = (int)((position >> 1) / job->edgesPerVertex);
+    if (source == target) return false;
+
+    *src = source;
+    *dest = target;
+    *weight = 1 + (int)(nextRandom(&random) % (uint64_t)job->maxWeight);
+    return true;
+}
+
+CSRGraph* generateBarabasiAlbertGraph(int numVertices, int edgesPerVertex, int maxWeight,
+                                      uint64_t seed, int numThreads) {
+    if (numVertices < 0 || edgesPerVertex < 1 || maxWeight < 1) return NULL;
+
+    EdgeJob job;
+    memset(&job, 0, sizeof(job));
+    job.edge = barabasiAlbertEdge;
+    job.numEdges = (long long)numVertices * edgesPerVertex;
+    job.isDirected = false;
+    job.seed = seed;
+    job.maxWeight = maxWeight;
+    job.edgesPerVertex = edgesPerVertex;
+
+    return buildGeneratedCSR(&job, numVertices, numThreads);
+}
+
+// ===============================
+// GRILLA
+// ===============================
+
+typedef struct {
+    CSRGraph* csr;
+    int rows;
+    int cols;
+    int maxWeight;
+    uint64_t seed;
+} GridJob;
+
+// Peso de la calle entre u y el vecino derecho (vertical = false) o de
+// abajo: lo comparten los dos sentidos
+static inline int gridWeight(const GridJob* job, int u, bool vertical) {
+    GeneratorRandom random = randomFor(job->seed, (uint64_t)u * 2 + vertical);
+    return 1 + (int)(nextRandom(&random) % (uint64_t)job->maxWeight);
+}
+
+static void fillGridRows(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    GridJob* job = (GridJob*)context;
+    int n = job->rows * job->cols;
+    int first = block * GENERATOR_VERTEX_BLOCK;
+    int last = first + GENERATOR_VERTEX_BLOCK < n ? first + GENERATOR_VERTEX_BLOCK : n;
+
+    // Vecinos en orden creciente: arriba, izquierda, derecha, abajo
+    for (int v = first; v < last; v++) {
+        int row = v / job->cols, col = v % job->cols;
+        int pos = job->csr->offsets[v];
+
+        if (row > 0) {
+            job->csr->targets[pos] = v - job->cols;
+            job->csr->weights[pos++] = gridWeight(job, v - job->cols, true);
+        }
+        if (col > 0) {
+            job->csr->targets[pos] = v - 1;
+            job->csr->weights[pos++] = gridWeight(job, v - 1, false);
+        }
+        if (col + 1 < job->cols) {
+            job->csr->targets[pos] = v + 1;
+            job->csr->weights[pos++] = gridWeight(job, v, false);
+        }
+        if (row + 1 < job->rows) {
+            job->csr->targets[pos] = v + job->cols;
+            job->csr->weights[pos++] = gridWeight(job, v, true);
+        }
+    }
+}
+
+CSRGraph* generateGridNetwork(int rows, int cols, int maxWeight, uint64_t seed, int numThreads) {
+    if (rows < 1 || cols < 1 || maxWeight < 1) return NULL;
+    if ((long long)rows * cols > INT_MAX) return NULL;
+
+    int n = rows * cols;
+    long long numArcs = 2LL * ((long long)rows * (cols - 1) + (long long)(rows - 1) * cols);
+    if (numArcs > INT_MAX) {
+        printf("❌ Error: %lld arcos exceden lo que admite CSRGraph\n", numArcs);
+        return NULL;
+    }
+
+    GridJob job;
+    job.csr = createCSRGraph(n, (int)numArcs, false);
+    job.rows = rows;
+    job.cols = cols;
+    job.maxWeight = maxWeight;
+    job.seed = seed;
+    if (!job.csr) return NULL;
+
+    for (int v = 0; v < n; v++) {
+        int row = v / cols, col = v % cols;
+        int degree = (row > 0) + (row + 1 < rows) + (col > 0) + (col + 1 < cols);
+        job.csr->offsets[v + 1] = job.csr->offsets[v] + degree;
+    }
+
+    parallelFor(numBlocks(n, GENERATOR_VERTEX_BLOCK), resolveThreadCount(numThreads), fillGridRows, &job);
+    return job.csr;
+}
+
+// ===============================
+// GEOMÉTRICO
+// ===============================
+
+typedef struct {
+    CSRGraph* csr;
+    int numVertices;
+    uint64_t seed;
+    double* x;              // Coordenadas en el cuadrado unitario
+    double* y;
+    int* cellStart;         // Vértices de la celda c: cellStart[c] .. cellStart[c+1]-1
+    int cellsPerSide;
+    double radius;
+    double metersPerUnit;
+    int* degree;
+} GeometricJob;
+
+static inline int cellCoordinate(const GeometricJob* job, double value) {
+    int cell = (int)(value * job->cellsPerSide);
+    return cell < job->cellsPerSide ? cell : job->cellsPerSide - 1;
+}
+
+static void placeGeometricPoints(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    GeometricJob* job = (GeometricJob*)context;
+    int first = block * GENERATOR_VERTEX_BLOCK;
+    int last = first + GENERATOR_VERTEX_BLOCK < job->numVertices ? first + GENERATOR_VERTEX_BLOCK : job->numVertices;
+
+    for (int i = first; i < last; i++) {
+        GeneratorRandom random = randomFor(job->seed, (uint64_t)i);
+        job->x[i] = nextUnit(&random);
+        job->y[i] = nextUnit(&random);
+    }
+}
+
+// Recorrer los vecinos de v dentro del radio en las 3x3 celdas cercanas.
+// Las celdas se visitan en orden de id y los vértices están numerados por
+// celda, así que la fila queda ordenada por destino sin ordenarla aparte.
+// Con write = false solo cuenta.
+static int scanGeometricNeighbors(GeometricJob* job, int v, bool write) {
+    int cx = cellCoordinate(job, job->x[v]);
+    int cy = cellCoordinate(job, job->y[v]);
+    double radius2 = job->radius * job->radius;
+    int pos = write ? job->csr->offsets[v] : 0;
+    int count = 0;
+
+    for (int ny = cy - 1; ny <= cy + 1; ny++) {
+        if (ny < 0 || ny >= job->cellsPerSide) continue;
+        for (int nx = cx - 1; nx <= cx + 1; nx++) {
+            if (nx < 0 || nx >= job->cellsPerSide) continue;
+
+            int cell = ny * job->cellsPerSide + nx;
+            for (int w = job->cellStart[cell]; w < job->cellStart[cell + 1]; w++) {
+                if (w == v) continue;
+                double dx = job->x[w] - job->x[v];
+                double dy = job->y[w] - job->y[v];
+                double dist2 = dx * dx + dy * dy;
+                if (dist2 >= radius2) continue;
+
+                if (write) {
+                    int meters = (int)lround(sqrt(dist2) * job->metersPerUnit);
+                    job->csr->targets[pos] = w;
+                    job->csr->weights[pos++] = meters > 0 ? meters : 1;
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static void countGeometricRows(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    GeometricJob* job = (GeometricJob*)context;
+    int first = block * GENERATOR_VERTEX_BLOCK;
+    int last = first + GENERATOR_VERTEX_BLOCK < job->numVertices ? first + GENERATOR_VERTEX_BLOCK : job->numVertices;
+
+    for (int v = first; v < last; v++) {
+        job->degree[v] = scanGeometricNeighbors(job, v, false);
+    }
+}
+
+static void fillGeometricRows(int block, int threadIndex, void* context) {
+    (void)threadIndex;
+    GeometricJob* job = (GeometricJob*)context;
+    int first = block * GENERATOR_VERTEX_BLOCK;
+    int last = first + GENERATOR_VERTEX_BLOCK < job->numVertices ? first + GENERATOR_VERTEX_BLOCK : job->numVertices;
+
+    for (int v = first; v < last; v++) {
+        scanGeometricNeighbors(job, v, true);
+    }
+}
+
+// Ordenar los puntos por celda (counting sort) y renumerar los vértices en
+// ese orden. Devuelve false si falta memoria.
+static bool sortPointsByCell(GeometricJob* job, double* rawX, double* rawY) {
+    int n = job->numVertices;
+    int numCells = job->cellsPerSide * job->cellsPerSide;
+    job->cellStart = (int*)calloc(numCells + 1, sizeof(int));
+    int* cursor = (int*)malloc(numCells * sizeof(int));
+    if (!job->cellStart || !cursor) {
+        free(cursor);
+        return false;
+    }
+
+    // degree guarda la celda de cada punto hasta que se cuenten los vecinos
+    int* cellOf = job->degree;
+    for (int i = 0; i < n; i++) {
+        cellOf[i] = cellCoordinate(job, rawY[i]) * job->cellsPerSide + cellCoordinate(job, rawX[i]);
+        job->cellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < numCells; c++) {
+        job->cellStart[c + 1] += job->cellStart[c];
+        cursor[c] = job->cellStart[c];
+    }
+
+    for (int i = 0; i < n; i++) {
+        int pos = cursor[cellOf[i]]++;
+        job->x[pos] = rawX[i];
+        job->y[pos] = rawY[i];
+    }
+
+    free(cursor);
+    return true;
+}
+
+GeometricGraph* generateGeometricGraph(int numVertices, double avgDegree, double centerLatitude,
+                                       double centerLongitude, double sideKm, uint64_t seed, int numThreads) {
+    if (numVertices < 1 || avgDegree <= 0 || sideKm <= 0) return NULL;
+    numThreads = resolveThreadCount(numThreads);
+
+    GeometricJob job;
+    memset(&job, 0, sizeof(job));
+    job.numVertices = numVertices;
+    job.seed = seed;
+
+    // Grado esperado = n * pi * r^2 en el cuadrado unitario (sin contar el borde)
+    job.radius = sqrt(avgDegree / (M_PI * numVertices));
+    job.metersPerUnit = sideKm * 1000.0;
+
+    // Celdas de lado >= radio: los vecinos de un punto están en las 3x3 de alrededor
+    int maxCells = (int)sqrt((double)numVertices) + 1;
+    job.cellsPerSide = job.radius >= 1.0 ? 1 : (int)(1.0 / job.radius);
+    if (job.cellsPerSide > maxCells) job.cellsPerSide = maxCells;
+    if (job.cellsPerSide < 1) job.cellsPerSide = 1;
+
+    double* rawX = (double*)malloc(numVertices * sizeof(double));
+    double* rawY = (double*)malloc(numVertices * sizeof(double));
+    job.x = (double*)malloc(numVertices * sizeof(double));
+    job.y = (double*)malloc(numVertices * sizeof(double));
+    job.degree = (int*)malloc(numVertices * sizeof(int));
+    GeometricGraph* geometric = (GeometricGraph*)calloc(1, sizeof(GeometricGraph));
+    bool ok = rawX && rawY && job.x && job.y && job.degree && geometric;
+
+    if (ok) {
+        // Los puntos se generan con la numeración original y después se
+        // renumeran por celda
+        double* finalX = job.x;
+        double* finalY = job.y;
+        job.x = rawX;
+        job.y = rawY;
+        parallelFor(numBlocks(numVertices, GENERATOR_VERTEX_BLOCK), numThreads, placeGeometricPoints, &job);
+        job.x = finalX;
+        job.y = finalY;
+        ok = sortPointsByCell(&job, rawX, rawY);
+    }
+    free(rawX);
+    free(rawY);
+
+    if (ok) {
+        parallelFor(numBlocks(numVertices, GENERATOR_VERTEX_BLOCK), numThreads, countGeometricRows, &job);
+
+        long long numArcs = 0;
+        for (int v = 0; v < numVertices; v++) {
+            numArcs += job.degree[v];
+        }
+        if (numArcs > INT_MAX) {
+            printf("❌ Error: %lld arcos exceden lo que admite CSRGraph\n", numArcs);
+            ok = false;
+        } else {
+            job.csr = createCSRGraph(numVertices, (int)numArcs, false);
+            ok = job.csr != NULL;
+        }
+    }
+
+    if (ok) {
+        for (int v = 0; v < numVertices; v++) {
+            job.csr->offsets[v + 1] = job.csr->offsets[v] + job.degree[v];
+        }
+        parallelFor(numBlocks(numVertices, GENERATOR_VERTEX_BLOCK), numThreads, fillGeometricRows, &job);
+
+        geometric->graph = job.csr;
+        geometric->latitudes = (double*)malloc(numVertices * sizeof(double));
+        geometric->longitudes = (double*)malloc(numVertices * sizeof(double));
+        ok = geometric->latitudes && geometric->longitudes;
+    }
+
+    if (ok) {
+        // Aproximación equirectangular alrededor del centro
+        double kmPerDegreeLongitude = KM_PER_DEGREE * cos(centerLatitude * M_PI / 180.0);
+        if (kmPerDegreeLongitude < 1e-9) kmPerDegreeLongitude = 1e-9;
+        for (int v = 0; v < numVertices; v++) {
+            geometric->latitudes[v] = centerLatitude + (job.y[v] - 0.5) * sideKm / KM_PER_DEGREE;
+            geometric->longitudes[v] = centerLongitude + (job.x[v] - 0.5) * sideKm / kmPerDegreeLongitude;
+        }
+    }
+
+    free(job.x);
+    free(job.y);
+    free(job.degree);
+    free(job.cellStart);
+
+    if (!ok) {
+        if (geometric && !geometric->graph) destroyCSRGraph(job.csr);
+        destroyGeometricGraph(geometric);
+        return NULL;
+    }
+    return geometric;
+}
+
+void destroyGeometricGraph(GeometricGraph* geometric) {
+    if (!geometric) return;
+    destroyCSRGraph(geometric->graph);
+    free(geometric->latitudes);
+    free(geometric->longitudes);
+    free(geometric);
+}
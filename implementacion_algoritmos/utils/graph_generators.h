@@ -0,0 +1,56 @@
+//
+// Created by administrador on 7/2/25.
+//
+
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../graph/csr_graph.h"
+
+#define GENERATOR_EDGE_BLOCK 65536     // Aristas por tarea de parallelFor
+#define GENERATOR_VERTEX_BLOCK 16384   // Vértices por tarea de parallelFor
+#define GENERATOR_BATCH 64             // Aristas generadas antes de tocar los contadores
+
+// Generadores sintéticos que escriben CSR directo, sin matriz V².
+// Cada arista o vértice sale de un hash de (seed, índice), no de rand(),
+// así que el grafo depende solo de la semilla: es el mismo con cualquier
+// cantidad de hilos y entre ejecuciones. Las filas quedan ordenadas por
+// (destino, peso). No se generan lazos; sí puede haber aristas repetidas
+// en R-MAT y Barabási-Albert, como en los modelos originales.
+
+// Grafo geométrico aleatorio con coordenadas para el GPS: puntos uniformes
+// en un cuadrado de sideKm km centrado en (centerLatitude, centerLongitude),
+// unidos si están a menos del radio que da avgDegree vecinos esperados.
+// Los vértices se numeran por celda espacial (vecinos con ids cercanos) y
+// el peso es la distancia en metros.
+typedef struct {
+    CSRGraph* graph;
+    double* latitudes;
+    double* longitudes;
+} GeometricGraph;
+
+// R-MAT / Kronecker: 2^scale vértices y edgeFactor * 2^scale aristas; cada
+// arista baja scale niveles eligiendo cuadrante con probabilidades a, b, c
+// y 1 - a - b - c (Graph500 usa 0.57, 0.19, 0.19)
+CSRGraph* generateRMATGraph(int scale, int edgeFactor, double a, double b, double c,
+                            int maxWeight, bool isDirected, uint64_t seed, int numThreads);
+
+GeometricGraph* generateGeometricGraph(int numVertices, double avgDegree, double centerLatitude,
+                                       double centerLongitude, double sideKm, uint64_t seed, int numThreads);
+void destroyGeometricGraph(GeometricGraph* geometric);
+
+// Red de calles en grilla rows x cols (vecinos arriba/abajo/izquierda/derecha)
+CSRGraph* generateGridNetwork(int rows, int cols, int maxWeight, uint64_t seed, int numThreads);
+
+// Barabási-Albert no dirigido: cada vértice nuevo se une a edgesPerVertex
+// vértices elegidos con probabilidad proporcional al grado. Se resuelve en
+// paralelo con el modelo de copia de Batagelj-Brandes: el destino de cada
+// arista copia un extremo de una arista anterior elegida por hash
+CSRGraph* generateBarabasiAlbertGraph(int numVertices, int edgesPerVertex, int maxWeight,
+                                      uint64_t seed, int numThreads);
+
+#endif //GRAPH_GENERATORS_H
@@ -0,0 +1,75 @@
+#include "parallel_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+typedef struct {
+    atomic_int nextTask;
+    int numTasks;
+    ParallelTask task;
+    void* context;
+} ParallelJob;
+
+typedef struct {
+    ParallelJob* job;
+    int threadIndex;
+} ParallelWorker;
+
+int resolveThreadCount(int requested) {
+    if (requested > 0) return requested;
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+
+static void* parallelWorkerMain(void* arg) {
+    ParallelWorker* worker = (ParallelWorker*)arg;
+    ParallelJob* job = worker->job;
+
+    int taskIndex;
+    while ((taskIndex = atomic_fetch_add(&job->nextTask, 1)) < job->numTasks) {
+        job->task(taskIndex, worker->threadIndex, job->context);
+    }
+    return NULL;
+}
+
+void parallelFor(int numTasks, int numThreads, ParallelTask task, void* context) {
+    if (numTasks <= 0 || !task) return;
+
+    numThreads = resolveThreadCount(numThreads);
+    if (numThreads > numTasks) numThreads = numTasks;
+
+    ParallelJob job;
+    atomic_init(&job.nextTask, 0);
+    job.numTasks = numTasks;
+    job.task = task;
+    job.context = context;
+
+    ParallelWorker* workers = (ParallelWorker*)malloc(numThreads * sizeof(ParallelWorker));
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+
+    // El hilo que llama trabaja como hilo 0
+    int started = 1;
+    for (int t = 1; t < numThreads; t++) {
+        workers[t].job = &job;
+        workers[t].threadIndex = t;
+        if (pthread_create(&threads[t], NULL, parallelWorkerMain, &workers[t]) != 0) {
+            // Si no se pudo crear el hilo, el resto de las tareas las toman los demás
+            break;
+        }
+        started++;
+    }
+
+    workers[0].job = &job;
+    workers[0].threadIndex = 0;
+    parallelWorkerMain(&workers[0]);
+
+    for (int t = 1; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    free(threads);
+    free(workers);
+}
@@ -0,0 +1,21 @@
+//
+// Created by administrador on 6/20/25.
+//
+
+#ifndef PARALLEL_UTILS_H
+#define PARALLEL_UTILS_H
+
+#include <stdbool.h>
+
+// Tarea de un parallelFor: taskIndex en [0, numTasks), threadIndex en
+// [0, numThreads) para indexar memoria de trabajo propia de cada hilo
+typedef void (*ParallelTask)(int taskIndex, int threadIndex, void* context);
+
+// Hilos a usar: requested si es > 0, si no los núcleos disponibles
+int resolveThreadCount(int requested);
+
+// Ejecutar task(0..numTasks-1) repartiendo las tareas dinámicamente entre
+// numThreads hilos. Con un solo hilo corre en el hilo que llama.
+void parallelFor(int numTasks, int numThreads, ParallelTask task, void* context);
+
+#endif //PARALLEL_UTILS_H
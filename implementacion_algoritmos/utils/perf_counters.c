@@ -0,0 +1,161 @@
+//
+// Created by administrador on 7/1/25.
+//
+
+#include "perf_counters.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+static const char* counterNames[PERF_NUM_COUNTERS] = {
+    "ciclos", "instrucciones", "cache-misses", "branch-misses"
+};
+
+const char* perfCounterName(PerfCounterKind kind) {
+    return (kind >= 0 && kind < PERF_NUM_COUNTERS) ? counterNames[kind] : "?";
+}
+
+#ifdef __linux__
+
+static const uint64_t counterConfigs[PERF_NUM_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+// Formato de read(): valor, tiempo habilitado y tiempo corriendo
+typedef struct {
+    uint64_t value;
+    uint64_t timeEnabled;
+    uint64_t timeRunning;
+} PerfReading;
+
+static int openCounter(uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 0;         // Siempre contando: las regiones se miden por diferencia
+    attr.inherit = 1;          // Contar también los hilos creados durante la medición
+    attr.exclude_kernel = 1;   // Permitido con perf_event_paranoid = 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Cada contador por separado (sin grupo): si uno no existe en esta CPU
+    // los demás siguen sirviendo
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+PerfCounters* createPerfCounters(void) {
+    PerfCounters* counters = (PerfCounters*)malloc(sizeof(PerfCounters));
+    if (!counters) return NULL;
+
+    memset(counters, 0, sizeof(PerfCounters));
+    int firstError = 0;
+    for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+        counters->fds[k] = openCounter(counterConfigs[k]);
+        if (counters->fds[k] >= 0) {
+            counters->numOpen++;
+        } else if (!firstError) {
+            firstError = errno;
+        }
+    }
+
+    if (counters->numOpen == 0) {
+        printf("⚠️  Contadores de hardware no disponibles (%s); solo se medirán tiempos\n",
+               strerror(firstError));
+    } else if (counters->numOpen < PERF_NUM_COUNTERS) {
+        printf("⚠️  Solo %d de %d contadores de hardware disponibles\n", counters->numOpen, PERF_NUM_COUNTERS);
+    }
+    return counters;
+}
+
+void destroyPerfCounters(PerfCounters* counters) {
+    if (!counters) return;
+    for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+        if (counters->fds[k] >= 0) close(counters->fds[k]);
+    }
+    free(counters);
+}
+
+static bool readCounter(int fd, PerfReading* reading) {
+    return fd >= 0 && read(fd, reading, sizeof(*reading)) == (ssize_t)sizeof(*reading);
+}
+
+void startPerfCounters(PerfCounters* counters) {
+    if (!counters) return;
+    for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+        PerfReading reading;
+        counters->startValid[k] = readCounter(counters->fds[k], &reading);
+        if (!counters->startValid[k]) continue;
+
+        counters->startValue[k] = reading.value;
+        counters->startEnabled[k] = reading.timeEnabled;
+        counters->startRunning[k] = reading.timeRunning;
+    }
+}
+
+PerfSample stopPerfCounters(PerfCounters* counters) {
+    PerfSample sample;
+    memset(&sample, 0, sizeof(sample));
+    if (!counters) return sample;
+
+    for (int k = 0; k < PERF_NUM_COUNTERS; k++) {
+        PerfReading reading;
+        if (!counters->startValid[k] || !readCounter(counters->fds[k], &reading)) continue;
+
+        // Valores y tiempos son totales desde que se abrió el contador
+        // (incluidos los hilos hijos ya terminados): usar solo la región
+        uint64_t value = reading.value - counters->startValue[k];
+        uint64_t enabled = reading.timeEnabled - counters->startEnabled[k];
+        uint64_t running = reading.timeRunning - counters->startRunning[k];
+        if (running == 0) continue;
+
+        // Si el kernel multiplexó los contadores, extrapolar al tiempo de la región
+        double scale = (double)enabled / running;
+        sample.values[k] = (uint64_t)(value * scale);
+        sample.valid[k] = true;
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters* createPerfCounters(void) {
+    PerfCounters* counters = (PerfCounters*)malloc(sizeof(PerfCounters));
+    if (!counters) return NULL;
+
+    memset(counters, 0, sizeof(PerfCounters));
+    for (int k = 0; k < PERF_NUM_COUNTERS; k++) counters->fds[k] = -1;
+    printf("⚠️  Contadores de hardware solo disponibles en Linux; solo se medirán tiempos\n");
+    return counters;
+}
+
+void destroyPerfCounters(PerfCounters* counters) {
+    free(counters);
+}
+
+void startPerfCounters(PerfCounters* counters) {
+    (void)counters;
+}
+
+PerfSample stopPerfCounters(PerfCounters* counters) {
+    (void)counters;
+    PerfSample sample;
+    memset(&sample, 0, sizeof(sample));
+    return sample;
+}
+
+#endif
+
+bool perfCountersAvailable(const PerfCounters* counters) {
+    return counters && counters->numOpen > 0;
+}
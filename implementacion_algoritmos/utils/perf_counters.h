@@ -0,0 +1,58 @@
+//
+// Created by administrador on 7/1/25.
+//
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Contadores de hardware de Linux (perf_event_open). Fuera de Linux, en
+// contenedores sin soporte o con perf_event_paranoid restrictivo el
+// conjunto queda sin contadores y las mediciones solo traen tiempos.
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_NUM_COUNTERS
+} PerfCounterKind;
+
+// Los contadores quedan habilitados desde que se abren y nunca se ponen
+// en cero: con inherit, el kernel suma lo de los hilos que terminaron en
+// un total aparte que PERF_EVENT_IOC_RESET no limpia. Cada región se mide
+// como diferencia entre la lectura de start y la de stop.
+typedef struct {
+    int fds[PERF_NUM_COUNTERS];    // -1 si ese contador no se pudo abrir
+    int numOpen;
+    uint64_t startValue[PERF_NUM_COUNTERS];
+    uint64_t startEnabled[PERF_NUM_COUNTERS];
+    uint64_t startRunning[PERF_NUM_COUNTERS];
+    bool startValid[PERF_NUM_COUNTERS];
+} PerfCounters;
+
+// Lectura de una región; valid[k] es false si el contador no está
+// disponible o no llegó a correr (multiplexado sin tiempo asignado)
+typedef struct {
+    uint64_t values[PERF_NUM_COUNTERS];
+    bool valid[PERF_NUM_COUNTERS];
+} PerfSample;
+
+// Abre los contadores para el hilo actual y los hilos que cree después
+// (así se cuentan también los trabajadores de parallelFor). Nunca devuelve
+// NULL por falta de soporte: en ese caso numOpen es 0
+PerfCounters* createPerfCounters(void);
+void destroyPerfCounters(PerfCounters* counters);
+bool perfCountersAvailable(const PerfCounters* counters);
+
+// Región medida: startPerfCounters guarda la lectura inicial y
+// stopPerfCounters devuelve la diferencia (escalando si hubo multiplexado)
+void startPerfCounters(PerfCounters* counters);
+PerfSample stopPerfCounters(PerfCounters* counters);
+
+const char* perfCounterName(PerfCounterKind kind);
+
+#endif //PERF_COUNTERS_H